@@ -10,6 +10,7 @@
 #include "Himii/Core/KeyCodes.h"
 #include "Himii/Core/MouseCodes.h"
 #include "Himii/Core/Timestep.h"
+#include "Himii/Core/Timer.h"
 
 #include "Himii/ImGui/ImGuiLayer.h"
 
@@ -34,6 +35,14 @@
 #include "Himii/Scene/Entity.h"
 #include "Himii/Scene/Scene.h"
 #include "Himii/Scene/SceneSerializer.h"
+#include "Himii/Scene/SceneBinarySerializer.h"
+#include "Himii/Scene/AsyncSceneLoader.h"
+#include "Himii/Scene/SceneAutosaver.h"
 #include "Himii/Scene/ScriptableEntity.h"
 
+// 资源包
+#include "Himii/Asset/AssetPack.h"
+#include "Himii/Asset/VirtualFileSystem.h"
+#include "Himii/Asset/AssetCooker.h"
+
 #include "Himii/Math/Math.h"
\ No newline at end of file
@@ -23,6 +23,12 @@ namespace Himii {
         virtual ~Asset() = default;
         virtual AssetType GetType() const = 0;
 
+        // 资源常驻内存的字节数（纹理按显存估算），用于 AssetManager 的预算统计
+        virtual uint64_t GetMemorySize() const
+        {
+            return 0;
+        }
+
         // 辅助转字符串，用于调试或序列化
         static std::string AssetTypeToString(AssetType type)
         {
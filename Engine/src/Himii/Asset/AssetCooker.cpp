@@ -0,0 +1,538 @@
+#include "Hepch.h"
+#include "Himii/Asset/AssetCooker.h"
+
+#include "Himii/Asset/AssetPack.h"
+#include "Himii/Asset/AssetSerializer.h"
+#include "Himii/Core/ThreadPool.h"
+#include "Himii/Core/Timer.h"
+#include "Himii/Renderer/CookedTexture.h"
+#include "Himii/Scene/SceneBinarySerializer.h"
+#include "Himii/Scene/SceneSerializer.h"
+#include "Himii/Utils/Hash.h"
+#include "Himii/Utils/MappedFile.h"
+
+#include "stb_image.h"
+#include <yaml-cpp/yaml.h>
+
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Himii
+{
+    namespace
+    {
+        // 烘焙格式或规则变化时提升，所有资源都会重新烘焙
+        constexpr uint32_t s_CookerVersion = 1;
+
+        struct CookDependency {
+            AssetHandle Handle = 0;
+            std::string Path; // Handle 不在注册表中时按路径（相对资产目录）查找
+        };
+
+        struct ManifestEntry {
+            uint64_t SourceHash = 0;
+            uint64_t SettingsHash = 0;
+            std::vector<CookDependency> Dependencies;
+        };
+
+        struct CookItem {
+            std::filesystem::path RelativePath;
+            std::string Key; // AssetPack::MakePathKey，大小写和分隔符不敏感
+            AssetType Type = AssetType::None;
+            uint64_t SourceHash = 0;
+            uint64_t SettingsHash = 0;
+            std::vector<CookDependency> Dependencies;
+            bool HashFailed = false;
+            bool Reachable = false;
+            AssetCookRecord Record;
+        };
+
+        uint64_t GetSettingsHash(AssetType type, const std::filesystem::path &relativePath,
+                                 const AssetCookSettings &settings)
+        {
+            uint64_t hash = Hash::FNV1a64(&s_CookerVersion, sizeof(s_CookerVersion));
+            hash = Hash::FNV1a64(&type, sizeof(type), hash);
+
+            bool flag = false;
+            if (type == AssetType::Texture2D)
+            {
+                flag = settings.GenerateMips;
+                hash = Hash::FNV1a64(&settings.Compression, sizeof(settings.Compression), hash);
+            }
+            else if (type == AssetType::Scene)
+                flag = settings.CookScenes;
+            else if (type == AssetType::SpriteAnimation)
+                flag = settings.CookAnimations;
+            hash = Hash::FNV1a64(&flag, sizeof(flag), hash);
+
+            // 扩展名变化（例如 .himii 改成 .hscn）也视为设置变化
+            return Hash::FNV1a64(relativePath.extension().generic_u8string(), hash);
+        }
+
+        bool HashFile(const std::filesystem::path &filepath, uint64_t &hash, uint64_t &size)
+        {
+            MappedFile file;
+            if (!file.Open(filepath))
+                return false;
+            size = file.GetSize();
+            hash = size > 0 ? Hash::FNV1a64(file.GetData(), file.GetSize()) : Hash::FNV1aOffsetBasis;
+            return true;
+        }
+
+        uint64_t GetFileSize(const std::filesystem::path &filepath)
+        {
+            std::error_code error;
+            uintmax_t size = std::filesystem::file_size(filepath, error);
+            return error ? 0 : (uint64_t)size;
+        }
+
+        bool CopySourceFile(const std::filesystem::path &source, const std::filesystem::path &destination)
+        {
+            std::error_code error;
+            std::filesystem::copy_file(source, destination, std::filesystem::copy_options::overwrite_existing, error);
+            return !error;
+        }
+
+        std::unordered_map<std::string, ManifestEntry> LoadManifest(const std::filesystem::path &filepath)
+        {
+            std::unordered_map<std::string, ManifestEntry> manifest;
+            std::error_code error;
+            if (!std::filesystem::exists(filepath, error))
+                return manifest;
+
+            YAML::Node data;
+            try
+            {
+                data = YAML::LoadFile(filepath.string());
+            }
+            catch (std::exception &e)
+            {
+                HIMII_CORE_WARNING("Ignoring corrupt cook manifest '{0}': {1}", filepath.string(), e.what());
+                return manifest;
+            }
+
+            if (!data["CookerVersion"] || data["CookerVersion"].as<uint32_t>() != s_CookerVersion)
+                return manifest;
+
+            for (auto node: data["Assets"])
+            {
+                ManifestEntry entry;
+                entry.SourceHash = node["SourceHash"].as<uint64_t>();
+                entry.SettingsHash = node["SettingsHash"].as<uint64_t>();
+                for (auto dependency: node["Dependencies"])
+                    entry.Dependencies.push_back(
+                            {dependency["Handle"].as<uint64_t>(), dependency["Path"].as<std::string>("")});
+                manifest[node["Path"].as<std::string>()] = std::move(entry);
+            }
+            return manifest;
+        }
+
+        void WriteManifest(const std::filesystem::path &filepath, const std::vector<CookItem> &items)
+        {
+            YAML::Emitter out;
+            out << YAML::BeginMap;
+            out << YAML::Key << "CookerVersion" << YAML::Value << s_CookerVersion;
+            out << YAML::Key << "Assets" << YAML::Value << YAML::BeginSeq;
+            for (const auto &item: items)
+            {
+                // 失败和被裁剪的资源不记录，下次构建重新处理
+                if (item.Record.Action == AssetCookAction::Failed || item.Record.Action == AssetCookAction::Stripped)
+                    continue;
+
+                out << YAML::BeginMap;
+                out << YAML::Key << "Path" << YAML::Value << item.Key;
+                out << YAML::Key << "SourceHash" << YAML::Value << item.SourceHash;
+                out << YAML::Key << "SettingsHash" << YAML::Value << item.SettingsHash;
+                if (!item.Dependencies.empty())
+                {
+                    out << YAML::Key << "Dependencies" << YAML::Value << YAML::BeginSeq;
+                    for (const auto &dependency: item.Dependencies)
+                    {
+                        out << YAML::Flow << YAML::BeginMap;
+                        out << YAML::Key << "Handle" << YAML::Value << (uint64_t)dependency.Handle;
+                        if (!dependency.Path.empty())
+                            out << YAML::Key << "Path" << YAML::Value << dependency.Path;
+                        out << YAML::EndMap;
+                    }
+                    out << YAML::EndSeq;
+                }
+                out << YAML::EndMap;
+            }
+            out << YAML::EndSeq;
+            out << YAML::EndMap;
+
+            std::ofstream fout(filepath);
+            fout << out.c_str();
+        }
+
+        void WriteReport(const std::filesystem::path &filepath, const AssetCookReport &report)
+        {
+            std::ofstream out(filepath);
+            out << "Path,Type,Action,Milliseconds,SourceBytes,CookedBytes\n";
+            for (const auto &record: report.Assets)
+            {
+                out << record.Path.generic_string() << ',' << Asset::AssetTypeToString(record.Type) << ','
+                    << AssetCooker::ActionToString(record.Action) << ',' << record.Milliseconds << ','
+                    << record.SourceBytes << ',' << record.CookedBytes << '\n';
+            }
+        }
+
+        bool CookScene(const std::filesystem::path &source, const std::filesystem::path &destination,
+                       const AssetCookSettings &settings, std::vector<CookDependency> &dependencies, bool &converted)
+        {
+            // 纹理只记录不加载，可以在工作线程解析；源文件已经是二进制场景时同样按文件头识别
+            Ref<Scene> scene = CreateRef<Scene>();
+            std::vector<PendingSpriteTexture> pendingTextures;
+            SceneSerializer serializer(scene);
+            serializer.SetDeferredTextureLoads(&pendingTextures);
+            if (!serializer.Deserialize(source.string()))
+                return false;
+
+            for (const auto &pending: pendingTextures)
+                dependencies.push_back({pending.Handle, pending.Path});
+            for (AssetHandle handle: scene->CollectAssetDependencies())
+                dependencies.push_back({handle, {}});
+
+            converted = settings.CookScenes;
+            if (!converted)
+                return CopySourceFile(source, destination);
+
+            SceneBinarySerializer binarySerializer(scene);
+            binarySerializer.SetDeferredTextureLoads(&pendingTextures);
+            return binarySerializer.Serialize(destination);
+        }
+
+        bool CookAnimation(const std::filesystem::path &source, const std::filesystem::path &destination,
+                           const AssetCookSettings &settings, std::vector<CookDependency> &dependencies,
+                           bool &converted)
+        {
+            Ref<SpriteAnimation> animation = SpriteAnimationSerializer::Deserialize(source);
+            if (!animation)
+                return false;
+
+            if (animation->IsSpriteSheet())
+                dependencies.push_back({animation->GetSpriteSheet(), {}});
+            for (AssetHandle frame: animation->GetFrames())
+                dependencies.push_back({frame, {}});
+
+            converted = settings.CookAnimations;
+            if (!converted)
+                return CopySourceFile(source, destination);
+            return SpriteAnimationSerializer::SerializeBinary(destination, animation);
+        }
+
+        bool CookTexture(const std::filesystem::path &source, const std::filesystem::path &destination,
+                         const AssetCookSettings &settings)
+        {
+            MappedFile file;
+            if (!file.Open(source) || file.GetSize() == 0)
+                return false;
+
+            // 与 TextureStreamer 的解码规则一致：RGB 保持 3 通道，其余扩展为 RGBA
+            int width = 0, height = 0, channels = 0;
+            if (!stbi_info_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels))
+                return false;
+            int desiredChannels = channels == 3 ? 3 : 4;
+
+            stbi_set_flip_vertically_on_load_thread(1);
+            stbi_uc *pixels =
+                    stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, desiredChannels);
+            if (!pixels)
+                return false;
+
+            CookedTextureWriteOptions writeOptions;
+            writeOptions.GenerateMips = settings.GenerateMips;
+            writeOptions.Compression = settings.Compression;
+            uint64_t written = CookedTexture::Write(destination, pixels, (uint32_t)width, (uint32_t)height,
+                                                    (uint32_t)desiredChannels, writeOptions);
+            stbi_image_free(pixels);
+            return written > 0;
+        }
+    } // namespace
+
+    const char *AssetCooker::ActionToString(AssetCookAction action)
+    {
+        switch (action)
+        {
+            case AssetCookAction::Cooked: return "Cooked";
+            case AssetCookAction::Copied: return "Copied";
+            case AssetCookAction::UpToDate: return "UpToDate";
+            case AssetCookAction::Stripped: return "Stripped";
+            case AssetCookAction::Failed: return "Failed";
+        }
+        return "Unknown";
+    }
+
+    AssetCookReport AssetCooker::Cook(const AssetCookOptions &options)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Timer totalTimer;
+        AssetCookReport report;
+        report.CookedDirectory = options.CacheDirectory / "Cooked";
+
+        std::error_code error;
+        if (!std::filesystem::is_directory(options.SourceDirectory, error))
+        {
+            HIMII_CORE_ERROR("Asset cook source '{0}' is not a directory", options.SourceDirectory.string());
+            return report;
+        }
+        std::filesystem::create_directories(report.CookedDirectory, error);
+        if (error)
+        {
+            HIMII_CORE_ERROR("Failed to create cook directory '{0}'", report.CookedDirectory.string());
+            return report;
+        }
+
+        // 1. 枚举源文件，按路径排序保证输出稳定
+        std::vector<CookItem> items;
+        for (auto it = std::filesystem::recursive_directory_iterator(options.SourceDirectory, error);
+             !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+        {
+            if (!it->is_regular_file(error))
+                continue;
+
+            CookItem item;
+            item.RelativePath = it->path().lexically_relative(options.SourceDirectory);
+            item.Key = AssetPack::MakePathKey(item.RelativePath);
+            item.Type = AssetManager::GetAssetTypeFromExtension(item.RelativePath.extension().string());
+            item.SettingsHash = GetSettingsHash(item.Type, item.RelativePath, options.Settings);
+            item.Record.Path = item.RelativePath;
+            item.Record.Type = item.Type;
+            items.push_back(std::move(item));
+        }
+        std::sort(items.begin(), items.end(),
+                  [](const CookItem &a, const CookItem &b) { return a.RelativePath < b.RelativePath; });
+
+        std::unordered_map<std::string, size_t> itemLookup;
+        for (size_t i = 0; i < items.size(); ++i)
+            itemLookup[items[i].Key] = i;
+
+        ThreadPool pool(options.WorkerCount);
+
+        // 2. 并行计算内容哈希
+        for (auto &item: items)
+        {
+            pool.Submit(
+                    [&item, &options]()
+                    {
+                        item.HashFailed = !HashFile(options.SourceDirectory / item.RelativePath, item.SourceHash,
+                                                    item.Record.SourceBytes);
+                    });
+        }
+        pool.Wait();
+
+        std::filesystem::path manifestPath = options.CacheDirectory / "CookManifest.yaml";
+        std::unordered_map<std::string, ManifestEntry> manifest = LoadManifest(manifestPath);
+
+        // 哈希和设置都没变、输出还在时沿用上次的结果（包括依赖列表）
+        auto tryReuse = [&](CookItem &item)
+        {
+            auto it = manifest.find(item.Key);
+            if (item.HashFailed || it == manifest.end() || it->second.SourceHash != item.SourceHash ||
+                it->second.SettingsHash != item.SettingsHash)
+                return false;
+
+            std::filesystem::path destination = report.CookedDirectory / item.RelativePath;
+            std::error_code existsError;
+            if (!std::filesystem::exists(destination, existsError))
+                return false;
+
+            item.Dependencies = it->second.Dependencies;
+            item.Record.Action = AssetCookAction::UpToDate;
+            item.Record.CookedBytes = GetFileSize(destination);
+            return true;
+        };
+
+        auto cookItem = [&](CookItem &item)
+        {
+            std::filesystem::path source = options.SourceDirectory / item.RelativePath;
+            std::filesystem::path destination = report.CookedDirectory / item.RelativePath;
+
+            Timer timer;
+            std::error_code directoryError;
+            std::filesystem::create_directories(destination.parent_path(), directoryError);
+
+            bool succeeded = false;
+            bool converted = false;
+            if (item.HashFailed)
+                succeeded = false;
+            else if (item.Type == AssetType::Scene)
+                succeeded = CookScene(source, destination, options.Settings, item.Dependencies, converted);
+            else if (item.Type == AssetType::SpriteAnimation)
+                succeeded = CookAnimation(source, destination, options.Settings, item.Dependencies, converted);
+            else if (item.Type == AssetType::Texture2D)
+                succeeded = converted = CookTexture(source, destination, options.Settings);
+            else
+                succeeded = CopySourceFile(source, destination);
+
+            item.Record.Milliseconds = timer.ElapsedMillis();
+            if (!succeeded)
+            {
+                item.Record.Action = AssetCookAction::Failed;
+                return;
+            }
+            item.Record.Action = converted ? AssetCookAction::Cooked : AssetCookAction::Copied;
+            item.Record.CookedBytes = GetFileSize(destination);
+        };
+
+        auto submitCook = [&](CookItem &item)
+        {
+            if (tryReuse(item))
+                return;
+            pool.Submit([&item, &cookItem]() { cookItem(item); });
+        };
+
+        // 3. 场景决定哪些资源被引用，先全部处理
+        for (auto &item: items)
+        {
+            if (item.Type == AssetType::Scene)
+            {
+                item.Reachable = true;
+                submitCook(item);
+            }
+        }
+        pool.Wait();
+
+        // Handle 优先按注册表解析，失效时退回到场景里记录的路径
+        auto resolveDependency = [&](const CookDependency &dependency) -> CookItem *
+        {
+            std::filesystem::path path;
+            if (options.Registry)
+            {
+                auto it = options.Registry->find(dependency.Handle);
+                if (it != options.Registry->end())
+                    path = it->second.FilePath;
+            }
+            if (path.empty())
+                path = dependency.Path;
+            if (path.empty())
+                return nullptr;
+
+            if (path.is_absolute())
+                path = path.lexically_normal().lexically_relative(options.SourceDirectory.lexically_normal());
+            auto it = itemLookup.find(AssetPack::MakePathKey(path.lexically_normal()));
+            return it != itemLookup.end() ? &items[it->second] : nullptr;
+        };
+
+        auto markDependencies = [&](const CookItem &item)
+        {
+            for (const auto &dependency: item.Dependencies)
+            {
+                if (CookItem *target = resolveDependency(dependency))
+                    target->Reachable = true;
+            }
+        };
+
+        bool strip = options.Settings.StripUnreferenced;
+        auto isStrippable = [&](const CookItem &item)
+        {
+            // 脚本已编译进 GameAssembly，源码不需要随包发布
+            if (item.RelativePath.extension() == ".cs")
+                return true;
+            return item.Type == AssetType::Texture2D || item.Type == AssetType::SpriteAnimation;
+        };
+
+        // 4. 场景引用到的动画（不裁剪时全部动画）
+        for (const auto &item: items)
+        {
+            if (item.Type == AssetType::Scene)
+                markDependencies(item);
+        }
+        for (auto &item: items)
+        {
+            if (item.Type == AssetType::SpriteAnimation && (item.Reachable || !strip))
+            {
+                item.Reachable = true;
+                submitCook(item);
+            }
+        }
+        pool.Wait();
+
+        // 5. 动画引用的纹理，然后并行处理剩余的纹理和其他文件
+        for (const auto &item: items)
+        {
+            if (item.Type == AssetType::SpriteAnimation && item.Reachable)
+                markDependencies(item);
+        }
+        for (auto &item: items)
+        {
+            if (item.Type == AssetType::Scene || item.Type == AssetType::SpriteAnimation)
+            {
+                if (!item.Reachable)
+                    item.Record.Action = AssetCookAction::Stripped;
+                continue;
+            }
+
+            if (strip && !item.Reachable && isStrippable(item))
+            {
+                item.Record.Action = AssetCookAction::Stripped;
+                continue;
+            }
+            submitCook(item);
+        }
+        pool.Wait();
+
+        // 6. 删除输出目录中已经不对应任何源文件（或被裁剪）的旧文件
+        std::unordered_set<std::string> outputs;
+        for (const auto &item: items)
+        {
+            if (item.Record.Action != AssetCookAction::Stripped && item.Record.Action != AssetCookAction::Failed)
+                outputs.insert(item.Key);
+        }
+        std::vector<std::filesystem::path> staleFiles;
+        for (auto it = std::filesystem::recursive_directory_iterator(report.CookedDirectory, error);
+             !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+        {
+            if (it->is_regular_file(error) &&
+                !outputs.count(AssetPack::MakePathKey(it->path().lexically_relative(report.CookedDirectory))))
+                staleFiles.push_back(it->path());
+        }
+        for (const auto &path: staleFiles)
+            std::filesystem::remove(path, error);
+
+        // 7. 清单、报告和裁剪后的注册表
+        for (auto &item: items)
+        {
+            switch (item.Record.Action)
+            {
+                case AssetCookAction::Cooked: ++report.CookedCount; break;
+                case AssetCookAction::Copied: ++report.CopiedCount; break;
+                case AssetCookAction::UpToDate: ++report.UpToDateCount; break;
+                case AssetCookAction::Stripped: ++report.StrippedCount; break;
+                case AssetCookAction::Failed:
+                    ++report.FailedCount;
+                    HIMII_CORE_ERROR("Failed to cook asset '{0}'", item.RelativePath.generic_string());
+                    break;
+            }
+            report.Assets.push_back(item.Record);
+        }
+
+        WriteManifest(manifestPath, items);
+
+        if (options.Registry && !options.RegistryOutputPath.empty())
+        {
+            AssetRegistry strippedRegistry;
+            for (const auto &[handle, metadata]: *options.Registry)
+            {
+                auto it = itemLookup.find(AssetPack::MakePathKey(metadata.FilePath.lexically_normal()));
+                if (it != itemLookup.end() && items[it->second].Record.Action == AssetCookAction::Stripped)
+                    continue;
+                strippedRegistry[handle] = metadata;
+            }
+            if (!AssetManager::WriteAssetRegistry(options.RegistryOutputPath, strippedRegistry))
+                HIMII_CORE_ERROR("Failed to write cooked asset registry: {0}", options.RegistryOutputPath.string());
+        }
+
+        report.TotalMilliseconds = totalTimer.ElapsedMillis();
+        report.Succeeded = report.FailedCount == 0;
+        WriteReport(options.CacheDirectory / "CookReport.csv", report);
+
+        HIMII_CORE_INFO("Cooked assets in {0:.2f} ms: {1} cooked, {2} copied, {3} up to date, {4} stripped, {5} failed",
+                        report.TotalMilliseconds, report.CookedCount, report.CopiedCount, report.UpToDateCount,
+                        report.StrippedCount, report.FailedCount);
+        return report;
+    }
+} // namespace Himii
@@ -0,0 +1,71 @@
+#pragma once
+#include "Himii/Asset/AssetManager.h"
+#include "Himii/Core/Core.h"
+#include "Himii/Renderer/CookedTexture.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Himii
+{
+    // 影响烘焙输出的设置，参与每个资源的设置哈希，修改后相关资源会重新烘焙
+    struct AssetCookSettings {
+        bool GenerateMips = true;      // 纹理烘焙为带 mip 链的 .htex 内容
+        TextureCompression Compression = TextureCompression::Auto;
+        bool CookScenes = true;        // 场景转为二进制（.hscn 内容）
+        bool CookAnimations = true;    // 动画转为二进制
+        bool StripUnreferenced = true; // 去掉任何场景都没有引用的纹理、动画以及 C# 源码
+    };
+
+    struct AssetCookOptions {
+        std::filesystem::path SourceDirectory;
+        // 输出写到 CacheDirectory/Cooked，清单和报告也放在这里，跨构建保留以便增量烘焙
+        std::filesystem::path CacheDirectory;
+        // 非空时写出去掉被裁剪资源后的注册表
+        std::filesystem::path RegistryOutputPath;
+        const AssetRegistry *Registry = nullptr;
+        AssetCookSettings Settings;
+        uint32_t WorkerCount = 0; // 0 表示按硬件线程数
+    };
+
+    enum class AssetCookAction {
+        Cooked = 0,
+        Copied,   // 不需要转换，原样复制
+        UpToDate, // 内容哈希和设置都没变，沿用上次的输出
+        Stripped,
+        Failed
+    };
+
+    struct AssetCookRecord {
+        std::filesystem::path Path; // 相对资产目录
+        AssetType Type = AssetType::None;
+        AssetCookAction Action = AssetCookAction::Failed;
+        float Milliseconds = 0.0f;
+        uint64_t SourceBytes = 0;
+        uint64_t CookedBytes = 0;
+    };
+
+    struct AssetCookReport {
+        std::vector<AssetCookRecord> Assets; // 按路径排序
+        uint32_t CookedCount = 0;
+        uint32_t CopiedCount = 0;
+        uint32_t UpToDateCount = 0;
+        uint32_t StrippedCount = 0;
+        uint32_t FailedCount = 0;
+        float TotalMilliseconds = 0.0f;
+        std::filesystem::path CookedDirectory;
+        bool Succeeded = false;
+    };
+
+    // 构建用的资源烘焙：纹理预先解码并生成 mip，场景和动画转为二进制，按场景引用裁剪资源。
+    // 以源文件内容哈希 + 烘焙设置判断是否需要重新处理，各资源在线程池上并行烘焙，
+    // 每个资源的耗时写入 CacheDirectory/CookReport.csv。输出保持源文件的相对路径和扩展名，
+    // 运行时按文件头识别烘焙格式，注册表和场景中的路径无需改动
+    class AssetCooker {
+    public:
+        static AssetCookReport Cook(const AssetCookOptions &options);
+
+        static const char *ActionToString(AssetCookAction action);
+    };
+} // namespace Himii
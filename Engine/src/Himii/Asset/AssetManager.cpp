@@ -3,8 +3,14 @@
 #include "Himii/Project/Project.h"
 #include "Himii/Renderer/Texture.h"
 #include "Himii/Asset/AssetSerializer.h"
+#include "Himii/Core/Timer.h"
+#include "Himii/Utils/Hash.h"
+#include "Himii/Utils/MappedFile.h"
 #include "yaml-cpp/yaml.h"
+#include <algorithm>
 #include <fstream>
+#include <thread>
+#include <unordered_set>
 
 namespace Himii
 {
@@ -13,14 +19,163 @@ namespace Himii
     {
     }
 
+    AssetManager::~AssetManager()
+    {
+        // 先停掉工作线程，再释放已加载的资源
+        m_TextureStreamer.reset();
+    }
+
+    // 引用计数的变化无法被通知到，超出预算时隔一段时间再检查能否卸载
+    static constexpr uint64_t s_EvictionCheckInterval = 30;
+    static constexpr size_t s_MaxEvictionLogSize = 128;
+
+    void AssetManager::Update()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        ++m_FrameIndex;
+
+        if (m_TextureStreamer)
+        {
+            m_TextureStreamer->Update();
+
+            // 占位纹理切换为真实纹理后尺寸变化
+            uint32_t streamedCount = m_TextureStreamer->GetStats().Completed;
+            if (streamedCount != m_LastStreamedCount)
+            {
+                m_LastStreamedCount = streamedCount;
+                m_MemoryStatsDirty = true;
+            }
+        }
+
+        if (m_MemoryStatsDirty)
+            RecalculateMemoryStats();
+
+        if (m_MemoryBudget > 0 && m_MemoryStats.TotalBytes > m_MemoryBudget &&
+            m_FrameIndex % s_EvictionCheckInterval == 0)
+            EvictUnusedAssets(m_MemoryBudget);
+    }
+
+    void AssetManager::RecalculateMemoryStats()
+    {
+        m_MemoryStats.TotalBytes = 0;
+        m_MemoryStats.BytesByType.clear();
+        for (const auto &[handle, entry]: m_LoadedAssets)
+        {
+            uint64_t size = entry.Instance->GetMemorySize();
+            m_MemoryStats.TotalBytes += size;
+            m_MemoryStats.BytesByType[entry.Instance->GetType()] += size;
+        }
+        m_MemoryStats.LoadedCount = (uint32_t)m_LoadedAssets.size();
+        m_MemoryStatsDirty = false;
+    }
+
+    uint32_t AssetManager::EvictUnusedAssets(uint64_t targetBytes)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (m_MemoryStatsDirty)
+            RecalculateMemoryStats();
+
+        // 只有 AssetManager 自己持有引用的资源才能卸载（流式加载中的纹理被 TextureStreamer 持有）
+        std::vector<std::pair<uint64_t, AssetHandle>> candidates;
+        for (const auto &[handle, entry]: m_LoadedAssets)
+        {
+            if (entry.Instance.use_count() == 1)
+                candidates.emplace_back(entry.LastUsedFrame, handle);
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        uint32_t evicted = 0;
+        for (const auto &[lastUsedFrame, handle]: candidates)
+        {
+            if (m_MemoryStats.TotalBytes <= targetBytes)
+                break;
+
+            auto it = m_LoadedAssets.find(handle);
+            const Ref<Asset> &asset = it->second.Instance;
+
+            AssetEvictionEvent event;
+            event.Handle = handle;
+            event.Type = asset->GetType();
+            event.Size = asset->GetMemorySize();
+            event.Frame = m_FrameIndex;
+
+            HIMII_CORE_INFO("Evicting {0} asset {1} ({2} KB, unused for {3} frames)",
+                            Asset::AssetTypeToString(event.Type), (uint64_t)handle, event.Size / 1024,
+                            m_FrameIndex - lastUsedFrame);
+
+            m_MemoryStats.TotalBytes -= event.Size;
+            m_MemoryStats.BytesByType[event.Type] -= event.Size;
+            m_MemoryStats.EvictedBytes += event.Size;
+            ++m_MemoryStats.EvictionCount;
+
+            m_LoadedAssets.erase(it);
+            auto registryIt = m_AssetRegistry.find(handle);
+            if (registryIt != m_AssetRegistry.end())
+                registryIt->second.IsLoaded = false;
+
+            m_EvictionLog.push_back(event);
+            if (m_EvictionLog.size() > s_MaxEvictionLogSize)
+                m_EvictionLog.pop_front();
+
+            ++evicted;
+        }
+
+        m_MemoryStats.LoadedCount = (uint32_t)m_LoadedAssets.size();
+        if (evicted > 0 && m_MemoryStats.TotalBytes > targetBytes)
+            HIMII_CORE_WARNING("Asset memory still over budget after eviction: {0} MB in use",
+                               m_MemoryStats.TotalBytes / (1024 * 1024));
+        return evicted;
+    }
+
+    uint32_t AssetManager::UnloadUnusedAssets()
+    {
+        return EvictUnusedAssets(0);
+    }
+
+    std::vector<AssetResidency> AssetManager::GetResidency() const
+    {
+        std::vector<AssetResidency> residency;
+        residency.reserve(m_LoadedAssets.size());
+        for (const auto &[handle, entry]: m_LoadedAssets)
+        {
+            AssetResidency info;
+            info.Handle = handle;
+            info.Type = entry.Instance->GetType();
+            info.Size = entry.Instance->GetMemorySize();
+            info.LastUsedFrame = entry.LastUsedFrame;
+            info.RefCount = entry.Instance.use_count() - 1;
+            residency.push_back(info);
+        }
+        std::sort(residency.begin(), residency.end(),
+                  [](const AssetResidency &a, const AssetResidency &b) { return a.Size > b.Size; });
+        return residency;
+    }
+
+    TextureLoadState AssetManager::GetTextureLoadState(AssetHandle handle) const
+    {
+        auto it = m_LoadedAssets.find(handle);
+        if (it == m_LoadedAssets.end() || it->second.Instance->GetType() != AssetType::Texture2D)
+            return TextureLoadState::None;
+
+        const Texture2D *texture = static_cast<const Texture2D *>(it->second.Instance.get());
+        if (m_TextureStreamer)
+            return m_TextureStreamer->GetLoadState(texture);
+        return texture->IsLoaded() ? TextureLoadState::Ready : TextureLoadState::None;
+    }
+
     Ref<Asset> AssetManager::GetAsset(AssetHandle handle)
     {
-        // 1. 检查是否已经加载
-        if (IsAssetLoaded(handle))
-            return m_LoadedAssets.at(handle);
+        // 1. 检查是否已经加载，记录最近使用的帧供 LRU 卸载
+        if (auto it = m_LoadedAssets.find(handle); it != m_LoadedAssets.end())
+        {
+            it->second.LastUsedFrame = m_FrameIndex;
+            return it->second.Instance;
+        }
 
-        // 2. 检查是否在注册表中
-        const auto &metadata = m_AssetRegistry[handle];
+        // 2. 检查是否在注册表中（用 find，未知的 Handle 不能插入空条目）
+        const auto &metadata = GetMetadata(handle);
         if (!metadata) // 无效的 Metadata
             return nullptr;
 
@@ -36,7 +191,16 @@ namespace Himii
             case AssetType::Texture2D:
             {
                 // 加载 Texture2D，Texture2D::Create 应该返回 Ref<Texture2D>
-                asset = Texture2D::Create(pathString);
+                if (m_AsyncTextureLoading)
+                {
+                    if (!m_TextureStreamer)
+                        m_TextureStreamer = CreateScope<TextureStreamer>();
+                    asset = m_TextureStreamer->Load(pathString);
+                }
+                else
+                {
+                    asset = Texture2D::Create(pathString);
+                }
                 break;
             }
             case AssetType::SpriteAnimation:
@@ -51,28 +215,207 @@ namespace Himii
 
         // 4. 如果加载成功，存入缓存并返回
         if (asset)
+            AddLoadedAsset(handle, asset);
+
+        return asset;
+    }
+
+    void AssetManager::AddLoadedAsset(AssetHandle handle, const Ref<Asset> &asset)
+    {
+        asset->Handle = handle; // 确保内存中的 Asset 知道它自己的 Handle
+        m_LoadedAssets[handle] = {asset, m_FrameIndex};
+        m_AssetRegistry.find(handle)->second.IsLoaded = true; // 标记元数据（此时一定在注册表中）
+        m_MemoryStatsDirty = true;
+    }
+
+    AssetPreloadReport AssetManager::PreloadAssets(const std::vector<AssetHandle> &handles,
+                                                   const AssetPreloadProgressFn &onProgress)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Timer totalTimer;
+        AssetPreloadReport report;
+
+        std::unordered_set<AssetHandle> visited;
+        std::vector<AssetHandle> animations;
+        std::vector<AssetHandle> textures;
+        std::vector<Ref<SpriteAnimation>> loadedAnimations;
+        auto enqueue = [&](AssetHandle handle)
+        {
+            if (handle == 0 || !visited.insert(handle).second)
+                return;
+            const auto &metadata = GetMetadata(handle);
+            if (!metadata)
+                return;
+
+            if (auto it = m_LoadedAssets.find(handle); it != m_LoadedAssets.end())
+            {
+                it->second.LastUsedFrame = m_FrameIndex;
+                ++report.AlreadyLoaded;
+                if (metadata.Type == AssetType::SpriteAnimation)
+                    loadedAnimations.push_back(std::static_pointer_cast<SpriteAnimation>(it->second.Instance));
+                return;
+            }
+
+            if (metadata.Type == AssetType::SpriteAnimation)
+                animations.push_back(handle);
+            else if (metadata.Type == AssetType::Texture2D)
+                textures.push_back(handle);
+        };
+        for (AssetHandle handle: handles)
+            enqueue(handle);
+
+        uint32_t completed = 0;
+        // 动画引用的纹理入队后总数才确定，在此之前完成的动画不单独上报，避免进度倒退
+        uint32_t total = 0;
+        auto finish = [&](AssetHandle handle, AssetType type, float milliseconds, bool succeeded)
+        {
+            report.Assets.push_back({handle, type, milliseconds, succeeded});
+            ++completed;
+            if (onProgress && total > 0)
+                onProgress(completed, total);
+        };
+
+        // 1. 动画：YAML 解析不涉及 GL，直接在工作线程并行
+        if (!animations.empty())
         {
-            asset->Handle = handle; // 确保内存中的 Asset 知道它自己的 Handle
-            m_LoadedAssets[handle] = asset;
-            m_AssetRegistry[handle].IsLoaded = true; // 标记元数据
+            struct ParsedAnimation {
+                Ref<SpriteAnimation> Animation;
+                float Milliseconds = 0.0f;
+            };
+            std::vector<ParsedAnimation> parsed(animations.size());
+            {
+                ThreadPool workers;
+                for (size_t i = 0; i < animations.size(); ++i)
+                {
+                    std::filesystem::path path = Project::GetAssetFileSystemPath(GetMetadata(animations[i]).FilePath);
+                    workers.Submit(
+                            [&parsed, i, path]()
+                            {
+                                Timer timer;
+                                parsed[i].Animation = SpriteAnimationSerializer::Deserialize(path);
+                                parsed[i].Milliseconds = timer.ElapsedMillis();
+                            });
+                }
+                workers.Wait();
+            }
+
+            for (size_t i = 0; i < animations.size(); ++i)
+            {
+                if (parsed[i].Animation)
+                {
+                    AddLoadedAsset(animations[i], parsed[i].Animation);
+                    loadedAnimations.push_back(parsed[i].Animation);
+                }
+                finish(animations[i], AssetType::SpriteAnimation, parsed[i].Milliseconds, parsed[i].Animation != nullptr);
+            }
         }
 
-        return asset;
+        // 动画引用的纹理：逐帧纹理和精灵表
+        for (const auto &animation: loadedAnimations)
+        {
+            enqueue(animation->GetSpriteSheet());
+            for (AssetHandle frame: animation->GetFrames())
+                enqueue(frame);
+        }
+        total = (uint32_t)(animations.size() + textures.size());
+        if (onProgress && completed > 0)
+            onProgress(completed, total);
+
+        // 2. 纹理：无论是否开启异步加载都交给 TextureStreamer 并行解码，这里等待全部完成，上传不受每帧预算限制
+        if (!textures.empty())
+        {
+            if (!m_TextureStreamer)
+                m_TextureStreamer = CreateScope<TextureStreamer>();
+
+            struct PendingTexture {
+                AssetHandle Handle = 0;
+                Ref<Texture2D> Texture;
+                Timer RequestTimer;
+            };
+            std::vector<PendingTexture> pending;
+            pending.reserve(textures.size());
+            for (AssetHandle handle: textures)
+            {
+                std::filesystem::path path = Project::GetAssetFileSystemPath(GetMetadata(handle).FilePath);
+                Ref<Texture2D> texture = m_TextureStreamer->Load(path.string());
+                AddLoadedAsset(handle, texture);
+                pending.push_back({handle, texture, Timer()});
+            }
+
+            uint64_t uploadBudget = m_TextureStreamer->GetUploadBudget();
+            m_TextureStreamer->SetUploadBudget(UINT64_MAX);
+            while (!pending.empty())
+            {
+                m_TextureStreamer->Update();
+
+                size_t before = pending.size();
+                for (size_t i = 0; i < pending.size();)
+                {
+                    TextureLoadState state = m_TextureStreamer->GetLoadState(pending[i].Texture.get());
+                    if (state == TextureLoadState::Queued || state == TextureLoadState::Decoding ||
+                        state == TextureLoadState::Uploading)
+                    {
+                        ++i;
+                        continue;
+                    }
+                    finish(pending[i].Handle, AssetType::Texture2D, pending[i].RequestTimer.ElapsedMillis(),
+                           state != TextureLoadState::Failed);
+                    pending[i] = std::move(pending.back());
+                    pending.pop_back();
+                }
+
+                // 没有进展说明都在解码，让出时间片给工作线程
+                if (pending.size() == before)
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            m_TextureStreamer->SetUploadBudget(uploadBudget);
+            m_LastStreamedCount = m_TextureStreamer->GetStats().Completed;
+        }
+
+        if (m_MemoryStatsDirty)
+            RecalculateMemoryStats();
+
+        report.TotalMilliseconds = totalTimer.ElapsedMillis();
+        return report;
     }
 
-    AssetHandle AssetManager::ImportAsset(const std::filesystem::path &filepath)
+    // 查找表的键：规范化后的正斜杠路径；Windows 文件系统不区分大小写，键统一转小写
+    static std::string MakePathKey(const std::filesystem::path &normalizedPath)
     {
-        // 计算相对路径
-        std::filesystem::path relativePath = filepath;
+        std::string key = normalizedPath.generic_string();
+#ifdef HIMII_PLATFORM_WINDOWS
+        std::transform(key.begin(), key.end(), key.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+#endif
+        return key;
+    }
 
-        // 检查该路径是否已经存在于 Registry 中 (防止重复导入)
-        for (auto &[handle, metadata]: m_AssetRegistry)
+    std::filesystem::path AssetManager::NormalizeAssetPath(const std::filesystem::path &filepath)
+    {
+        std::filesystem::path path = filepath.lexically_normal();
+
+        // 资产目录内的绝对路径转为相对路径，目录外的保持绝对路径
+        if (path.is_absolute() && Project::GetActive())
         {
-            if (metadata.FilePath.generic_string() == filepath.generic_string())
-                return handle;
+            std::filesystem::path relativePath =
+                    path.lexically_relative(Project::GetAssetDirectory().lexically_normal());
+            if (!relativePath.empty() && *relativePath.begin() != "..")
+                path = relativePath;
         }
+        return path;
+    }
+
+    AssetHandle AssetManager::ImportAssetInternal(const std::filesystem::path &filepath, bool &imported)
+    {
+        imported = false;
+
+        // 计算相对路径
+        std::filesystem::path relativePath = NormalizeAssetPath(filepath);
+        std::string key = MakePathKey(relativePath);
 
-        HIMII_CORE_INFO("Importing NEW Asset: {0}", filepath.generic_string());
+        // 检查该路径是否已经存在于 Registry 中 (防止重复导入)
+        if (auto it = m_AssetPathLookup.find(key); it != m_AssetPathLookup.end())
+            return it->second;
 
         AssetMetadata metadata;
         metadata.Handle = AssetHandle();
@@ -82,12 +425,72 @@ namespace Himii
         if (metadata.Type != AssetType::None)
         {
             m_AssetRegistry[metadata.Handle] = metadata;
+            m_AssetPathLookup.emplace(std::move(key), metadata.Handle);
+            imported = true;
             return metadata.Handle;
         }
 
         return 0; // Import Failed
     }
 
+    AssetHandle AssetManager::ImportAsset(const std::filesystem::path &filepath)
+    {
+        bool imported = false;
+        AssetHandle handle = ImportAssetInternal(filepath, imported);
+        if (imported)
+            HIMII_CORE_INFO("Importing NEW Asset: {0}", filepath.generic_string());
+        return handle;
+    }
+
+    std::vector<AssetHandle> AssetManager::ImportAssets(const std::vector<std::filesystem::path> &filepaths)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Timer timer;
+        m_AssetPathLookup.reserve(m_AssetPathLookup.size() + filepaths.size());
+
+        std::vector<AssetHandle> handles;
+        handles.reserve(filepaths.size());
+
+        uint32_t importedCount = 0, unsupportedCount = 0;
+        for (const auto &filepath: filepaths)
+        {
+            bool imported = false;
+            AssetHandle handle = ImportAssetInternal(filepath, imported);
+            if (imported)
+                ++importedCount;
+            else if (handle == 0)
+                ++unsupportedCount;
+            handles.push_back(handle);
+        }
+
+        // 批量导入只汇总输出一次，逐个文件打日志本身就很慢
+        HIMII_CORE_INFO("Imported {0} new assets ({1} already registered, {2} unsupported) in {3} ms", importedCount,
+                        filepaths.size() - importedCount - unsupportedCount, unsupportedCount, timer.ElapsedMillis());
+        return handles;
+    }
+
+    uint32_t AssetManager::ImportDirectory(const std::filesystem::path &directory)
+    {
+        std::filesystem::path root = Project::GetAssetFileSystemPath(directory);
+        if (!std::filesystem::is_directory(root))
+        {
+            HIMII_CORE_WARNING("Asset directory does not exist: {0}", root.string());
+            return 0;
+        }
+
+        std::vector<std::filesystem::path> filepaths;
+        size_t registeredBefore = m_AssetRegistry.size();
+        for (const auto &entry: std::filesystem::recursive_directory_iterator(root))
+        {
+            if (entry.is_regular_file() && GetAssetTypeFromExtension(entry.path().extension().string()) != AssetType::None)
+                filepaths.push_back(entry.path());
+        }
+
+        ImportAssets(filepaths);
+        return (uint32_t)(m_AssetRegistry.size() - registeredBefore);
+    }
+
     // ... (keep invalid check methods same, or just replace whole block) ...
     // Skipping IsAssetHandleValid/IsAssetLoaded/GetAssetTypeFromExtension/SerializeAssetRegistry changes for brevity unless wanted.
     // I will replace from ImportAsset down to end for simplicity.
@@ -102,6 +505,23 @@ namespace Himii
         return m_LoadedAssets.find(handle) != m_LoadedAssets.end();
     }
 
+    AssetHandle AssetManager::GetAssetHandleFromPath(const std::filesystem::path &filepath) const
+    {
+        auto it = m_AssetPathLookup.find(MakePathKey(NormalizeAssetPath(filepath)));
+        if (it != m_AssetPathLookup.end())
+            return it->second;
+        return 0;
+    }
+
+    const AssetMetadata &AssetManager::GetMetadata(AssetHandle handle) const
+    {
+        static AssetMetadata s_NullMetadata;
+        auto it = m_AssetRegistry.find(handle);
+        if (it != m_AssetRegistry.end())
+            return it->second;
+        return s_NullMetadata;
+    }
+
     AssetType AssetManager::GetAssetTypeFromExtension(const std::string &extension)
     {
         std::string ext = extension;
@@ -111,23 +531,209 @@ namespace Himii
             return AssetType::Texture2D;
         if (ext == ".anim")
             return AssetType::SpriteAnimation;
-        if (ext == ".himii")
+        if (ext == ".himii" || ext == ".hscn")
             return AssetType::Scene;
 
         return AssetType::None;
     }
 
+    namespace
+    {
+        // AssetRegistry.cache 布局：Header | Record[RecordCount] | 字符串表
+        struct AssetRegistryCacheHeader {
+            char Magic[4] = {'H', 'A', 'R', 'C'};
+            uint32_t Version = 1;
+            uint64_t SourceSize = 0;
+            int64_t SourceWriteTime = 0;
+            uint64_t SourceHash = 0;
+            uint32_t RecordCount = 0;
+            uint32_t StringTableSize = 0;
+        };
+
+        struct AssetRegistryCacheRecord {
+            uint64_t Handle = 0;
+            uint32_t PathOffset = 0; // 字符串表内偏移
+            uint32_t PathLength = 0;
+            uint16_t Type = 0;
+            uint16_t Padding0 = 0;
+            uint32_t Padding1 = 0;
+        };
+
+        static_assert(sizeof(AssetRegistryCacheHeader) == 40, "Cache header layout changed");
+        static_assert(sizeof(AssetRegistryCacheRecord) == 24, "Cache record layout changed");
+
+        constexpr uint32_t s_AssetRegistryCacheVersion = 1;
+
+        std::filesystem::path GetAssetRegistryCachePath(const std::filesystem::path &yamlPath)
+        {
+            return std::filesystem::path(yamlPath).replace_extension(".cache");
+        }
+
+        int64_t GetFileWriteTime(const std::filesystem::path &path)
+        {
+            std::error_code error;
+            auto time = std::filesystem::last_write_time(path, error);
+            return error ? 0 : (int64_t)time.time_since_epoch().count();
+        }
+
+        bool ReadFileBytes(const std::filesystem::path &path, std::string &out)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream)
+                return false;
+            stream.seekg(0, std::ios::end);
+            out.resize((size_t)stream.tellg());
+            stream.seekg(0, std::ios::beg);
+            stream.read(out.data(), (std::streamsize)out.size());
+            return (bool)stream;
+        }
+    } // namespace
+
+    bool AssetManager::LoadAssetRegistryCache(const std::filesystem::path &yamlPath)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Timer timer;
+        std::filesystem::path cachePath = GetAssetRegistryCachePath(yamlPath);
+
+        MappedFile file;
+        if (!file.Open(cachePath) || file.GetSize() < sizeof(AssetRegistryCacheHeader))
+            return false;
+
+        AssetRegistryCacheHeader header;
+        memcpy(&header, file.GetData(), sizeof(header));
+        if (memcmp(header.Magic, "HARC", 4) != 0 || header.Version != s_AssetRegistryCacheVersion)
+            return false;
+
+        size_t recordsSize = (size_t)header.RecordCount * sizeof(AssetRegistryCacheRecord);
+        if (file.GetSize() != sizeof(header) + recordsSize + header.StringTableSize)
+        {
+            HIMII_CORE_WARNING("Asset registry cache is truncated, rebuilding from YAML");
+            return false;
+        }
+
+        // 大小和修改时间一致直接信任缓存；否则比较内容哈希（例如版本控制检出只改变了时间戳）
+        std::error_code error;
+        uint64_t yamlSize = (uint64_t)std::filesystem::file_size(yamlPath, error);
+        bool refreshCache = false;
+        if (error || yamlSize != header.SourceSize || GetFileWriteTime(yamlPath) != header.SourceWriteTime)
+        {
+            std::string yamlBytes;
+            if (!ReadFileBytes(yamlPath, yamlBytes) || Hash::FNV1a64(yamlBytes) != header.SourceHash)
+                return false;
+            refreshCache = true;
+        }
+
+        const auto *records = reinterpret_cast<const AssetRegistryCacheRecord *>(file.GetData() + sizeof(header));
+        const char *strings = reinterpret_cast<const char *>(file.GetData() + sizeof(header) + recordsSize);
+
+        m_AssetPathLookup.reserve(m_AssetPathLookup.size() + header.RecordCount);
+        for (uint32_t i = 0; i < header.RecordCount; i++)
+        {
+            const AssetRegistryCacheRecord &record = records[i];
+            if ((uint64_t)record.PathOffset + record.PathLength > header.StringTableSize)
+            {
+                HIMII_CORE_WARNING("Asset registry cache is corrupted, rebuilding from YAML");
+                m_AssetRegistry.clear();
+                m_AssetPathLookup.clear();
+                return false;
+            }
+
+            AssetMetadata metadata;
+            metadata.Handle = record.Handle;
+            metadata.Type = (AssetType)record.Type;
+            metadata.FilePath = std::string_view(strings + record.PathOffset, record.PathLength);
+
+            // 记录按 Handle 升序写出，带提示插入是均摊常数时间
+            m_AssetPathLookup[MakePathKey(NormalizeAssetPath(metadata.FilePath))] = metadata.Handle;
+            m_AssetRegistry.emplace_hint(m_AssetRegistry.end(), metadata.Handle, std::move(metadata));
+        }
+
+        if (refreshCache)
+            WriteAssetRegistryCache(yamlPath, header.SourceHash);
+
+        HIMII_CORE_INFO("Loaded AssetRegistry from cache. Total assets: {0} ({1} ms)", m_AssetRegistry.size(),
+                        timer.ElapsedMillis());
+        return true;
+    }
+
+    void AssetManager::WriteAssetRegistryCache(const std::filesystem::path &yamlPath, uint64_t yamlHash)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        AssetRegistryCacheHeader header;
+        header.Version = s_AssetRegistryCacheVersion;
+        header.SourceSize = (uint64_t)std::filesystem::file_size(yamlPath);
+        header.SourceWriteTime = GetFileWriteTime(yamlPath);
+        header.SourceHash = yamlHash;
+        header.RecordCount = (uint32_t)m_AssetRegistry.size();
+
+        std::vector<AssetRegistryCacheRecord> records;
+        records.reserve(m_AssetRegistry.size());
+        std::string strings;
+        for (const auto &[handle, metadata]: m_AssetRegistry)
+        {
+            std::string path = metadata.FilePath.generic_string();
+
+            AssetRegistryCacheRecord record;
+            record.Handle = handle;
+            record.PathOffset = (uint32_t)strings.size();
+            record.PathLength = (uint32_t)path.size();
+            record.Type = (uint16_t)metadata.Type;
+            records.push_back(record);
+
+            strings += path;
+        }
+        header.StringTableSize = (uint32_t)strings.size();
+
+        // 先写临时文件再替换，避免中途失败留下半个缓存
+        std::filesystem::path cachePath = GetAssetRegistryCachePath(yamlPath);
+        std::filesystem::path tempPath = std::filesystem::path(cachePath).concat(".tmp");
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                HIMII_CORE_WARNING("Failed to write asset registry cache: {0}", cachePath.string());
+                return;
+            }
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(records.data()),
+                      (std::streamsize)(records.size() * sizeof(AssetRegistryCacheRecord)));
+            out.write(strings.data(), (std::streamsize)strings.size());
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, cachePath, error);
+        if (error)
+            HIMII_CORE_WARNING("Failed to replace asset registry cache: {0}", error.message());
+    }
+
     void AssetManager::SerializeAssetRegistry()
     {
         auto path = Project::GetAssetRegistryPath();
         
         HIMII_CORE_INFO("Serializing AssetRegistry to: {0}, Count: {1}", path.string(), m_AssetRegistry.size());
 
+        uint64_t contentHash = 0;
+        if (!WriteAssetRegistry(path, m_AssetRegistry, &contentHash))
+        {
+            // 磁盘上的 YAML 不完整，不能再生成与之对应的缓存
+            HIMII_CORE_ERROR("Failed to write asset registry: {0}", path.string());
+            return;
+        }
+
+        // YAML 写完后再生成缓存，记录的大小和修改时间才与磁盘一致
+        WriteAssetRegistryCache(path, contentHash);
+    }
+
+    bool AssetManager::WriteAssetRegistry(const std::filesystem::path &path, const AssetRegistry &registry,
+                                          uint64_t *contentHash)
+    {
         YAML::Emitter out;
         out << YAML::BeginMap;
         out << YAML::Key << "AssetRegistry" << YAML::Value << YAML::BeginSeq;
 
-        for (const auto &[handle, metadata]: m_AssetRegistry)
+        for (const auto &[handle, metadata]: registry)
         {
             out << YAML::BeginMap;
             out << YAML::Key << "Handle" << YAML::Value << (uint64_t)handle;
@@ -139,8 +745,13 @@ namespace Himii
         out << YAML::EndSeq;
         out << YAML::EndMap;
 
-        std::ofstream fout(path);
-        fout << out.c_str();
+        // 二进制模式写出，Windows 上不会把 LF 转成 CRLF，磁盘内容与计算哈希的文本一致
+        std::ofstream fout(path, std::ios::binary);
+        fout.write(out.c_str(), (std::streamsize)out.size());
+        fout.close();
+        if (contentHash)
+            *contentHash = Hash::FNV1a64(std::string_view(out.c_str(), out.size()));
+        return (bool)fout;
     }
 
     bool AssetManager::DeserializeAssetRegistry()
@@ -155,10 +766,21 @@ namespace Himii
             return false;
         }
 
+        if (LoadAssetRegistryCache(path))
+            return true;
+
+        Timer timer;
+        std::string yamlBytes;
+        if (!ReadFileBytes(path, yamlBytes))
+        {
+            HIMII_CORE_ERROR("Failed to read asset registry: {0}", path.string());
+            return false;
+        }
+
         YAML::Node data;
         try
         {
-            data = YAML::LoadFile(path.string());
+            data = YAML::Load(yamlBytes);
         }
         catch (std::exception &e)
         {
@@ -173,6 +795,7 @@ namespace Himii
             return false;
         }
 
+        m_AssetPathLookup.reserve(registryNode.size());
         for (auto node: registryNode)
         {
             AssetHandle handle = node["Handle"].as<uint64_t>();
@@ -180,9 +803,13 @@ namespace Himii
             metadata.Handle = handle;
             metadata.FilePath = node["FilePath"].as<std::string>();
             metadata.Type = Asset::AssetTypeFromString(node["Type"].as<std::string>());
+            m_AssetPathLookup[MakePathKey(NormalizeAssetPath(metadata.FilePath))] = handle;
         }
 
-        HIMII_CORE_INFO("Loaded AssetRegistry. Total assets: {0}", m_AssetRegistry.size());
+        HIMII_CORE_INFO("Loaded AssetRegistry. Total assets: {0} ({1} ms)", m_AssetRegistry.size(),
+                        timer.ElapsedMillis());
+
+        WriteAssetRegistryCache(path, Hash::FNV1a64(yamlBytes));
         return true;
     }
 } // namespace Himii
@@ -2,44 +2,197 @@
 
 #include "Himii/Asset/AssetMetadata.h"
 #include "Himii/Core/Core.h"
+#include "Himii/Renderer/TextureStreamer.h"
 
+#include <deque>
+#include <functional>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 namespace Himii
 {
 
     using AssetRegistry = std::map<AssetHandle, AssetMetadata>;
 
+    struct AssetMemoryStats {
+        uint64_t TotalBytes = 0;
+        std::unordered_map<AssetType, uint64_t> BytesByType;
+        uint32_t LoadedCount = 0;
+        uint32_t EvictionCount = 0;
+        uint64_t EvictedBytes = 0;
+
+        uint64_t GetBytes(AssetType type) const
+        {
+            auto it = BytesByType.find(type);
+            return it != BytesByType.end() ? it->second : 0;
+        }
+    };
+
+    struct AssetResidency {
+        AssetHandle Handle = 0;
+        AssetType Type = AssetType::None;
+        uint64_t Size = 0;
+        uint64_t LastUsedFrame = 0;
+        long RefCount = 0; // 不含 AssetManager 自己持有的引用
+    };
+
+    struct AssetEvictionEvent {
+        AssetHandle Handle = 0;
+        AssetType Type = AssetType::None;
+        uint64_t Size = 0;
+        uint64_t Frame = 0;
+    };
+
+    struct AssetLoadTiming {
+        AssetHandle Handle = 0;
+        AssetType Type = AssetType::None;
+        float Milliseconds = 0.0f; // 动画是解析耗时；纹理是从请求到上传完成的耗时
+        bool Succeeded = false;
+    };
+
+    struct AssetPreloadReport {
+        std::vector<AssetLoadTiming> Assets; // 本次实际加载的资源，已加载的不计入
+        uint32_t AlreadyLoaded = 0;
+        float TotalMilliseconds = 0.0f;
+    };
+
+    // completed / total 均为需要实际加载的资源数
+    using AssetPreloadProgressFn = std::function<void(uint32_t completed, uint32_t total)>;
+
     class AssetManager {
     public:
         AssetManager();
-        ~AssetManager() = default;
+        ~AssetManager();
 
         // 核心 API
         Ref<Asset> GetAsset(AssetHandle handle);
 
+        template<typename T>
+        Ref<T> GetAsset(AssetHandle handle)
+        {
+            return std::static_pointer_cast<T>(GetAsset(handle));
+        }
+
         // 编辑器使用：导入新文件到系统
         AssetHandle ImportAsset(const std::filesystem::path &filepath);
+        // 批量导入，返回值与输入一一对应，不支持的文件为 0
+        std::vector<AssetHandle> ImportAssets(const std::vector<std::filesystem::path> &filepaths);
+        // 递归导入资产目录下某个子目录中所有支持的文件，返回新导入的数量
+        uint32_t ImportDirectory(const std::filesystem::path &directory = {});
+
+        // 转换为相对资产目录、lexically_normal 的路径，注册表和查找都使用这种形式
+        static std::filesystem::path NormalizeAssetPath(const std::filesystem::path &filepath);
 
         // 检查是否存在
         bool IsAssetHandleValid(AssetHandle handle) const;
         bool IsAssetLoaded(AssetHandle handle) const;
 
+        // 相对资产目录的路径 -> Handle，未导入时返回 0
+        AssetHandle GetAssetHandleFromPath(const std::filesystem::path &filepath) const;
+        const AssetMetadata &GetMetadata(AssetHandle handle) const;
+
         const AssetRegistry &GetAssetRegistry() const
         {
             return m_AssetRegistry;
         }
 
+        // 按 AssetRegistry.yaml 的格式写出任意注册表（构建时写裁剪后的注册表）
+        static bool WriteAssetRegistry(const std::filesystem::path &path, const AssetRegistry &registry,
+                                       uint64_t *contentHash = nullptr);
+
         // 临时辅助：根据扩展名猜测类型
         static AssetType GetAssetTypeFromExtension(const std::string &extension);
 
+        // 主线程每帧调用，推进异步加载（纹理上传等）
+        void Update();
+
+        // 阻塞加载一组资源及其依赖（动画引用的纹理），动画在工作线程并行解析，纹理并行解码后一次性上传
+        AssetPreloadReport PreloadAssets(const std::vector<AssetHandle> &handles,
+                                         const AssetPreloadProgressFn &onProgress = nullptr);
+
+        // 开启后 Texture2D 先返回占位纹理，后台解码、按帧预算上传
+        void SetAsyncTextureLoading(bool enabled)
+        {
+            m_AsyncTextureLoading = enabled;
+        }
+
+        bool IsAsyncTextureLoading() const
+        {
+            return m_AsyncTextureLoading;
+        }
+
+        TextureLoadState GetTextureLoadState(AssetHandle handle) const;
+        // 尚未发生过异步加载时返回 nullptr
+        TextureStreamer *GetTextureStreamer() const
+        {
+            return m_TextureStreamer.get();
+        }
+
+        // 内存预算，超出时按最近最少使用顺序卸载没有外部引用的资源；0 表示不限制
+        void SetMemoryBudget(uint64_t bytes)
+        {
+            m_MemoryBudget = bytes;
+        }
+
+        uint64_t GetMemoryBudget() const
+        {
+            return m_MemoryBudget;
+        }
+
+        const AssetMemoryStats &GetMemoryStats() const
+        {
+            return m_MemoryStats;
+        }
+
+        // 当前常驻的资源，按占用从大到小排序
+        std::vector<AssetResidency> GetResidency() const;
+
+        const std::deque<AssetEvictionEvent> &GetEvictionLog() const
+        {
+            return m_EvictionLog;
+        }
+
+        // 立即卸载所有没有外部引用的资源，返回卸载数量
+        uint32_t UnloadUnusedAssets();
+
         void SerializeAssetRegistry();
 
         bool DeserializeAssetRegistry();
 
     private:
+        void AddLoadedAsset(AssetHandle handle, const Ref<Asset> &asset);
+        AssetHandle ImportAssetInternal(const std::filesystem::path &filepath, bool &imported);
+
+        // 二进制注册表缓存（AssetRegistry.cache），YAML 仍是版本控制中的权威数据
+        bool LoadAssetRegistryCache(const std::filesystem::path &yamlPath);
+        void WriteAssetRegistryCache(const std::filesystem::path &yamlPath, uint64_t yamlHash);
+
+        void RecalculateMemoryStats();
+        // 卸载无外部引用的资源直到总占用不超过 targetBytes
+        uint32_t EvictUnusedAssets(uint64_t targetBytes);
+
+    private:
+        struct LoadedAsset {
+            Ref<Asset> Instance;
+            uint64_t LastUsedFrame = 0;
+        };
+
         AssetRegistry m_AssetRegistry;
-        std::unordered_map<AssetHandle, Ref<Asset>> m_LoadedAssets;
+        std::unordered_map<AssetHandle, LoadedAsset> m_LoadedAssets;
+        // 规范化路径 -> Handle，与 m_AssetRegistry 同步维护，按路径查找不再遍历注册表
+        std::unordered_map<std::string, AssetHandle> m_AssetPathLookup;
+
+        bool m_AsyncTextureLoading = true;
+        // 第一次异步加载纹理时才创建，避免不需要时启动工作线程
+        Scope<TextureStreamer> m_TextureStreamer;
+
+        uint64_t m_FrameIndex = 0;
+        uint64_t m_MemoryBudget = 0;
+        AssetMemoryStats m_MemoryStats;
+        // 资源加载/卸载或纹理上传完成后需要重新统计
+        bool m_MemoryStatsDirty = false;
+        uint32_t m_LastStreamedCount = 0;
+        std::deque<AssetEvictionEvent> m_EvictionLog;
     };
 } // namespace Himii
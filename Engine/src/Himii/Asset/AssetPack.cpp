@@ -0,0 +1,298 @@
+#include "Hepch.h"
+#include "Himii/Asset/AssetPack.h"
+
+#include "Himii/Core/Timer.h"
+#include "Himii/Utils/Hash.h"
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr uint32_t s_AssetPackVersion = 1;
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        bool ReadFileBytes(const std::filesystem::path &path, std::vector<char> &out)
+        {
+            std::ifstream stream(path, std::ios::binary);
+            if (!stream)
+                return false;
+            stream.seekg(0, std::ios::end);
+            out.resize((size_t)stream.tellg());
+            stream.seekg(0, std::ios::beg);
+            stream.read(out.data(), (std::streamsize)out.size());
+            return (bool)stream;
+        }
+    } // namespace
+
+    std::string AssetPack::MakePathKey(const std::filesystem::path &relativePath)
+    {
+        // Windows 文件系统不区分大小写，包内查找也保持一致
+        std::string key = relativePath.lexically_normal().generic_u8string();
+        if (key.rfind("./", 0) == 0)
+            key.erase(0, 2);
+        for (char &c: key)
+        {
+            if (c >= 'A' && c <= 'Z')
+                c = (char)(c - 'A' + 'a');
+        }
+        return key;
+    }
+
+    bool AssetPack::Open(const std::filesystem::path &filepath)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Close();
+        if (!m_File.Open(filepath) || m_File.GetSize() < sizeof(AssetPackHeader))
+        {
+            HIMII_CORE_ERROR("Failed to open asset pack '{0}'", filepath.string());
+            m_File.Close();
+            return false;
+        }
+
+        AssetPackHeader header;
+        memcpy(&header, m_File.GetData(), sizeof(header));
+        if (memcmp(header.Magic, "HPAK", 4) != 0 || header.Version != s_AssetPackVersion)
+        {
+            HIMII_CORE_ERROR("'{0}' is not an asset pack of version {1}", filepath.string(), s_AssetPackVersion);
+            m_File.Close();
+            return false;
+        }
+
+        uint64_t fileSize = m_File.GetSize();
+        uint64_t tocEnd = header.TocOffset + (uint64_t)header.EntryCount * sizeof(AssetPackEntry);
+        if (tocEnd > fileSize || header.StringTableOffset + header.StringTableSize > fileSize)
+        {
+            HIMII_CORE_ERROR("Asset pack '{0}' is truncated", filepath.string());
+            m_File.Close();
+            return false;
+        }
+
+        m_Entries.resize(header.EntryCount);
+        if (header.EntryCount > 0)
+            memcpy(m_Entries.data(), m_File.GetData() + header.TocOffset, m_Entries.size() * sizeof(AssetPackEntry));
+
+        // 一次校验所有条目的边界，之后的读取不再逐次检查
+        for (const auto &entry: m_Entries)
+        {
+            bool compressed = (entry.Flags & AssetPackEntry_LZ4) != 0;
+            if (entry.Offset + entry.StoredSize > fileSize ||
+                (uint64_t)entry.PathOffset + entry.PathLength > header.StringTableSize ||
+                (!compressed && entry.StoredSize != entry.Size) ||
+                (compressed && entry.Size > (uint64_t)LZ4_MAX_INPUT_SIZE))
+            {
+                HIMII_CORE_ERROR("Asset pack '{0}' has a corrupt table of contents", filepath.string());
+                Close();
+                return false;
+            }
+        }
+
+        m_StringTable = reinterpret_cast<const char *>(m_File.GetData() + header.StringTableOffset);
+        m_Path = filepath;
+        return true;
+    }
+
+    void AssetPack::Close()
+    {
+        m_File.Close();
+        m_Entries.clear();
+        m_StringTable = nullptr;
+        m_Path.clear();
+    }
+
+    const AssetPackEntry *AssetPack::Find(const std::filesystem::path &relativePath) const
+    {
+        std::string key = MakePathKey(relativePath);
+        uint64_t hash = Hash::FNV1a64(key);
+
+        auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), hash,
+                                   [](const AssetPackEntry &entry, uint64_t value) { return entry.PathHash < value; });
+        // 哈希冲突时逐个比较路径
+        for (; it != m_Entries.end() && it->PathHash == hash; ++it)
+        {
+            if (MakePathKey(std::filesystem::u8path(GetEntryPath(*it))) == key)
+                return &*it;
+        }
+        return nullptr;
+    }
+
+    std::string_view AssetPack::GetEntryPath(const AssetPackEntry &entry) const
+    {
+        return std::string_view(m_StringTable + entry.PathOffset, entry.PathLength);
+    }
+
+    bool AssetPack::Read(const AssetPackEntry &entry, std::vector<uint8_t> &out) const
+    {
+        out.resize((size_t)entry.Size);
+        if (entry.Size == 0)
+            return true;
+
+        const uint8_t *stored = m_File.GetData() + entry.Offset;
+        if (!(entry.Flags & AssetPackEntry_LZ4))
+        {
+            memcpy(out.data(), stored, (size_t)entry.Size);
+            return true;
+        }
+
+        int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char *>(stored),
+                                                   reinterpret_cast<char *>(out.data()), (int)entry.StoredSize,
+                                                   (int)entry.Size);
+        return decompressedSize == (int)entry.Size;
+    }
+
+    bool AssetPack::Write(const std::filesystem::path &sourceDirectory, const std::filesystem::path &packPath,
+                          const AssetPackWriteOptions &options, AssetPackWriteReport *report)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Timer timer;
+        std::error_code error;
+        if (!std::filesystem::is_directory(sourceDirectory, error))
+        {
+            HIMII_CORE_ERROR("Asset pack source '{0}' is not a directory", sourceDirectory.string());
+            return false;
+        }
+
+        // 按路径排序，同样的输入得到同样的包
+        std::vector<std::filesystem::path> files;
+        for (auto it = std::filesystem::recursive_directory_iterator(sourceDirectory, error);
+             !error && it != std::filesystem::recursive_directory_iterator(); it.increment(error))
+        {
+            if (it->is_regular_file(error))
+                files.push_back(it->path().lexically_relative(sourceDirectory));
+        }
+        std::sort(files.begin(), files.end());
+
+        uint64_t alignment = options.Alignment;
+        if (alignment < 8 || (alignment & (alignment - 1)) != 0)
+            alignment = 16;
+
+        std::filesystem::path tempPath = std::filesystem::path(packPath).concat(".tmp");
+        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            HIMII_CORE_ERROR("Failed to create asset pack '{0}'", packPath.string());
+            return false;
+        }
+
+        AssetPackHeader header;
+        header.Version = s_AssetPackVersion;
+        header.Alignment = (uint32_t)alignment;
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+        uint64_t offset = sizeof(header);
+        auto padTo = [&](uint64_t align)
+        {
+            static const char zeros[64] = {};
+            uint64_t aligned = AlignUp(offset, align);
+            while (offset < aligned)
+            {
+                uint64_t count = std::min<uint64_t>(aligned - offset, sizeof(zeros));
+                out.write(zeros, (std::streamsize)count);
+                offset += count;
+            }
+        };
+
+        AssetPackWriteReport result;
+        std::vector<AssetPackEntry> entries;
+        entries.reserve(files.size());
+        std::string stringTable;
+        std::vector<char> bytes, compressed;
+        for (const auto &file: files)
+        {
+            if (!ReadFileBytes(sourceDirectory / file, bytes))
+            {
+                HIMII_CORE_ERROR("Failed to read '{0}' while packing assets", (sourceDirectory / file).string());
+                out.close();
+                std::filesystem::remove(tempPath, error);
+                return false;
+            }
+
+            std::string pathString = file.generic_u8string();
+            AssetPackEntry entry;
+            entry.PathHash = Hash::FNV1a64(MakePathKey(file));
+            entry.Size = bytes.size();
+            entry.PathOffset = (uint32_t)stringTable.size();
+            entry.PathLength = (uint32_t)pathString.size();
+            stringTable += pathString;
+
+            const char *data = bytes.data();
+            uint64_t storedSize = bytes.size();
+            if (options.Compress && !bytes.empty() && bytes.size() <= (size_t)LZ4_MAX_INPUT_SIZE)
+            {
+                compressed.resize((size_t)LZ4_compressBound((int)bytes.size()));
+                int compressedSize =
+                        LZ4_compress_default(bytes.data(), compressed.data(), (int)bytes.size(), (int)compressed.size());
+                if (compressedSize > 0 && compressedSize < bytes.size() * options.MinCompressionRatio)
+                {
+                    data = compressed.data();
+                    storedSize = (uint64_t)compressedSize;
+                    entry.Flags |= AssetPackEntry_LZ4;
+                    ++result.CompressedCount;
+                }
+            }
+
+            padTo(alignment);
+            entry.Offset = offset;
+            entry.StoredSize = storedSize;
+            out.write(data, (std::streamsize)storedSize);
+            offset += storedSize;
+
+            entries.push_back(entry);
+            result.SourceBytes += entry.Size;
+        }
+
+        // 同哈希的条目保持路径顺序
+        std::stable_sort(entries.begin(), entries.end(),
+                         [](const AssetPackEntry &a, const AssetPackEntry &b) { return a.PathHash < b.PathHash; });
+
+        padTo(8);
+        header.EntryCount = (uint32_t)entries.size();
+        header.TocOffset = offset;
+        out.write(reinterpret_cast<const char *>(entries.data()), (std::streamsize)(entries.size() * sizeof(AssetPackEntry)));
+        offset += entries.size() * sizeof(AssetPackEntry);
+
+        header.StringTableOffset = offset;
+        header.StringTableSize = stringTable.size();
+        out.write(stringTable.data(), (std::streamsize)stringTable.size());
+        offset += stringTable.size();
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.close();
+        if (!out)
+        {
+            HIMII_CORE_ERROR("Failed to write asset pack '{0}'", packPath.string());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+
+        std::filesystem::rename(tempPath, packPath, error);
+        if (error)
+        {
+            HIMII_CORE_ERROR("Failed to replace asset pack '{0}': {1}", packPath.string(), error.message());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+
+        result.FileCount = (uint32_t)entries.size();
+        result.PackBytes = offset;
+        result.Milliseconds = timer.ElapsedMillis();
+        HIMII_CORE_INFO("Packed {0} files ({1} compressed) from '{2}': {3} KB -> {4} KB in {5:.2f} ms", result.FileCount,
+                        result.CompressedCount, sourceDirectory.string(), result.SourceBytes / 1024,
+                        result.PackBytes / 1024, result.Milliseconds);
+        if (report)
+            *report = result;
+        return true;
+    }
+} // namespace Himii
@@ -0,0 +1,108 @@
+#pragma once
+#include "Himii/Core/Core.h"
+#include "Himii/Utils/MappedFile.h"
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Himii
+{
+    // .hpak 文件布局：Header | 条目数据（按 Alignment 对齐） | TOC（按路径哈希排序） | 字符串表
+    struct AssetPackHeader {
+        char Magic[4] = {'H', 'P', 'A', 'K'};
+        uint32_t Version = 0;
+        uint32_t EntryCount = 0;
+        uint32_t Alignment = 0;
+        uint64_t TocOffset = 0;
+        uint64_t StringTableOffset = 0;
+        uint64_t StringTableSize = 0;
+    };
+    static_assert(sizeof(AssetPackHeader) == 40, "AssetPackHeader layout changed, bump the pack version");
+
+    enum AssetPackEntryFlags : uint32_t {
+        AssetPackEntry_None = 0,
+        AssetPackEntry_LZ4 = 1 << 0,
+    };
+
+    struct AssetPackEntry {
+        uint64_t PathHash = 0; // 规范化路径（小写、'/' 分隔）的 FNV-1a
+        uint64_t Offset = 0;
+        uint64_t StoredSize = 0; // 包内字节数，压缩时为压缩后大小
+        uint64_t Size = 0;       // 原始文件大小
+        uint32_t PathOffset = 0; // 字符串表中的原始相对路径
+        uint32_t PathLength = 0;
+        uint32_t Flags = AssetPackEntry_None;
+        uint32_t Padding = 0;
+    };
+    static_assert(sizeof(AssetPackEntry) == 48, "AssetPackEntry layout changed, bump the pack version");
+
+    struct AssetPackWriteOptions {
+        bool Compress = true;
+        uint32_t Alignment = 16; // 2 的幂，未压缩条目可以在映射内存上直接按 POD 读取
+        // 压缩后不小于原大小的这个比例就原样存储（已压缩的 png/jpg 基本都会落到这里）
+        float MinCompressionRatio = 0.9f;
+    };
+
+    struct AssetPackWriteReport {
+        uint32_t FileCount = 0;
+        uint32_t CompressedCount = 0;
+        uint64_t SourceBytes = 0;
+        uint64_t PackBytes = 0;
+        float Milliseconds = 0.0f;
+    };
+
+    // 只读的资源包：整个文件内存映射，TOC 常驻内存，按路径哈希二分查找
+    class AssetPack {
+    public:
+        AssetPack() = default;
+
+        AssetPack(const AssetPack &) = delete;
+        AssetPack &operator=(const AssetPack &) = delete;
+
+        bool Open(const std::filesystem::path &filepath);
+        void Close();
+
+        bool IsOpen() const
+        {
+            return m_File.IsOpen();
+        }
+
+        const std::filesystem::path &GetPath() const
+        {
+            return m_Path;
+        }
+
+        const std::vector<AssetPackEntry> &GetEntries() const
+        {
+            return m_Entries;
+        }
+
+        // relativePath 相对于打包时的根目录，大小写和分隔符不敏感；不存在返回 nullptr
+        const AssetPackEntry *Find(const std::filesystem::path &relativePath) const;
+
+        std::string_view GetEntryPath(const AssetPackEntry &entry) const;
+
+        // 未压缩条目直接指向映射内存，压缩条目返回 nullptr
+        const uint8_t *GetStoredData(const AssetPackEntry &entry) const
+        {
+            return (entry.Flags & AssetPackEntry_LZ4) ? nullptr : m_File.GetData() + entry.Offset;
+        }
+
+        // 读取（必要时解压）到 out，可在多个线程上并发调用
+        bool Read(const AssetPackEntry &entry, std::vector<uint8_t> &out) const;
+
+        // 打包 sourceDirectory 下的所有文件，先写临时文件再替换
+        static bool Write(const std::filesystem::path &sourceDirectory, const std::filesystem::path &packPath,
+                          const AssetPackWriteOptions &options = {}, AssetPackWriteReport *report = nullptr);
+
+        static std::string MakePathKey(const std::filesystem::path &relativePath);
+
+    private:
+        std::filesystem::path m_Path;
+        MappedFile m_File;
+        std::vector<AssetPackEntry> m_Entries;
+        const char *m_StringTable = nullptr;
+    };
+} // namespace Himii
@@ -1,10 +1,68 @@
 #include "Himii/Asset/AssetSerializer.h"
+#include <cstring>
 #include <fstream>
 #include <yaml-cpp/yaml.h>
 #include "Himii/Core/Log.h"
+#include "Himii/Asset/VirtualFileSystem.h"
 
 namespace Himii
 {
+    namespace
+    {
+        // 烘焙后的动画：Header | uint64 Frames[FrameCount] | SheetFrameRecord[SheetFrameCount]
+        struct SpriteAnimationBinaryHeader {
+            char Magic[4] = {'H', 'A', 'N', 'I'};
+            uint32_t Version = 1;
+            uint64_t Handle = 0;
+            uint64_t SpriteSheet = 0;
+            uint32_t FrameCount = 0;
+            uint32_t SheetFrameCount = 0;
+        };
+        static_assert(sizeof(SpriteAnimationBinaryHeader) == 32, "SpriteAnimation binary layout changed");
+
+        struct SheetFrameRecord {
+            float UVMin[2];
+            float UVMax[2];
+            float Duration;
+        };
+        static_assert(sizeof(SheetFrameRecord) == 20, "SpriteAnimation binary layout changed");
+
+        Ref<SpriteAnimation> DeserializeBinary(const VirtualFile &file, const std::filesystem::path &filepath)
+        {
+            SpriteAnimationBinaryHeader header;
+            memcpy(&header, file.GetData(), sizeof(header));
+            uint64_t expectedSize = sizeof(header) + (uint64_t)header.FrameCount * sizeof(uint64_t) +
+                                    (uint64_t)header.SheetFrameCount * sizeof(SheetFrameRecord);
+            if (header.Version != 1 || expectedSize != file.GetSize())
+            {
+                HIMII_CORE_ERROR("Invalid SpriteAnimation asset: {0}", filepath.string());
+                return nullptr;
+            }
+
+            Ref<SpriteAnimation> animation = std::make_shared<SpriteAnimation>();
+            animation->Handle = header.Handle;
+
+            const uint8_t *cursor = file.GetData() + sizeof(header);
+            for (uint32_t i = 0; i < header.FrameCount; ++i, cursor += sizeof(uint64_t))
+            {
+                uint64_t handle;
+                memcpy(&handle, cursor, sizeof(handle));
+                animation->AddFrame(handle);
+            }
+
+            if (header.SpriteSheet != 0)
+                animation->SetSpriteSheet(header.SpriteSheet);
+            for (uint32_t i = 0; i < header.SheetFrameCount; ++i, cursor += sizeof(SheetFrameRecord))
+            {
+                SheetFrameRecord record;
+                memcpy(&record, cursor, sizeof(record));
+                animation->AddSheetFrame({{record.UVMin[0], record.UVMin[1]},
+                                          {record.UVMax[0], record.UVMax[1]},
+                                          record.Duration});
+            }
+            return animation;
+        }
+    } // namespace
 
     void SpriteAnimationSerializer::Serialize(const std::filesystem::path &filepath,
                                               const Ref<SpriteAnimation> &animation)
@@ -21,19 +79,68 @@ namespace Himii
         }
         out << YAML::EndSeq;
 
+        if (animation->IsSpriteSheet())
+        {
+            out << YAML::Key << "SpriteSheet" << YAML::Value << (uint64_t)animation->GetSpriteSheet();
+            out << YAML::Key << "SheetFrames" << YAML::Value << YAML::BeginSeq;
+            for (const auto &frame: animation->GetSheetFrames())
+            {
+                out << YAML::BeginMap;
+                out << YAML::Key << "UVMin" << YAML::Value << YAML::Flow << YAML::BeginSeq << frame.UVMin.x
+                    << frame.UVMin.y << YAML::EndSeq;
+                out << YAML::Key << "UVMax" << YAML::Value << YAML::Flow << YAML::BeginSeq << frame.UVMax.x
+                    << frame.UVMax.y << YAML::EndSeq;
+                out << YAML::Key << "Duration" << YAML::Value << frame.Duration;
+                out << YAML::EndMap;
+            }
+            out << YAML::EndSeq;
+        }
+
         out << YAML::EndMap;
 
         std::ofstream fout(filepath);
         fout << out.c_str();
     }
 
+    bool SpriteAnimationSerializer::SerializeBinary(const std::filesystem::path &filepath,
+                                                    const Ref<SpriteAnimation> &animation)
+    {
+        SpriteAnimationBinaryHeader header;
+        header.Handle = (uint64_t)animation->Handle;
+        header.SpriteSheet = (uint64_t)animation->GetSpriteSheet();
+        header.FrameCount = (uint32_t)animation->GetFrames().size();
+        header.SheetFrameCount = animation->IsSpriteSheet() ? (uint32_t)animation->GetSheetFrames().size() : 0;
+
+        std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (AssetHandle frame: animation->GetFrames())
+        {
+            uint64_t handle = (uint64_t)frame;
+            out.write(reinterpret_cast<const char *>(&handle), sizeof(handle));
+        }
+        for (uint32_t i = 0; i < header.SheetFrameCount; ++i)
+        {
+            const SpriteSheetFrame &frame = animation->GetSheetFrames()[i];
+            SheetFrameRecord record{{frame.UVMin.x, frame.UVMin.y}, {frame.UVMax.x, frame.UVMax.y}, frame.Duration};
+            out.write(reinterpret_cast<const char *>(&record), sizeof(record));
+        }
+        return (bool)out;
+    }
+
     Ref<SpriteAnimation> SpriteAnimationSerializer::Deserialize(const std::filesystem::path &filepath)
     {
-        std::ifstream stream(filepath);
-        std::stringstream strStream;
-        strStream << stream.rdbuf();
+        VirtualFile file;
+        if (!VirtualFileSystem::ReadFile(filepath, file))
+        {
+            HIMII_CORE_ERROR("Failed to read SpriteAnimation asset: {0}", filepath.string());
+            return nullptr;
+        }
+
+        // 烘焙后的二进制动画保持原文件名，按文件头识别
+        if (file.GetSize() >= sizeof(SpriteAnimationBinaryHeader) && memcmp(file.GetData(), "HANI", 4) == 0)
+            return DeserializeBinary(file, filepath);
 
-        YAML::Node data = YAML::Load(strStream.str());
+        YAML::Node data = YAML::Load(std::string(reinterpret_cast<const char *>(file.GetData()), file.GetSize()));
         if (!data["AssetType"] || data["AssetType"].as<std::string>() != "SpriteAnimation")
         {
             HIMII_CORE_ERROR("Invalid SpriteAnimation asset: {0}", filepath.string());
@@ -54,6 +161,26 @@ namespace Himii
             }
         }
 
+        if (data["SpriteSheet"])
+        {
+            animation->SetSpriteSheet(data["SpriteSheet"].as<uint64_t>());
+
+            if (auto sheetFrames = data["SheetFrames"])
+            {
+                for (auto frameNode: sheetFrames)
+                {
+                    SpriteSheetFrame frame;
+                    if (auto uvMin = frameNode["UVMin"]; uvMin && uvMin.size() == 2)
+                        frame.UVMin = {uvMin[0].as<float>(), uvMin[1].as<float>()};
+                    if (auto uvMax = frameNode["UVMax"]; uvMax && uvMax.size() == 2)
+                        frame.UVMax = {uvMax[0].as<float>(), uvMax[1].as<float>()};
+                    if (frameNode["Duration"])
+                        frame.Duration = frameNode["Duration"].as<float>();
+                    animation->AddSheetFrame(frame);
+                }
+            }
+        }
+
         return animation;
     }
 
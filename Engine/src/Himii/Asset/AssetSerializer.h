@@ -9,6 +9,8 @@ namespace Himii
     class SpriteAnimationSerializer {
     public:
         static void Serialize(const std::filesystem::path &filepath, const Ref<SpriteAnimation> &animation);
+        // 构建时烘焙用的二进制格式，Deserialize 按文件头自动识别
+        static bool SerializeBinary(const std::filesystem::path &filepath, const Ref<SpriteAnimation> &animation);
         static Ref<SpriteAnimation> Deserialize(const std::filesystem::path &filepath);
     };
 
@@ -0,0 +1,187 @@
+#include "Hepch.h"
+#include "Himii/Asset/VirtualFileSystem.h"
+
+#include "Himii/Core/Timer.h"
+
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+
+namespace Himii
+{
+    namespace
+    {
+        struct PackMount {
+            Ref<AssetPack> Pack;
+            std::filesystem::path MountPoint;
+        };
+
+        std::vector<PackMount> s_Mounts;
+        std::shared_mutex s_MountMutex;
+
+        std::atomic<uint32_t> s_PackReads{0};
+        std::atomic<uint32_t> s_LooseReads{0};
+        std::atomic<uint64_t> s_PackBytes{0};
+        std::atomic<uint64_t> s_LooseBytes{0};
+        std::atomic<uint64_t> s_ReadMicroseconds{0};
+
+        std::filesystem::path MakeAbsolute(const std::filesystem::path &path)
+        {
+            std::error_code error;
+            std::filesystem::path absolutePath = std::filesystem::absolute(path, error);
+            return (error ? path : absolutePath).lexically_normal();
+        }
+
+        // 调用方持有 s_MountMutex 的读锁
+        const AssetPackEntry *FindInPacks(const std::filesystem::path &filepath, Ref<AssetPack> &pack)
+        {
+            if (s_Mounts.empty())
+                return nullptr;
+
+            std::filesystem::path path = MakeAbsolute(filepath);
+            // 后挂载的包优先，便于用补丁包覆盖
+            for (auto it = s_Mounts.rbegin(); it != s_Mounts.rend(); ++it)
+            {
+                std::filesystem::path relativePath = path.lexically_relative(it->MountPoint);
+                if (relativePath.empty() || *relativePath.begin() == "..")
+                    continue;
+
+                if (const AssetPackEntry *entry = it->Pack->Find(relativePath))
+                {
+                    pack = it->Pack;
+                    return entry;
+                }
+            }
+            return nullptr;
+        }
+    } // namespace
+
+    bool VirtualFileSystem::Mount(const std::filesystem::path &packPath, const std::filesystem::path &mountPoint)
+    {
+        Timer timer;
+        Ref<AssetPack> pack = CreateRef<AssetPack>();
+        if (!pack->Open(packPath))
+            return false;
+
+        size_t entryCount = pack->GetEntries().size();
+        {
+            std::unique_lock<std::shared_mutex> lock(s_MountMutex);
+            s_Mounts.push_back({std::move(pack), MakeAbsolute(mountPoint)});
+        }
+
+        HIMII_CORE_INFO("Mounted asset pack '{0}' ({1} files) at '{2}' in {3:.2f} ms", packPath.string(), entryCount,
+                        mountPoint.string(), timer.ElapsedMillis());
+        return true;
+    }
+
+    void VirtualFileSystem::UnmountAll()
+    {
+        // 正在使用的 VirtualFile 仍持有包的引用，映射在它们释放后才关闭
+        std::unique_lock<std::shared_mutex> lock(s_MountMutex);
+        s_Mounts.clear();
+    }
+
+    bool VirtualFileSystem::HasMounts()
+    {
+        std::shared_lock<std::shared_mutex> lock(s_MountMutex);
+        return !s_Mounts.empty();
+    }
+
+    bool VirtualFileSystem::Exists(const std::filesystem::path &filepath)
+    {
+        {
+            std::shared_lock<std::shared_mutex> lock(s_MountMutex);
+            Ref<AssetPack> pack;
+            if (FindInPacks(filepath, pack))
+                return true;
+        }
+
+        std::error_code error;
+        return std::filesystem::exists(filepath, error);
+    }
+
+    bool VirtualFileSystem::ReadFile(const std::filesystem::path &filepath, VirtualFile &out)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Timer timer;
+        out = VirtualFile();
+
+        Ref<AssetPack> pack;
+        const AssetPackEntry *entry = nullptr;
+        {
+            std::shared_lock<std::shared_mutex> lock(s_MountMutex);
+            entry = FindInPacks(filepath, pack);
+        }
+
+        if (entry)
+        {
+            out.m_Pack = pack;
+            if (const uint8_t *stored = pack->GetStoredData(*entry))
+            {
+                out.m_Data = stored;
+            }
+            else
+            {
+                if (!pack->Read(*entry, out.m_Buffer))
+                {
+                    HIMII_CORE_ERROR("Failed to decompress '{0}' from asset pack '{1}'", filepath.string(),
+                                     pack->GetPath().string());
+                    out = VirtualFile();
+                    return false;
+                }
+                out.m_Data = out.m_Buffer.data();
+            }
+            out.m_Size = (size_t)entry->Size;
+
+            ++s_PackReads;
+            s_PackBytes += out.m_Size;
+        }
+        else
+        {
+            if (!out.m_Mapped.Open(filepath))
+                return false;
+            out.m_Data = out.m_Mapped.GetData();
+            out.m_Size = out.m_Mapped.GetSize();
+
+            ++s_LooseReads;
+            s_LooseBytes += out.m_Size;
+        }
+
+        s_ReadMicroseconds += (uint64_t)(timer.ElapsedMillis() * 1000.0f);
+        return true;
+    }
+
+    bool VirtualFileSystem::ReadText(const std::filesystem::path &filepath, std::string &out)
+    {
+        VirtualFile file;
+        if (!ReadFile(filepath, file))
+            return false;
+
+        if (file.GetSize() > 0)
+            out.assign(reinterpret_cast<const char *>(file.GetData()), file.GetSize());
+        else
+            out.clear();
+        return true;
+    }
+
+    VirtualFileStats VirtualFileSystem::GetStats()
+    {
+        VirtualFileStats stats;
+        stats.PackReads = s_PackReads.load();
+        stats.LooseReads = s_LooseReads.load();
+        stats.PackBytes = s_PackBytes.load();
+        stats.LooseBytes = s_LooseBytes.load();
+        stats.ReadMilliseconds = s_ReadMicroseconds.load() / 1000.0f;
+        return stats;
+    }
+
+    void VirtualFileSystem::ResetStats()
+    {
+        s_PackReads = 0;
+        s_LooseReads = 0;
+        s_PackBytes = 0;
+        s_LooseBytes = 0;
+        s_ReadMicroseconds = 0;
+    }
+} // namespace Himii
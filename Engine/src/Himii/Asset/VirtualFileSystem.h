@@ -0,0 +1,68 @@
+#pragma once
+#include "Himii/Asset/AssetPack.h"
+#include "Himii/Core/Core.h"
+#include "Himii/Utils/MappedFile.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Himii
+{
+    // 一次读取的结果：包内未压缩条目直接指向包的映射内存，压缩条目解压到自有缓冲，散文件整体映射。
+    // 可移动不可复制，数据在对象存活期间有效
+    class VirtualFile {
+    public:
+        VirtualFile() = default;
+
+        const uint8_t *GetData() const
+        {
+            return m_Data;
+        }
+
+        size_t GetSize() const
+        {
+            return m_Size;
+        }
+
+        bool IsFromPack() const
+        {
+            return m_Pack != nullptr;
+        }
+
+    private:
+        const uint8_t *m_Data = nullptr;
+        size_t m_Size = 0;
+        std::vector<uint8_t> m_Buffer;
+        MappedFile m_Mapped;
+        Ref<AssetPack> m_Pack; // 保证映射在读取期间不被卸载
+
+        friend class VirtualFileSystem;
+    };
+
+    struct VirtualFileStats {
+        uint32_t PackReads = 0;
+        uint32_t LooseReads = 0;
+        uint64_t PackBytes = 0;  // 解压后的字节数
+        uint64_t LooseBytes = 0;
+        float ReadMilliseconds = 0.0f; // 所有线程上 ReadFile 的累计耗时
+    };
+
+    // 资源读取入口：挂载 .hpak 后，挂载点下的路径优先从包中读取，包里没有的再回退到磁盘上的散文件。
+    // 路径仍然是 Project::GetAssetFileSystemPath 返回的普通路径，调用方不需要区分来源。
+    // 可以在工作线程读取；挂载和卸载应在没有读取进行时调用
+    class VirtualFileSystem {
+    public:
+        static bool Mount(const std::filesystem::path &packPath, const std::filesystem::path &mountPoint);
+        static void UnmountAll();
+        static bool HasMounts();
+
+        static bool Exists(const std::filesystem::path &filepath);
+        static bool ReadFile(const std::filesystem::path &filepath, VirtualFile &out);
+        // YAML 等文本资源
+        static bool ReadText(const std::filesystem::path &filepath, std::string &out);
+
+        static VirtualFileStats GetStats();
+        static void ResetStats();
+    };
+} // namespace Himii
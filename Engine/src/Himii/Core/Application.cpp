@@ -10,7 +10,8 @@ namespace Himii
 {
     Application *Application::s_Instance = nullptr;
 
-    Application::Application(const std::string &name, ApplicationCommandLineArgs args) : m_CommandLineArgs(args)
+    Application::Application(const std::string &name, ApplicationCommandLineArgs args,
+                             const Renderer2DSpecification &renderer2DSpecification) : m_CommandLineArgs(args)
     {
         HIMII_PROFILE_FUNCTION();
 
@@ -20,7 +21,7 @@ namespace Himii
         m_Window = Window::Create(WindowProps(name));
         m_Window->SetEventCallback(BIND_EVENT_FN(Application::OnEvent));
 
-        Renderer::Init();
+        Renderer::Init(renderer2DSpecification);
         ScriptEngine::Init();
 
         m_ImGuiLayer = new ImGuiLayer();
@@ -4,6 +4,7 @@
 #include "Himii/Events/Event.h"
 #include "Himii/ImGui/ImGuiLayer.h"
 #include "Himii/Renderer/Buffer.h"
+#include "Himii/Renderer/Renderer2D.h"
 #include "Himii/Renderer/Shader.h"
 #include "Himii/Renderer/VertexArray.h"
 #include <filesystem>
@@ -25,7 +26,8 @@ namespace Himii
 
     class Application {
     public:
-        Application(const std::string &name = "Himii", ApplicationCommandLineArgs args = ApplicationCommandLineArgs());
+        Application(const std::string &name = "Himii", ApplicationCommandLineArgs args = ApplicationCommandLineArgs(),
+                    const Renderer2DSpecification &renderer2DSpecification = {});
         virtual ~Application();
 
         void OnEvent(Event &e);
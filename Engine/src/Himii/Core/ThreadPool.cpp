@@ -0,0 +1,82 @@
+#include "Hepch.h"
+#include "Himii/Core/ThreadPool.h"
+
+namespace Himii
+{
+    ThreadPool::ThreadPool(uint32_t threadCount)
+    {
+        if (threadCount == 0)
+        {
+            uint32_t hardwareThreads = std::thread::hardware_concurrency();
+            threadCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+        }
+
+        m_Workers.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; i++)
+            m_Workers.emplace_back([this]() { WorkerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Stopping = true;
+        }
+        m_JobAvailable.notify_all();
+
+        // 已在队列中的任务会先执行完再退出
+        for (auto &worker: m_Workers)
+        {
+            if (worker.joinable())
+                worker.join();
+        }
+    }
+
+    void ThreadPool::Submit(std::function<void()> job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Jobs.push(std::move(job));
+        }
+        m_JobAvailable.notify_one();
+    }
+
+    void ThreadPool::Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Idle.wait(lock, [this]() { return m_Jobs.empty() && m_ActiveJobs == 0; });
+    }
+
+    size_t ThreadPool::GetPendingJobCount() const
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Jobs.size();
+    }
+
+    void ThreadPool::WorkerLoop()
+    {
+        for (;;)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_JobAvailable.wait(lock, [this]() { return m_Stopping || !m_Jobs.empty(); });
+                if (m_Jobs.empty())
+                    return; // m_Stopping 且队列已空
+
+                job = std::move(m_Jobs.front());
+                m_Jobs.pop();
+                ++m_ActiveJobs;
+            }
+
+            job();
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                --m_ActiveJobs;
+                if (m_Jobs.empty() && m_ActiveJobs == 0)
+                    m_Idle.notify_all();
+            }
+        }
+    }
+} // namespace Himii
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Himii
+{
+    // 固定数量的工作线程，任务按提交顺序取出执行
+    class ThreadPool {
+    public:
+        // threadCount 为 0 时使用 硬件线程数 - 1（至少 1 个），给主线程留一个核
+        explicit ThreadPool(uint32_t threadCount = 0);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        void Submit(std::function<void()> job);
+
+        // 阻塞直到队列清空且所有任务执行完毕
+        void Wait();
+
+        uint32_t GetThreadCount() const
+        {
+            return (uint32_t)m_Workers.size();
+        }
+
+        size_t GetPendingJobCount() const;
+
+    private:
+        void WorkerLoop();
+
+    private:
+        std::vector<std::thread> m_Workers;
+        std::queue<std::function<void()>> m_Jobs;
+
+        mutable std::mutex m_Mutex;
+        std::condition_variable m_JobAvailable;
+        std::condition_variable m_Idle;
+        uint32_t m_ActiveJobs = 0;
+        bool m_Stopping = false;
+    };
+} // namespace Himii
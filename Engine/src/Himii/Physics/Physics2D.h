@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "box2d/box2d.h"
+
+namespace Himii
+{
+    // Box2D v3 的 Id 都是 8 字节的值类型，组件里用 void* 保存
+    namespace Physics2DUtils
+    {
+        inline void *BodyIdToPtr(b2BodyId id)
+        {
+            static_assert(sizeof(b2BodyId) <= sizeof(void *), "b2BodyId does not fit in a pointer");
+            void *ptr = nullptr;
+            std::memcpy(&ptr, &id, sizeof(id));
+            return ptr;
+        }
+
+        inline b2BodyId PtrToBodyId(void *ptr)
+        {
+            b2BodyId id = b2_nullBodyId;
+            std::memcpy(&id, &ptr, sizeof(id));
+            return id;
+        }
+
+        inline void *ShapeIdToPtr(b2ShapeId id)
+        {
+            static_assert(sizeof(b2ShapeId) <= sizeof(void *), "b2ShapeId does not fit in a pointer");
+            void *ptr = nullptr;
+            std::memcpy(&ptr, &id, sizeof(id));
+            return ptr;
+        }
+
+        inline b2ShapeId PtrToShapeId(void *ptr)
+        {
+            b2ShapeId id = b2_nullShapeId;
+            std::memcpy(&id, &ptr, sizeof(id));
+            return id;
+        }
+    } // namespace Physics2DUtils
+
+    // 项目级碰撞层矩阵，碰撞体的 CategoryBits 每一位对应一层
+    struct Physics2DLayerMatrix {
+        static constexpr uint32_t MaxLayers = 32;
+
+        std::array<std::string, MaxLayers> Names;
+        // CollidesWith[i] 的第 j 位表示第 i 层能否与第 j 层碰撞，保持对称
+        std::array<uint32_t, MaxLayers> CollidesWith;
+
+        Physics2DLayerMatrix()
+        {
+            Names[0] = "Default";
+            CollidesWith.fill(0xFFFFFFFFu);
+        }
+
+        bool CanCollide(uint32_t layerA, uint32_t layerB) const
+        {
+            return (CollidesWith[layerA] >> layerB) & 1u;
+        }
+
+        void SetCollision(uint32_t layerA, uint32_t layerB, bool collide)
+        {
+            if (collide)
+            {
+                CollidesWith[layerA] |= (1u << layerB);
+                CollidesWith[layerB] |= (1u << layerA);
+            }
+            else
+            {
+                CollidesWith[layerA] &= ~(1u << layerB);
+                CollidesWith[layerB] &= ~(1u << layerA);
+            }
+        }
+
+        // 多个层时取并集
+        uint32_t GetMaskForCategory(uint32_t categoryBits) const
+        {
+            uint32_t mask = 0;
+            for (uint32_t i = 0; i < MaxLayers; ++i)
+            {
+                if (categoryBits & (1u << i))
+                    mask |= CollidesWith[i];
+            }
+            return mask;
+        }
+    };
+
+    struct Physics2DStats {
+        int BodyCount = 0;
+        int ShapeCount = 0;
+        // 进入窄相的形状对数量
+        int ContactPairCount = 0;
+        // 最近一次在开启/关闭过滤时观察到的数量，便于对比
+        int FilteredPairCount = 0;
+        int UnfilteredPairCount = 0;
+    };
+
+    // 单个刚体的快照，48 字节
+    struct Physics2DBodyState {
+        enum Flag : uint32_t {
+            Awake = 1 << 0,
+            Enabled = 1 << 1
+        };
+
+        b2BodyId Body = b2_nullBodyId;
+        uint32_t Entity = 0; // entt::entity，含版本号
+        uint32_t Flags = 0;
+        b2Vec2 Position = {0.0f, 0.0f};
+        b2Rot Rotation = {1.0f, 0.0f};
+        b2Vec2 LinearVelocity = {0.0f, 0.0f};
+        float AngularVelocity = 0.0f;
+        float Padding = 0.0f;
+    };
+
+    // 物理快照只记录刚体状态；Box2D v3 没有公开接触缓存，恢复后接触由宽相在下一步重建
+    struct Physics2DSnapshot {
+        std::vector<Physics2DBodyState> Bodies;
+
+        size_t GetSize() const
+        {
+            return Bodies.size() * sizeof(Physics2DBodyState);
+        }
+    };
+
+    // 以下结构体与 C# 端 Himii.NativeContactEvent2D / NativeContactHitEvent2D 内存布局一致，修改时需同步
+    struct ContactEvent2D {
+        uint64_t EntityA = 0;
+        uint64_t EntityB = 0;
+        uint32_t IsSensor = 0; // 1: EntityA 是传感器，EntityB 是进入/离开的实体
+        uint32_t Padding = 0;
+    };
+
+    struct ContactHitEvent2D {
+        uint64_t EntityA = 0;
+        uint64_t EntityB = 0;
+        glm::vec2 Point{0.0f};
+        glm::vec2 Normal{0.0f};
+        float ApproachSpeed = 0.0f;
+        float Padding = 0.0f;
+    };
+
+    // 每个物理步收集一次，一帧内一次性交给脚本
+    struct Physics2DEvents {
+        std::vector<ContactEvent2D> BeginEvents;
+        std::vector<ContactEvent2D> EndEvents;
+        std::vector<ContactHitEvent2D> HitEvents;
+
+        void Clear()
+        {
+            // clear 保留容量，稳定运行后不再分配
+            BeginEvents.clear();
+            EndEvents.clear();
+            HitEvents.clear();
+        }
+
+        bool Empty() const
+        {
+            return BeginEvents.empty() && EndEvents.empty() && HitEvents.empty();
+        }
+    };
+} // namespace Himii
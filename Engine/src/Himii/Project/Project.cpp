@@ -1,6 +1,7 @@
 #include "Project.h"
 #include "Hepch.h"
 #include "Himii/Core/Application.h"
+#include "Himii/Asset/VirtualFileSystem.h"
 
 #include "ProjectSerializer.h"
 
@@ -9,6 +10,7 @@ namespace Himii
 
     Ref<Project> Project::New()
     {
+        VirtualFileSystem::UnmountAll();
         s_ActiveProject = CreateRef<Project>();
         s_ActiveProject->m_AssetManager = CreateRef<AssetManager>();
         s_ActiveProject->m_AssetManager->DeserializeAssetRegistry();
@@ -24,6 +26,13 @@ namespace Himii
         {
             project->m_ProjectDirectory = path.parent_path();
             s_ActiveProject = project;
+
+            // 发布版的资源打包在资产目录旁的 .hpak 中，挂载后 GetAssetFileSystemPath 返回的路径从包中读取
+            VirtualFileSystem::UnmountAll();
+            std::filesystem::path packPath = GetAssetPackPath();
+            if (std::filesystem::exists(packPath))
+                VirtualFileSystem::Mount(packPath, GetAssetDirectory());
+            s_ActiveProject->m_AssetManager->SetMemoryBudget((uint64_t)project->m_Config.AssetMemoryBudgetMB * 1024 * 1024);
             s_ActiveProject->m_AssetManager->DeserializeAssetRegistry();
             return s_ActiveProject;
         }
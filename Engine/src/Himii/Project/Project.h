@@ -4,6 +4,7 @@
 #include <Himii/Core/Core.h>
 #include "Himii/Asset/AssetManager.h" 
 #include "Himii/Core/Log.h"
+#include "Himii/Physics/Physics2D.h"
 
 namespace Himii
 {
@@ -13,6 +14,11 @@ namespace Himii
 		std::filesystem::path StartScene;
 		std::filesystem::path AssetDirectory = "assets";
         std::filesystem::path ScriptModulePath = "bin/Debug/GameAssembly.dll";
+
+        Physics2DLayerMatrix Physics2DLayers;
+
+        // 资源内存预算（MB），0 表示不限制
+        uint32_t AssetMemoryBudgetMB = 0;
 	};
 
 	class Project {
@@ -30,12 +36,23 @@ namespace Himii
         }
 
         // TODO(Yan): move to asset manager when we have one
+        // 挂载了资源包时返回的路径可能只存在于包中，需通过 VirtualFileSystem 读取
         static std::filesystem::path GetAssetFileSystemPath(const std::filesystem::path &path)
         {
             HIMII_CORE_ASSERT(s_ActiveProject);
             return GetAssetDirectory() / path;
         }
 
+        // 构建时资产目录打包到这里，例如 assets -> assets.hpak
+        static std::filesystem::path GetAssetPackPath()
+        {
+            HIMII_CORE_ASSERT(s_ActiveProject);
+            std::filesystem::path directory = GetAssetDirectory().lexically_normal();
+            if (!directory.has_filename())
+                directory = directory.parent_path();
+            return directory.concat(".hpak");
+        }
+
         static ProjectConfig &GetConfig()
         {
             return s_ActiveProject->m_Config;
@@ -24,6 +24,24 @@ namespace Himii
                 out << YAML::Key << "StartScene" << YAML::Value << config.StartScene.string();
                 out << YAML::Key << "AssetDirectory" << YAML::Value << config.AssetDirectory.string();
                 out << YAML::Key << "ScriptModulePath" << YAML::Value << config.ScriptModulePath.string();
+                out << YAML::Key << "AssetMemoryBudgetMB" << YAML::Value << config.AssetMemoryBudgetMB;
+
+                out << YAML::Key << "Physics2DLayers" << YAML::Value << YAML::BeginSeq;
+                for (uint32_t i = 0; i < Physics2DLayerMatrix::MaxLayers; ++i)
+                {
+                    const auto &layers = config.Physics2DLayers;
+                    // 只写出有名字或修改过的层
+                    if (layers.Names[i].empty() && layers.CollidesWith[i] == 0xFFFFFFFFu)
+                        continue;
+
+                    out << YAML::BeginMap;
+                    out << YAML::Key << "Index" << YAML::Value << i;
+                    out << YAML::Key << "Name" << YAML::Value << layers.Names[i];
+                    out << YAML::Key << "CollidesWith" << YAML::Value << YAML::Hex << layers.CollidesWith[i]
+                        << YAML::Dec;
+                    out << YAML::EndMap;
+                }
+                out << YAML::EndSeq;
                 out << YAML::EndMap; // Project
             }
             out << YAML::EndMap; // Root
@@ -58,6 +76,22 @@ namespace Himii
         config.StartScene = projectNode["StartScene"].as<std::string>();
         config.AssetDirectory = projectNode["AssetDirectory"].as<std::string>();
         config.ScriptModulePath = projectNode["ScriptModulePath"].as<std::string>();
+        if (projectNode["AssetMemoryBudgetMB"])
+            config.AssetMemoryBudgetMB = projectNode["AssetMemoryBudgetMB"].as<uint32_t>();
+
+        auto layersNode = projectNode["Physics2DLayers"];
+        if (layersNode)
+        {
+            for (auto layer: layersNode)
+            {
+                uint32_t index = layer["Index"].as<uint32_t>();
+                if (index >= Physics2DLayerMatrix::MaxLayers)
+                    continue;
+
+                config.Physics2DLayers.Names[index] = layer["Name"].as<std::string>();
+                config.Physics2DLayers.CollidesWith[index] = layer["CollidesWith"].as<uint32_t>();
+            }
+        }
         return true;
     }
 }
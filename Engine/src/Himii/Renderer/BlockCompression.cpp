@@ -0,0 +1,689 @@
+#include "Hepch.h"
+#include "Himii/Renderer/BlockCompression.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr int s_BlockPixels = 16;
+
+        float Clamp255(float value)
+        {
+            return std::min(255.0f, std::max(0.0f, value));
+        }
+
+        // 按主成分方向取块内的两个极端颜色作为初始端点
+        void FitEndpoints(const float (*pixels)[4], const bool *mask, int channels, float *endpoint0, float *endpoint1)
+        {
+            float mean[4] = {};
+            int count = 0;
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                if (!mask[i])
+                    continue;
+                for (int c = 0; c < channels; ++c)
+                    mean[c] += pixels[i][c];
+                ++count;
+            }
+            if (count == 0)
+            {
+                for (int c = 0; c < channels; ++c)
+                    endpoint0[c] = endpoint1[c] = 0.0f;
+                return;
+            }
+            for (int c = 0; c < channels; ++c)
+                mean[c] /= (float)count;
+
+            float covariance[4][4] = {};
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                if (!mask[i])
+                    continue;
+                for (int a = 0; a < channels; ++a)
+                    for (int b = 0; b < channels; ++b)
+                        covariance[a][b] += (pixels[i][a] - mean[a]) * (pixels[i][b] - mean[b]);
+            }
+
+            // 幂迭代求主轴，从方差最大的通道开始，避免初始方向与主轴正交
+            float axis[4] = {};
+            int widestChannel = 0;
+            for (int c = 1; c < channels; ++c)
+            {
+                if (covariance[c][c] > covariance[widestChannel][widestChannel])
+                    widestChannel = c;
+            }
+            for (int c = 0; c < channels; ++c)
+                axis[c] = covariance[widestChannel][c];
+            if (covariance[widestChannel][widestChannel] < 1e-6f)
+                axis[0] = 1.0f;
+            for (int iteration = 0; iteration < 16; ++iteration)
+            {
+                float next[4] = {};
+                float length = 0.0f;
+                for (int a = 0; a < channels; ++a)
+                {
+                    for (int b = 0; b < channels; ++b)
+                        next[a] += covariance[a][b] * axis[b];
+                    length = std::max(length, std::abs(next[a]));
+                }
+                if (length < 1e-6f)
+                    break;
+                for (int a = 0; a < channels; ++a)
+                    axis[a] = next[a] / length;
+            }
+
+            float minT = FLT_MAX, maxT = -FLT_MAX;
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                if (!mask[i])
+                    continue;
+                float t = 0.0f;
+                for (int c = 0; c < channels; ++c)
+                    t += (pixels[i][c] - mean[c]) * axis[c];
+                minT = std::min(minT, t);
+                maxT = std::max(maxT, t);
+            }
+
+            float axisLengthSq = 0.0f;
+            for (int c = 0; c < channels; ++c)
+                axisLengthSq += axis[c] * axis[c];
+            if (axisLengthSq < 1e-12f)
+                axisLengthSq = 1.0f;
+            for (int c = 0; c < channels; ++c)
+            {
+                endpoint0[c] = Clamp255(mean[c] + axis[c] * maxT / axisLengthSq);
+                endpoint1[c] = Clamp255(mean[c] + axis[c] * minT / axisLengthSq);
+            }
+        }
+
+        // 已知每个像素的插值权重（weight 为 endpoint1 的比例）时，最小二乘求端点；矩阵奇异时返回 false
+        bool RefineEndpoints(const float (*pixels)[4], const bool *mask, const float *weights, int channels,
+                             float *endpoint0, float *endpoint1)
+        {
+            float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+            float ax[4] = {}, bx[4] = {};
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                if (!mask[i])
+                    continue;
+                float b = weights[i];
+                float a = 1.0f - b;
+                aa += a * a;
+                ab += a * b;
+                bb += b * b;
+                for (int c = 0; c < channels; ++c)
+                {
+                    ax[c] += a * pixels[i][c];
+                    bx[c] += b * pixels[i][c];
+                }
+            }
+
+            float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) < 1e-6f)
+                return false;
+
+            float inverse = 1.0f / determinant;
+            for (int c = 0; c < channels; ++c)
+            {
+                endpoint0[c] = Clamp255((bb * ax[c] - ab * bx[c]) * inverse);
+                endpoint1[c] = Clamp255((aa * bx[c] - ab * ax[c]) * inverse);
+            }
+            return true;
+        }
+
+        void LoadBlock(const uint8_t *rgba, float (*pixels)[4])
+        {
+            for (int i = 0; i < s_BlockPixels; ++i)
+                for (int c = 0; c < 4; ++c)
+                    pixels[i][c] = (float)rgba[i * 4 + c];
+        }
+
+        // 完全透明的像素颜色不可见，换成其余像素的平均色，端点只需要拟合可见的颜色
+        void FillTransparentColors(float (*pixels)[4])
+        {
+            float mean[3] = {};
+            int count = 0;
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                if (pixels[i][3] == 0.0f)
+                    continue;
+                for (int c = 0; c < 3; ++c)
+                    mean[c] += pixels[i][c];
+                ++count;
+            }
+            if (count == 0 || count == s_BlockPixels)
+                return;
+
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                if (pixels[i][3] == 0.0f)
+                {
+                    for (int c = 0; c < 3; ++c)
+                        pixels[i][c] = mean[c] / (float)count;
+                }
+            }
+        }
+
+        // ---- BC1 ----
+
+        uint16_t PackRGB565(const float *color)
+        {
+            uint32_t r = (uint32_t)std::lround(color[0] * 31.0f / 255.0f);
+            uint32_t g = (uint32_t)std::lround(color[1] * 63.0f / 255.0f);
+            uint32_t b = (uint32_t)std::lround(color[2] * 31.0f / 255.0f);
+            return (uint16_t)((r << 11) | (g << 5) | b);
+        }
+
+        void UnpackRGB565(uint16_t packed, int *color)
+        {
+            int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+            color[0] = (r << 3) | (r >> 2);
+            color[1] = (g << 2) | (g >> 4);
+            color[2] = (b << 3) | (b >> 2);
+        }
+
+        struct ColorBlockResult {
+            uint16_t Color0 = 0;
+            uint16_t Color1 = 0;
+            uint32_t Indices = 0;
+            float Error = FLT_MAX;
+        };
+
+        // 按给定端点生成调色板并为每个像素选索引；threeColor 时索引 3 保留给透明像素
+        ColorBlockResult EvaluateColorBlock(const float (*pixels)[4], const bool *opaque, uint16_t color0,
+                                            uint16_t color1, bool threeColor, float *weights)
+        {
+            // 4 色模式要求 color0 > color1，3 色模式要求 color0 <= color1
+            if (threeColor ? color0 > color1 : color0 < color1)
+                std::swap(color0, color1);
+
+            int c0[3], c1[3];
+            UnpackRGB565(color0, c0);
+            UnpackRGB565(color1, c1);
+
+            int palette[4][3];
+            float paletteWeights[4];
+            for (int c = 0; c < 3; ++c)
+            {
+                palette[0][c] = c0[c];
+                palette[1][c] = c1[c];
+                if (threeColor)
+                {
+                    palette[2][c] = (c0[c] + c1[c]) / 2;
+                    palette[3][c] = 0;
+                }
+                else
+                {
+                    palette[2][c] = (2 * c0[c] + c1[c]) / 3;
+                    palette[3][c] = (c0[c] + 2 * c1[c]) / 3;
+                }
+            }
+            paletteWeights[0] = 0.0f;
+            paletteWeights[1] = 1.0f;
+            paletteWeights[2] = threeColor ? 0.5f : 1.0f / 3.0f;
+            paletteWeights[3] = threeColor ? 0.0f : 2.0f / 3.0f;
+
+            ColorBlockResult result;
+            result.Color0 = color0;
+            result.Color1 = color1;
+            result.Error = 0.0f;
+            int paletteSize = threeColor ? 3 : 4;
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                uint32_t index = 0;
+                if (!opaque[i])
+                {
+                    index = 3;
+                    weights[i] = 0.0f;
+                }
+                else if (color0 != color1)
+                {
+                    float bestError = FLT_MAX;
+                    for (int p = 0; p < paletteSize; ++p)
+                    {
+                        float error = 0.0f;
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            float d = pixels[i][c] - (float)palette[p][c];
+                            error += d * d;
+                        }
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            index = p;
+                        }
+                    }
+                    result.Error += bestError;
+                    weights[i] = paletteWeights[index];
+                }
+                else
+                {
+                    for (int c = 0; c < 3; ++c)
+                    {
+                        float d = pixels[i][c] - (float)palette[0][c];
+                        result.Error += d * d;
+                    }
+                    weights[i] = 0.0f;
+                }
+                result.Indices |= index << (2 * i);
+            }
+            return result;
+        }
+
+        void EncodeColorBlock(const float (*pixels)[4], const bool *opaque, bool threeColor, uint8_t *out)
+        {
+            float endpoint0[4], endpoint1[4];
+            FitEndpoints(pixels, opaque, 3, endpoint0, endpoint1);
+
+            float weights[s_BlockPixels];
+            ColorBlockResult best =
+                    EvaluateColorBlock(pixels, opaque, PackRGB565(endpoint0), PackRGB565(endpoint1), threeColor, weights);
+
+            // 用选出的索引做两轮最小二乘修正，误差变小才采用
+            for (int iteration = 0; iteration < 2; ++iteration)
+            {
+                if (best.Color0 == best.Color1 ||
+                    !RefineEndpoints(pixels, opaque, weights, 3, endpoint0, endpoint1))
+                    break;
+
+                float refinedWeights[s_BlockPixels];
+                ColorBlockResult refined = EvaluateColorBlock(pixels, opaque, PackRGB565(endpoint0),
+                                                              PackRGB565(endpoint1), threeColor, refinedWeights);
+                if (refined.Error >= best.Error)
+                    break;
+                best = refined;
+                memcpy(weights, refinedWeights, sizeof(weights));
+            }
+
+            memcpy(out, &best.Color0, 2);
+            memcpy(out + 2, &best.Color1, 2);
+            memcpy(out + 4, &best.Indices, 4);
+        }
+
+        // ---- BC3 alpha ----
+
+        void EncodeAlphaBlock(const float (*pixels)[4], uint8_t *out)
+        {
+            int minAlpha = 255, maxAlpha = 0;
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                minAlpha = std::min(minAlpha, (int)pixels[i][3]);
+                maxAlpha = std::max(maxAlpha, (int)pixels[i][3]);
+            }
+
+            // alpha0 > alpha1 时为 8 级插值模式
+            out[0] = (uint8_t)maxAlpha;
+            out[1] = (uint8_t)minAlpha;
+            uint64_t indices = 0;
+            if (maxAlpha != minAlpha)
+            {
+                int palette[8];
+                palette[0] = maxAlpha;
+                palette[1] = minAlpha;
+                for (int i = 2; i < 8; ++i)
+                    palette[i] = ((8 - i) * maxAlpha + (i - 1) * minAlpha) / 7;
+
+                for (int i = 0; i < s_BlockPixels; ++i)
+                {
+                    int alpha = (int)pixels[i][3];
+                    uint64_t bestIndex = 0;
+                    int bestError = INT32_MAX;
+                    for (int p = 0; p < 8; ++p)
+                    {
+                        int error = std::abs(alpha - palette[p]);
+                        if (error < bestError)
+                        {
+                            bestError = error;
+                            bestIndex = (uint64_t)p;
+                        }
+                    }
+                    indices |= bestIndex << (3 * i);
+                }
+            }
+            for (int i = 0; i < 6; ++i)
+                out[2 + i] = (uint8_t)(indices >> (8 * i));
+        }
+
+        // ---- BC7 ----
+
+        // mode 5/6 的 2 位和 4 位索引插值权重
+        constexpr int s_BC7Weights2[4] = {0, 21, 43, 64};
+        constexpr int s_BC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+        class BitWriter {
+        public:
+            explicit BitWriter(uint8_t *out) : m_Out(out)
+            {
+                memset(m_Out, 0, 16);
+            }
+
+            void Write(uint32_t value, int bitCount)
+            {
+                for (int i = 0; i < bitCount; ++i, ++m_Position)
+                {
+                    if (value & (1u << i))
+                        m_Out[m_Position >> 3] |= (uint8_t)(1u << (m_Position & 7));
+                }
+            }
+
+        private:
+            uint8_t *m_Out;
+            int m_Position = 0;
+        };
+
+        // 在 [firstChannel, firstChannel + channelCount) 通道上为每个像素选最近的插值，返回平方误差之和
+        float SelectBC7Indices(const float (*pixels)[4], int firstChannel, int channelCount, const int *value0,
+                               const int *value1, const int *weightTable, int weightCount, uint8_t *indices,
+                               float *weights)
+        {
+            int palette[16][4];
+            for (int w = 0; w < weightCount; ++w)
+                for (int c = firstChannel; c < firstChannel + channelCount; ++c)
+                    palette[w][c] = ((64 - weightTable[w]) * value0[c] + weightTable[w] * value1[c] + 32) >> 6;
+
+            float totalError = 0.0f;
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                float bestError = FLT_MAX;
+                int bestIndex = 0;
+                for (int w = 0; w < weightCount; ++w)
+                {
+                    float error = 0.0f;
+                    for (int c = firstChannel; c < firstChannel + channelCount; ++c)
+                    {
+                        float d = pixels[i][c] - (float)palette[w][c];
+                        error += d * d;
+                    }
+                    if (error < bestError)
+                    {
+                        bestError = error;
+                        bestIndex = w;
+                    }
+                }
+                indices[i] = (uint8_t)bestIndex;
+                weights[i] = (float)weightTable[bestIndex] / 64.0f;
+                totalError += bestError;
+            }
+            return totalError;
+        }
+
+        // mode 6：RGBA 端点各 7 位 + 每端点 1 个共享 p 位，4 位索引。颜色和 alpha 相关时最好
+        struct BC7Mode6Endpoint {
+            int Quantized[4] = {};
+            int PBit = 0;
+            int Value[4] = {}; // 还原后的 8 位值
+        };
+
+        BC7Mode6Endpoint QuantizeMode6Endpoint(const float *color)
+        {
+            // p 位在 4 个通道间共享，两种取值都试一遍
+            BC7Mode6Endpoint best;
+            float bestError = FLT_MAX;
+            for (int p = 0; p < 2; ++p)
+            {
+                BC7Mode6Endpoint candidate;
+                candidate.PBit = p;
+                float error = 0.0f;
+                for (int c = 0; c < 4; ++c)
+                {
+                    int q = (int)std::lround((color[c] - (float)p) * 0.5f);
+                    q = std::min(127, std::max(0, q));
+                    candidate.Quantized[c] = q;
+                    candidate.Value[c] = (q << 1) | p;
+                    float d = (float)candidate.Value[c] - color[c];
+                    error += d * d;
+                }
+                if (error < bestError)
+                {
+                    bestError = error;
+                    best = candidate;
+                }
+            }
+            return best;
+        }
+
+        float EncodeBC7Mode6(const float (*pixels)[4], uint8_t *out)
+        {
+            bool all[s_BlockPixels];
+            std::fill(std::begin(all), std::end(all), true);
+
+            float color0[4], color1[4];
+            FitEndpoints(pixels, all, 4, color0, color1);
+
+            BC7Mode6Endpoint endpoint0 = QuantizeMode6Endpoint(color0);
+            BC7Mode6Endpoint endpoint1 = QuantizeMode6Endpoint(color1);
+            uint8_t indices[s_BlockPixels];
+            float weights[s_BlockPixels];
+            float error = SelectBC7Indices(pixels, 0, 4, endpoint0.Value, endpoint1.Value, s_BC7Weights4, 16, indices,
+                                           weights);
+
+            // 用选出的索引做两轮最小二乘修正，误差变小才采用
+            for (int iteration = 0; iteration < 2 && error > 0.0f; ++iteration)
+            {
+                if (!RefineEndpoints(pixels, all, weights, 4, color0, color1))
+                    break;
+
+                BC7Mode6Endpoint refined0 = QuantizeMode6Endpoint(color0);
+                BC7Mode6Endpoint refined1 = QuantizeMode6Endpoint(color1);
+                uint8_t refinedIndices[s_BlockPixels];
+                float refinedWeights[s_BlockPixels];
+                float refinedError = SelectBC7Indices(pixels, 0, 4, refined0.Value, refined1.Value, s_BC7Weights4, 16,
+                                                      refinedIndices, refinedWeights);
+                if (refinedError >= error)
+                    break;
+                error = refinedError;
+                endpoint0 = refined0;
+                endpoint1 = refined1;
+                memcpy(indices, refinedIndices, sizeof(indices));
+                memcpy(weights, refinedWeights, sizeof(weights));
+            }
+
+            // 第一个像素的索引（anchor）只存 3 位，最高位必须为 0，否则交换端点并反转索引
+            if (indices[0] & 8)
+            {
+                std::swap(endpoint0, endpoint1);
+                for (int i = 0; i < s_BlockPixels; ++i)
+                    indices[i] = (uint8_t)(15 - indices[i]);
+            }
+
+            BitWriter writer(out);
+            writer.Write(1u << 6, 7);
+            for (int c = 0; c < 4; ++c)
+            {
+                writer.Write((uint32_t)endpoint0.Quantized[c], 7);
+                writer.Write((uint32_t)endpoint1.Quantized[c], 7);
+            }
+            writer.Write((uint32_t)endpoint0.PBit, 1);
+            writer.Write((uint32_t)endpoint1.PBit, 1);
+            writer.Write(indices[0], 3);
+            for (int i = 1; i < s_BlockPixels; ++i)
+                writer.Write(indices[i], 4);
+            return error;
+        }
+
+        // mode 5（不旋转）：RGB 端点 7 位、alpha 端点 8 位，颜色和 alpha 各自 2 位索引。
+        // 精灵边缘这类 alpha 与颜色无关的块用它更好
+        struct BC7Mode5Endpoint {
+            int Quantized[4] = {}; // RGB 7 位，A 8 位
+            int Value[4] = {};
+        };
+
+        BC7Mode5Endpoint QuantizeMode5Endpoint(const float *color, float alpha)
+        {
+            BC7Mode5Endpoint endpoint;
+            for (int c = 0; c < 3; ++c)
+            {
+                int q = std::min(127, std::max(0, (int)std::lround(color[c] * 127.0f / 255.0f)));
+                endpoint.Quantized[c] = q;
+                endpoint.Value[c] = (q << 1) | (q >> 6);
+            }
+            endpoint.Quantized[3] = endpoint.Value[3] = std::min(255, std::max(0, (int)std::lround(alpha)));
+            return endpoint;
+        }
+
+        float EncodeBC7Mode5(const float (*pixels)[4], uint8_t *out)
+        {
+            bool all[s_BlockPixels];
+            std::fill(std::begin(all), std::end(all), true);
+
+            float color0[4], color1[4];
+            FitEndpoints(pixels, all, 3, color0, color1);
+            float alpha0 = 0.0f, alpha1 = 255.0f;
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                alpha0 = std::max(alpha0, pixels[i][3]);
+                alpha1 = std::min(alpha1, pixels[i][3]);
+            }
+
+            BC7Mode5Endpoint endpoint0 = QuantizeMode5Endpoint(color0, alpha0);
+            BC7Mode5Endpoint endpoint1 = QuantizeMode5Endpoint(color1, alpha1);
+            uint8_t colorIndices[s_BlockPixels], alphaIndices[s_BlockPixels];
+            float colorWeights[s_BlockPixels], alphaWeights[s_BlockPixels];
+            float colorError = SelectBC7Indices(pixels, 0, 3, endpoint0.Value, endpoint1.Value, s_BC7Weights2, 4,
+                                                colorIndices, colorWeights);
+            float alphaError = SelectBC7Indices(pixels, 3, 1, endpoint0.Value, endpoint1.Value, s_BC7Weights2, 4,
+                                                alphaIndices, alphaWeights);
+
+            for (int iteration = 0; iteration < 2 && colorError > 0.0f; ++iteration)
+            {
+                if (!RefineEndpoints(pixels, all, colorWeights, 3, color0, color1))
+                    break;
+
+                BC7Mode5Endpoint refined0 = QuantizeMode5Endpoint(color0, (float)endpoint0.Value[3]);
+                BC7Mode5Endpoint refined1 = QuantizeMode5Endpoint(color1, (float)endpoint1.Value[3]);
+                uint8_t refinedIndices[s_BlockPixels];
+                float refinedWeights[s_BlockPixels];
+                float refinedError = SelectBC7Indices(pixels, 0, 3, refined0.Value, refined1.Value, s_BC7Weights2, 4,
+                                                      refinedIndices, refinedWeights);
+                if (refinedError >= colorError)
+                    break;
+                colorError = refinedError;
+                endpoint0 = refined0;
+                endpoint1 = refined1;
+                memcpy(colorIndices, refinedIndices, sizeof(colorIndices));
+                memcpy(colorWeights, refinedWeights, sizeof(colorWeights));
+            }
+
+            // 颜色和 alpha 的 anchor 各自处理，交换时只交换对应的通道
+            if (colorIndices[0] & 2)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    std::swap(endpoint0.Quantized[c], endpoint1.Quantized[c]);
+                    std::swap(endpoint0.Value[c], endpoint1.Value[c]);
+                }
+                for (int i = 0; i < s_BlockPixels; ++i)
+                    colorIndices[i] = (uint8_t)(3 - colorIndices[i]);
+            }
+            if (alphaIndices[0] & 2)
+            {
+                std::swap(endpoint0.Quantized[3], endpoint1.Quantized[3]);
+                std::swap(endpoint0.Value[3], endpoint1.Value[3]);
+                for (int i = 0; i < s_BlockPixels; ++i)
+                    alphaIndices[i] = (uint8_t)(3 - alphaIndices[i]);
+            }
+
+            BitWriter writer(out);
+            writer.Write(1u << 5, 6);
+            writer.Write(0, 2); // rotation
+            for (int c = 0; c < 3; ++c)
+            {
+                writer.Write((uint32_t)endpoint0.Quantized[c], 7);
+                writer.Write((uint32_t)endpoint1.Quantized[c], 7);
+            }
+            writer.Write((uint32_t)endpoint0.Quantized[3], 8);
+            writer.Write((uint32_t)endpoint1.Quantized[3], 8);
+            writer.Write(colorIndices[0], 1);
+            for (int i = 1; i < s_BlockPixels; ++i)
+                writer.Write(colorIndices[i], 2);
+            writer.Write(alphaIndices[0], 1);
+            for (int i = 1; i < s_BlockPixels; ++i)
+                writer.Write(alphaIndices[i], 2);
+            return colorError + alphaError;
+        }
+    } // namespace
+
+    namespace BlockCompression
+    {
+        void EncodeBC1Block(const uint8_t *rgba, uint8_t *out)
+        {
+            float pixels[s_BlockPixels][4];
+            LoadBlock(rgba, pixels);
+
+            bool opaque[s_BlockPixels];
+            bool hasTransparent = false;
+            for (int i = 0; i < s_BlockPixels; ++i)
+            {
+                opaque[i] = rgba[i * 4 + 3] >= 128;
+                hasTransparent |= !opaque[i];
+            }
+            EncodeColorBlock(pixels, opaque, hasTransparent, out);
+        }
+
+        void EncodeBC3Block(const uint8_t *rgba, uint8_t *out)
+        {
+            float pixels[s_BlockPixels][4];
+            LoadBlock(rgba, pixels);
+            FillTransparentColors(pixels);
+
+            // BC3 的颜色块总是按 4 色模式解码
+            bool all[s_BlockPixels];
+            std::fill(std::begin(all), std::end(all), true);
+            EncodeAlphaBlock(pixels, out);
+            EncodeColorBlock(pixels, all, false, out + 8);
+        }
+
+        void EncodeBC7Block(const uint8_t *rgba, uint8_t *out)
+        {
+            float pixels[s_BlockPixels][4];
+            LoadBlock(rgba, pixels);
+            FillTransparentColors(pixels);
+
+            // 两种模式都编码一遍，取误差小的
+            uint8_t mode5[16];
+            float mode6Error = EncodeBC7Mode6(pixels, out);
+            if (mode6Error > 0.0f && EncodeBC7Mode5(pixels, mode5) < mode6Error)
+                memcpy(out, mode5, sizeof(mode5));
+        }
+
+        bool CompressImage(const uint8_t *rgba, uint32_t width, uint32_t height, ImageFormat format, uint8_t *out)
+        {
+            if (!rgba || !out || width == 0 || height == 0 || !IsBlockCompressed(format))
+                return false;
+
+            uint32_t blocksX = (width + 3) / 4;
+            uint32_t blocksY = (height + 3) / 4;
+            size_t blockSize = format == ImageFormat::BC1 ? 8 : 16;
+
+            uint8_t block[s_BlockPixels * 4];
+            for (uint32_t by = 0; by < blocksY; ++by)
+            {
+                for (uint32_t bx = 0; bx < blocksX; ++bx)
+                {
+                    for (uint32_t y = 0; y < 4; ++y)
+                    {
+                        uint32_t sourceY = std::min(by * 4 + y, height - 1);
+                        for (uint32_t x = 0; x < 4; ++x)
+                        {
+                            uint32_t sourceX = std::min(bx * 4 + x, width - 1);
+                            memcpy(block + (y * 4 + x) * 4, rgba + ((size_t)sourceY * width + sourceX) * 4, 4);
+                        }
+                    }
+
+                    uint8_t *destination = out + ((size_t)by * blocksX + bx) * blockSize;
+                    if (format == ImageFormat::BC1)
+                        EncodeBC1Block(block, destination);
+                    else if (format == ImageFormat::BC3)
+                        EncodeBC3Block(block, destination);
+                    else
+                        EncodeBC7Block(block, destination);
+                }
+            }
+            return true;
+        }
+    } // namespace BlockCompression
+} // namespace Himii
@@ -0,0 +1,23 @@
+#pragma once
+#include "Himii/Renderer/Texture.h"
+
+#include <cstdint>
+
+namespace Himii
+{
+    // 烘焙用的软件块压缩编码器（BC1 / BC3 / BC7），只在构建时运行，追求稳定而不是最高质量
+    namespace BlockCompression
+    {
+        // rgba 为 4x4 块的 RGBA8 像素（64 字节，按行排列）
+        // BC1：块内有 alpha < 128 的像素时使用 3 色 + 透明模式，输出 8 字节
+        void EncodeBC1Block(const uint8_t *rgba, uint8_t *out);
+        // 输出 16 字节
+        void EncodeBC3Block(const uint8_t *rgba, uint8_t *out);
+        // 只用单区块的 mode 6（RGBA 一条直线）和 mode 5（颜色、alpha 分开插值），按块取误差小的，输出 16 字节
+        void EncodeBC7Block(const uint8_t *rgba, uint8_t *out);
+
+        // 压缩整张 RGBA8 图像，尺寸不是 4 的倍数时边缘块重复最后一行/列；
+        // out 需要 GetImageSize(format, width, height) 字节
+        bool CompressImage(const uint8_t *rgba, uint32_t width, uint32_t height, ImageFormat format, uint8_t *out);
+    } // namespace BlockCompression
+} // namespace Himii
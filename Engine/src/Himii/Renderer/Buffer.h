@@ -97,6 +97,10 @@ namespace Himii
         {
             CalculateOffsetsAndStride();
         }
+        BufferLayout(std::vector<BufferElement> elements) : m_Elements(std::move(elements))
+        {
+            CalculateOffsetsAndStride();
+        }
 
         inline uint32_t GetStride() const
         {
@@ -0,0 +1,211 @@
+#include "Hepch.h"
+#include "Himii/Renderer/CookedTexture.h"
+#include "Himii/Renderer/BlockCompression.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace Himii
+{
+    namespace
+    {
+        constexpr uint32_t s_CookedTextureVersion = 1;
+        constexpr uint64_t s_MipAlignment = 16;
+
+        uint64_t AlignUp(uint64_t value, uint64_t alignment)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        // 2x2 盒式滤波，奇数尺寸时边缘重复最后一行/列
+        void Downsample(const uint8_t *src, uint32_t srcWidth, uint32_t srcHeight, uint32_t channels, uint8_t *dst,
+                        uint32_t dstWidth, uint32_t dstHeight)
+        {
+            for (uint32_t y = 0; y < dstHeight; ++y)
+            {
+                uint32_t y0 = std::min(y * 2, srcHeight - 1);
+                uint32_t y1 = std::min(y * 2 + 1, srcHeight - 1);
+                const uint8_t *row0 = src + (size_t)y0 * srcWidth * channels;
+                const uint8_t *row1 = src + (size_t)y1 * srcWidth * channels;
+                uint8_t *out = dst + (size_t)y * dstWidth * channels;
+                for (uint32_t x = 0; x < dstWidth; ++x)
+                {
+                    uint32_t x0 = std::min(x * 2, srcWidth - 1) * channels;
+                    uint32_t x1 = std::min(x * 2 + 1, srcWidth - 1) * channels;
+                    for (uint32_t c = 0; c < channels; ++c)
+                    {
+                        uint32_t sum = row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c];
+                        out[x * channels + c] = (uint8_t)((sum + 2) / 4);
+                    }
+                }
+            }
+        }
+    } // namespace
+
+    namespace CookedTexture
+    {
+        bool IsCookedTexture(const uint8_t *data, size_t size)
+        {
+            return data && size >= sizeof(CookedTextureHeader) && memcmp(data, "HTEX", 4) == 0;
+        }
+
+        bool Parse(const uint8_t *data, size_t size, CookedTextureView &out)
+        {
+            if (!IsCookedTexture(data, size))
+                return false;
+
+            CookedTextureHeader header;
+            memcpy(&header, data, sizeof(header));
+            if (header.Version != s_CookedTextureVersion || header.MipCount == 0 || header.MipCount > 32)
+                return false;
+
+            uint64_t mipTableEnd = sizeof(header) + (uint64_t)header.MipCount * sizeof(CookedTextureMip);
+            if (mipTableEnd > size)
+                return false;
+
+            out.Width = header.Width;
+            out.Height = header.Height;
+            out.Format = header.Format;
+            out.Levels.clear();
+            out.Levels.reserve(header.MipCount);
+
+            ImageFormat format = out.GetImageFormat();
+            if (format == ImageFormat::None)
+                return false;
+
+            for (uint32_t i = 0; i < header.MipCount; ++i)
+            {
+                CookedTextureMip mip;
+                memcpy(&mip, data + sizeof(header) + i * sizeof(CookedTextureMip), sizeof(mip));
+                if (mip.Offset + mip.Size > size || mip.Size != GetImageSize(format, mip.Width, mip.Height))
+                    return false;
+                out.Levels.push_back({data + mip.Offset, mip.Width, mip.Height, mip.Size});
+            }
+            return true;
+        }
+
+        uint64_t Write(const std::filesystem::path &filepath, const uint8_t *pixels, uint32_t width, uint32_t height,
+                       uint32_t channels, const CookedTextureWriteOptions &options, CookedTextureFormat *format)
+        {
+            HIMII_PROFILE_FUNCTION();
+
+            if (!pixels || width == 0 || height == 0 || (channels != 3 && channels != 4))
+                return 0;
+
+            size_t pixelCount = (size_t)width * height;
+            CookedTextureFormat targetFormat = channels == 4 ? CookedTextureFormat::RGBA8 : CookedTextureFormat::RGB8;
+            switch (options.Compression)
+            {
+                case TextureCompression::None:
+                    break;
+                case TextureCompression::Auto:
+                {
+                    bool opaque = true;
+                    for (size_t i = 0; channels == 4 && opaque && i < pixelCount; ++i)
+                        opaque = pixels[i * 4 + 3] == 255;
+                    targetFormat = opaque ? CookedTextureFormat::BC1 : CookedTextureFormat::BC7;
+                    break;
+                }
+                case TextureCompression::BC1: targetFormat = CookedTextureFormat::BC1; break;
+                case TextureCompression::BC3: targetFormat = CookedTextureFormat::BC3; break;
+                case TextureCompression::BC7: targetFormat = CookedTextureFormat::BC7; break;
+            }
+
+            // 块压缩的输入统一为 RGBA，mip 也在 RGBA 上生成
+            std::vector<uint8_t> expanded;
+            bool compress = targetFormat != CookedTextureFormat::RGB8 && targetFormat != CookedTextureFormat::RGBA8;
+            if (compress && channels == 3)
+            {
+                expanded.resize(pixelCount * 4);
+                for (size_t i = 0; i < pixelCount; ++i)
+                {
+                    memcpy(&expanded[i * 4], pixels + i * 3, 3);
+                    expanded[i * 4 + 3] = 255;
+                }
+                pixels = expanded.data();
+                channels = 4;
+            }
+
+            // 每级单独保存，下一级从上一级缩小
+            std::vector<std::vector<uint8_t>> levels;
+            std::vector<CookedTextureMip> mips;
+            levels.emplace_back(pixels, pixels + pixelCount * channels);
+            mips.push_back({width, height, 0, levels.back().size()});
+            while (options.GenerateMips && (mips.back().Width > 1 || mips.back().Height > 1))
+            {
+                const CookedTextureMip &previous = mips.back();
+                uint32_t mipWidth = std::max(1u, previous.Width / 2);
+                uint32_t mipHeight = std::max(1u, previous.Height / 2);
+                std::vector<uint8_t> level((size_t)mipWidth * mipHeight * channels);
+                Downsample(levels.back().data(), previous.Width, previous.Height, channels, level.data(), mipWidth,
+                           mipHeight);
+                levels.push_back(std::move(level));
+                mips.push_back({mipWidth, mipHeight, 0, levels.back().size()});
+            }
+
+            if (compress)
+            {
+                CookedTextureView view;
+                view.Format = targetFormat;
+                ImageFormat imageFormat = view.GetImageFormat();
+                for (size_t i = 0; i < levels.size(); ++i)
+                {
+                    std::vector<uint8_t> blocks(GetImageSize(imageFormat, mips[i].Width, mips[i].Height));
+                    BlockCompression::CompressImage(levels[i].data(), mips[i].Width, mips[i].Height, imageFormat,
+                                                    blocks.data());
+                    levels[i] = std::move(blocks);
+                    mips[i].Size = levels[i].size();
+                }
+            }
+
+            uint64_t offset = sizeof(CookedTextureHeader) + mips.size() * sizeof(CookedTextureMip);
+            uint64_t dataSize = 0;
+            for (auto &mip: mips)
+            {
+                offset = AlignUp(offset, s_MipAlignment);
+                mip.Offset = offset;
+                offset += mip.Size;
+                dataSize += mip.Size;
+            }
+
+            CookedTextureHeader header;
+            header.Version = s_CookedTextureVersion;
+            header.Width = width;
+            header.Height = height;
+            header.Format = targetFormat;
+            header.MipCount = (uint32_t)mips.size();
+            header.DataSize = dataSize;
+
+            std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+            if (!out)
+                return 0;
+
+            out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            out.write(reinterpret_cast<const char *>(mips.data()), (std::streamsize)(mips.size() * sizeof(CookedTextureMip)));
+            uint64_t written = sizeof(header) + mips.size() * sizeof(CookedTextureMip);
+            static const char zeros[s_MipAlignment] = {};
+            for (size_t i = 0; i < mips.size(); ++i)
+            {
+                out.write(zeros, (std::streamsize)(mips[i].Offset - written));
+                out.write(reinterpret_cast<const char *>(levels[i].data()), (std::streamsize)levels[i].size());
+                written = mips[i].Offset + mips[i].Size;
+            }
+            if (format)
+                *format = targetFormat;
+            return out ? written : 0;
+        }
+
+        const char *FormatToString(CookedTextureFormat format)
+        {
+            switch (format)
+            {
+                case CookedTextureFormat::RGB8: return "RGB8";
+                case CookedTextureFormat::RGBA8: return "RGBA8";
+                case CookedTextureFormat::BC1: return "BC1";
+                case CookedTextureFormat::BC3: return "BC3";
+                case CookedTextureFormat::BC7: return "BC7";
+                default: return "None";
+            }
+        }
+    } // namespace CookedTexture
+} // namespace Himii
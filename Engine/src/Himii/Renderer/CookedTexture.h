@@ -0,0 +1,96 @@
+#pragma once
+#include "Himii/Core/Core.h"
+#include "Himii/Renderer/Texture.h"
+
+#include <filesystem>
+#include <vector>
+
+namespace Himii
+{
+    // 烘焙后的纹理（.htex 内容，文件名保持源文件路径不变）：已按引擎约定上下翻转、紧密排列，
+    // 带完整 mip 链，可以是块压缩格式，加载时不再解码 PNG。布局：Header | Mip[MipCount] | 各级数据（16 字节对齐）
+    enum class CookedTextureFormat : uint32_t {
+        None = 0,
+        RGB8,
+        RGBA8,
+        BC1,
+        BC3,
+        BC7
+    };
+
+    // 烘焙时选择的压缩方式；Auto 对不透明纹理用 BC1，带 alpha 的用 BC7
+    enum class TextureCompression {
+        None = 0,
+        Auto,
+        BC1,
+        BC3,
+        BC7
+    };
+
+    struct CookedTextureWriteOptions {
+        bool GenerateMips = true;
+        TextureCompression Compression = TextureCompression::None;
+    };
+
+    struct CookedTextureHeader {
+        char Magic[4] = {'H', 'T', 'E', 'X'};
+        uint32_t Version = 0;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        CookedTextureFormat Format = CookedTextureFormat::None;
+        uint32_t MipCount = 0;
+        uint64_t DataSize = 0; // 所有 mip 数据的总字节数
+    };
+    static_assert(sizeof(CookedTextureHeader) == 32, "CookedTextureHeader layout changed, bump the version");
+
+    struct CookedTextureMip {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint64_t Offset = 0; // 相对文件开头
+        uint64_t Size = 0;
+    };
+    static_assert(sizeof(CookedTextureMip) == 24, "CookedTextureMip layout changed, bump the version");
+
+    struct CookedTextureLevel {
+        const uint8_t *Data = nullptr;
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        uint64_t Size = 0;
+    };
+
+    // 解析结果指向传入的内存，不复制像素
+    struct CookedTextureView {
+        uint32_t Width = 0;
+        uint32_t Height = 0;
+        CookedTextureFormat Format = CookedTextureFormat::None;
+        std::vector<CookedTextureLevel> Levels;
+
+        ImageFormat GetImageFormat() const
+        {
+            switch (Format)
+            {
+                case CookedTextureFormat::RGB8: return ImageFormat::RGB8;
+                case CookedTextureFormat::RGBA8: return ImageFormat::RGBA8;
+                case CookedTextureFormat::BC1: return ImageFormat::BC1;
+                case CookedTextureFormat::BC3: return ImageFormat::BC3;
+                case CookedTextureFormat::BC7: return ImageFormat::BC7;
+                default: return ImageFormat::None;
+            }
+        }
+    };
+
+    namespace CookedTexture
+    {
+        bool IsCookedTexture(const uint8_t *data, size_t size);
+        // 校验所有 mip 的边界，失败返回 false
+        bool Parse(const uint8_t *data, size_t size, CookedTextureView &out);
+
+        // pixels 为已翻转的 RGB8/RGBA8 像素；GenerateMips 时用 2x2 盒式滤波生成到 1x1，压缩在生成 mip 之后逐级进行。
+        // 返回写入的字节数，失败返回 0；format 非空时返回实际使用的格式
+        uint64_t Write(const std::filesystem::path &filepath, const uint8_t *pixels, uint32_t width, uint32_t height,
+                       uint32_t channels, const CookedTextureWriteOptions &options,
+                       CookedTextureFormat *format = nullptr);
+
+        const char *FormatToString(CookedTextureFormat format);
+    } // namespace CookedTexture
+} // namespace Himii
@@ -38,6 +38,13 @@ namespace Himii
         std::vector<FramebufferTextureSpecification> Attachments;
     };
 
+    // 异步拾取的结果：X/Y 是发起请求时的像素坐标，结果通常比请求晚 1~2 帧
+    struct FramebufferPickResult {
+        int Value = -1;
+        int X = 0;
+        int Y = 0;
+    };
+
     struct FramebufferSpecification
     {
         uint32_t Width = 0;
@@ -46,9 +53,23 @@ namespace Himii
         FramebufferAttachmentSpecification Attachments;
         uint32_t Samples = 1;
 
+        // 大于 0 时附件按该粒度向上取整分配，Width/Height 只是其中左下角的可见区域，
+        // 尺寸在同一档内变化时只调整 viewport / scissor，不重新分配附件
+        uint32_t ResizeGranularity = 0;
+
         bool SwapChainTarget = false;
     };
 
+    struct FramebufferStats {
+        uint32_t AllocatedWidth = 0;
+        uint32_t AllocatedHeight = 0;
+        uint32_t ReallocationCount = 0; // 附件重新分配的次数（不含首次创建）
+
+        // 可见区域在附件纹理中的 UV 范围，采样或显示附件时用
+        float GetUVScaleX(uint32_t width) const { return AllocatedWidth ? (float)width / AllocatedWidth : 1.0f; }
+        float GetUVScaleY(uint32_t height) const { return AllocatedHeight ? (float)height / AllocatedHeight : 1.0f; }
+    };
+
     class Framebuffer {
     public:
         virtual ~Framebuffer() = default;
@@ -57,13 +78,20 @@ namespace Himii
         virtual void Unbind() = 0;
 
         virtual void Resize(uint32_t width, uint32_t height) = 0;
+        // 同步读取，会等待 GPU 画完当前帧；每帧拾取请用 RequestPick / PollPick
         virtual int ReadPixel(uint32_t attachmentIndex, int x ,int y) = 0;
 
+        // 把整数附件中 (x, y) 处的像素复制到读回缓冲，不等待 GPU
+        virtual void RequestPick(uint32_t attachmentIndex, int x, int y) = 0;
+        // 取最新一个 GPU 已完成的请求结果，没有新结果时返回 false（不阻塞）
+        virtual bool PollPick(FramebufferPickResult &result) = 0;
+
         virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
 
         virtual uint32_t GetColorAttachmentRendererID(uint32_t index=0) const = 0; 
 
         virtual const FramebufferSpecification &GetSpecification() const = 0;
+        virtual const FramebufferStats &GetStats() const = 0;
 
         static Ref<Framebuffer> Create(const FramebufferSpecification &spec);
     };
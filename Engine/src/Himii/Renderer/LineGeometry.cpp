@@ -0,0 +1,113 @@
+#include "Hepch.h"
+#include "Himii/Renderer/LineGeometry.h"
+#include "Himii/Renderer/Buffer.h"
+
+namespace Himii
+{
+    void LineGeometry::Clear()
+    {
+        m_Vertices.clear();
+    }
+
+    void LineGeometry::AddSegment(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &previous,
+                                  const glm::vec3 &next, const glm::vec4 &color, float width)
+    {
+        // 顺序与索引 0 1 2 2 3 0 对应：起点、终点在法线负侧，终点、起点在正侧
+        m_Vertices.push_back({p0, p1, previous, color, {0.0f, -1.0f}, width});
+        m_Vertices.push_back({p1, p0, next, color, {1.0f, -1.0f}, width});
+        m_Vertices.push_back({p1, p0, next, color, {1.0f, 1.0f}, width});
+        m_Vertices.push_back({p0, p1, previous, color, {0.0f, 1.0f}, width});
+    }
+
+    void LineGeometry::AddLine(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec4 &color, float width)
+    {
+        AddSegment(p0, p1, p0, p1, color, width);
+    }
+
+    void LineGeometry::AddPolyline(const glm::vec3 *points, uint32_t count, const glm::vec4 &color, bool closed,
+                                   float width)
+    {
+        if (!points || count < 2)
+            return;
+
+        closed = closed && count > 2;
+        const uint32_t segmentCount = closed ? count : count - 1;
+        for (uint32_t s = 0; s < segmentCount; s++)
+        {
+            const glm::vec3 &p0 = points[s];
+            const glm::vec3 &p1 = points[(s + 1) % count];
+            // 开放折线的两端没有相邻线段，相邻点取端点自身
+            const glm::vec3 &previous = (closed || s > 0) ? points[(s + count - 1) % count] : p0;
+            const glm::vec3 &next = (closed || s + 2 < count) ? points[(s + 2) % count] : p1;
+            AddSegment(p0, p1, previous, next, color, width);
+        }
+    }
+
+    void LineGeometry::AddRect(const glm::mat4 &transform, const glm::vec4 &color, float width)
+    {
+        static const glm::vec4 s_Corners[4] = {
+                {-0.5f, -0.5f, 0.0f, 1.0f}, {0.5f, -0.5f, 0.0f, 1.0f}, {0.5f, 0.5f, 0.0f, 1.0f}, {-0.5f, 0.5f, 0.0f, 1.0f}};
+
+        glm::vec3 corners[4];
+        for (int i = 0; i < 4; i++)
+            corners[i] = transform * s_Corners[i];
+
+        AddPolyline(corners, 4, color, true, width);
+    }
+
+    void LineGeometry::AddCircle(const glm::mat4 &transform, const glm::vec4 &color, uint32_t segments, float width)
+    {
+        segments = std::max(segments, 3u);
+
+        static std::vector<glm::vec3> points;
+        points.resize(segments);
+        for (uint32_t i = 0; i < segments; i++)
+        {
+            float angle = glm::radians(360.0f * (float)i / (float)segments);
+            points[i] = transform * glm::vec4(0.5f * std::cos(angle), 0.5f * std::sin(angle), 0.0f, 1.0f);
+        }
+
+        AddPolyline(points.data(), segments, color, true, width);
+    }
+
+    void LineGeometry::Upload()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        uint32_t segmentCount = (uint32_t)m_Vertices.size() / 4;
+        if (segmentCount > m_SegmentCapacity)
+        {
+            // 按 2 倍扩容，避免逐个添加碰撞体时每次都重建缓冲
+            m_SegmentCapacity = std::max(segmentCount, m_SegmentCapacity * 2);
+            m_VertexBuffer = VertexBuffer::Create(m_SegmentCapacity * 4 * (uint32_t)sizeof(Vertex));
+            m_VertexBuffer->SetLayout({{ShaderDataType::Float3, "a_Position"},
+                                       {ShaderDataType::Float3, "a_OtherPosition"},
+                                       {ShaderDataType::Float3, "a_NeighborPosition"},
+                                       {ShaderDataType::Float4, "a_Color"},
+                                       {ShaderDataType::Float2, "a_Corner"},
+                                       {ShaderDataType::Float, "a_Width"}});
+
+            // 索引只取决于容量，扩容时一并生成
+            std::vector<uint32_t> indices(m_SegmentCapacity * 6);
+            for (uint32_t s = 0; s < m_SegmentCapacity; s++)
+            {
+                uint32_t base = s * 4;
+                uint32_t *index = &indices[s * 6];
+                index[0] = base + 0;
+                index[1] = base + 1;
+                index[2] = base + 2;
+                index[3] = base + 2;
+                index[4] = base + 3;
+                index[5] = base + 0;
+            }
+
+            m_VertexArray = VertexArray::Create();
+            m_VertexArray->AddVertexBuffer(m_VertexBuffer);
+            m_VertexArray->SetIndexBuffer(IndexBuffer::Create(indices.data(), (uint32_t)indices.size()));
+        }
+
+        if (segmentCount)
+            m_VertexBuffer->SetData(m_Vertices.data(), (uint32_t)(m_Vertices.size() * sizeof(Vertex)));
+        m_UploadedIndexCount = segmentCount * 6;
+    }
+} // namespace Himii
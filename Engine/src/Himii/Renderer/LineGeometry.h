@@ -0,0 +1,62 @@
+#pragma once
+#include "Himii/Core/Core.h"
+#include "Himii/Renderer/VertexArray.h"
+
+#include "glm/glm.hpp"
+
+#include <vector>
+
+namespace Himii
+{
+    // 保留模式的折线集合：顶点在 CPU 端组装后一次上传，之后每帧由 Renderer2D::DrawLineGeometry 一次绘制，
+    // 适合编辑器里很少变化的线框（碰撞体、选中框等）。每段线是一个四边形，屏幕空间的展开（像素线宽、
+    // 拐角斜接）在顶点着色器 Renderer2D_Line.glsl 中完成，相机移动不需要重新上传
+    class LineGeometry {
+    public:
+        void Clear();
+
+        // width 以像素计，<= 0 时使用绘制时 Renderer2D::SetLineWidth 的默认线宽
+        void AddLine(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec4 &color, float width = 0.0f);
+        // 折线，相邻线段斜接；closed 时首尾相连
+        void AddPolyline(const glm::vec3 *points, uint32_t count, const glm::vec4 &color, bool closed = false,
+                         float width = 0.0f);
+        // 与 Renderer2D::DrawRect 相同，变换作用在中心为原点的单位正方形上
+        void AddRect(const glm::mat4 &transform, const glm::vec4 &color, float width = 0.0f);
+        // 单位正方形的内切圆（半径 0.5），用 segments 段闭合折线近似
+        void AddCircle(const glm::mat4 &transform, const glm::vec4 &color, uint32_t segments = 32,
+                       float width = 0.0f);
+
+        // 上传当前顶点，容量不够时重建缓冲；内容变化后调用一次
+        void Upload();
+
+        uint32_t GetIndexCount() const
+        {
+            return m_UploadedIndexCount;
+        }
+        const Ref<VertexArray> &GetVertexArray() const
+        {
+            return m_VertexArray;
+        }
+
+    private:
+        void AddSegment(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &previous, const glm::vec3 &next,
+                        const glm::vec4 &color, float width);
+
+    private:
+        struct Vertex {
+            glm::vec3 Position;
+            glm::vec3 OtherPosition;
+            glm::vec3 NeighborPosition;
+            glm::vec4 Color;
+            glm::vec2 Corner;
+            float Width;
+        };
+
+        std::vector<Vertex> m_Vertices;
+
+        Ref<VertexArray> m_VertexArray;
+        Ref<VertexBuffer> m_VertexBuffer;
+        uint32_t m_SegmentCapacity = 0;
+        uint32_t m_UploadedIndexCount = 0;
+    };
+} // namespace Himii
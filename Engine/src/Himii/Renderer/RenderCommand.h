@@ -15,6 +15,10 @@ namespace Himii
         {
             s_RendererAPI->SetViewport(x, y, width, height);
         }
+        inline static void GetViewport(uint32_t &x, uint32_t &y, uint32_t &width, uint32_t &height)
+        {
+            s_RendererAPI->GetViewport(x, y, width, height);
+        }
 
         inline static void SetClearColor(const glm::vec4& color)
         {
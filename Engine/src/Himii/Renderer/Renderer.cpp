@@ -7,12 +7,14 @@ namespace Himii
 {
     Scope<Renderer::SceneData> Renderer::m_SceneData = CreateScope<Renderer::SceneData>();
 
-    void Renderer::Init()
+    void Renderer::Init(const Renderer2DSpecification &renderer2DSpecification)
     {
         HIMII_PROFILE_FUNCTION();
 
         RenderCommand::Init();
-        Renderer2D::Init();
+        Renderer2D::Init(renderer2DSpecification);
+
+        m_SceneData->ObjectUniformBuffer = UniformBuffer::Create(sizeof(ObjectData), 1);
     }
 
     void Renderer::OnWindowResize(uint32_t width, uint32_t height)
@@ -31,11 +33,16 @@ namespace Himii
     void Renderer::EndScene()
     {
     }
-    void Renderer::Submit(const Ref<Shader> &shader, const Ref<VertexArray> &vertexArray,const glm::mat4& transform)
+    void Renderer::Submit(const Ref<Shader> &shader, const Ref<VertexArray> &vertexArray,const glm::mat4& transform,
+                          const glm::vec4 &color)
     {
+        ObjectData &object = m_SceneData->ObjectBuffer;
+        object.ViewProjection = m_SceneData->ViewProjectionMatrix;
+        object.Transform = transform;
+        object.Color = color;
+        m_SceneData->ObjectUniformBuffer->SetData(&object, sizeof(ObjectData));
+
         shader->Bind();
-        shader->SetMat4("u_ViewProjection", m_SceneData->ViewProjectionMatrix);
-        shader->SetMat4("u_Transform", transform);
 
         vertexArray->Bind();
         RenderCommand::DrawIndexed(vertexArray);
@@ -1,14 +1,16 @@
 #pragma once
 #include "Himii/Renderer/RenderCommand.h"
 #include "Himii/Renderer/OrthographicCamera.h"
+#include "Himii/Renderer/Renderer2D.h"
 #include "Himii/Renderer/Shader.h"
+#include "Himii/Renderer/UniformBuffer.h"
 
 namespace Himii
 {
     class Renderer
     {
     public:
-        static void Init();
+        static void Init(const Renderer2DSpecification &renderer2DSpecification = {});
         static void OnWindowResize(uint32_t width, uint32_t height);
 
         static void BeginScene(OrthographicCamera& camera);
@@ -16,7 +18,9 @@ namespace Himii
     static void BeginScene(const glm::mat4& viewProjection);
         static void EndScene();
 
-        static void Submit(const Ref<Shader> &shader, const Ref<VertexArray> &vertexArray,const glm::mat4& transform=glm::mat4(1.0f));
+        // 逐次绘制的参数写入 Object uniform block（std140，binding = 1），不再按名称设置 uniform
+        static void Submit(const Ref<Shader> &shader, const Ref<VertexArray> &vertexArray,const glm::mat4& transform=glm::mat4(1.0f),
+                           const glm::vec4 &color = glm::vec4(1.0f));
 
         inline static RendererAPI::API GetAPI()
         {
@@ -24,9 +28,19 @@ namespace Himii
         }
 
     private:
+        // 与着色器中的 Object 块一一对应（std140）
+        struct ObjectData {
+            glm::mat4 ViewProjection;
+            glm::mat4 Transform;
+            glm::vec4 Color;
+        };
+
         struct SceneData 
         {
             glm::mat4 ViewProjectionMatrix;
+
+            ObjectData ObjectBuffer;
+            Ref<UniformBuffer> ObjectUniformBuffer;
         };
 
         static Scope<SceneData> m_SceneData;
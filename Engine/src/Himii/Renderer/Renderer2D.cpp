@@ -12,6 +12,7 @@
 namespace Himii
 {
 
+    // 完整布局；精简变体去掉可选字段（平铺系数、实体 ID）后其余字段前移，CPU 端缓冲按完整大小分配
     struct QuadVertex {
         glm::vec3 Position;
         glm::vec4 Color;
@@ -33,13 +34,6 @@ namespace Himii
         int EntityID;
     };
 
-    struct LineVertex {
-        glm::vec3 Position;
-        glm::vec4 Color;
-
-        int EntityID;
-    };
-
     struct Renderer2DData {
         static const uint32_t MaxQuads = 20000;
         static const uint32_t MaxVertices = MaxQuads * 4;
@@ -55,23 +49,28 @@ namespace Himii
         Ref<VertexBuffer> CircleVertexBuffer;
         Ref<Shader> CircleShader;
 
-        Ref<VertexArray> LineVertexArray;
-        Ref<VertexBuffer> LineVertexBuffer;
-        Ref<Shader> LineShader;
+        Renderer2DSpecification Specification;
+        uint32_t TextureSlotCount = MaxTextureSlots;
+
+        // 当前变体的顶点步长；可选字段的偏移为 0 表示布局中没有这一项
+        uint32_t QuadVertexStride = sizeof(QuadVertex);
+        uint32_t QuadTilingOffset = offsetof(QuadVertex, TilingFactor);
+        uint32_t QuadEntityIDOffset = offsetof(QuadVertex, EntityID);
+        uint32_t CircleVertexStride = sizeof(CircleVertex);
 
         uint32_t QuadIndexCount = 0;
-        QuadVertex *QuadVertexBufferBase = nullptr;
-        QuadVertex *QuadVertexBufferPtr = nullptr;
+        uint8_t *QuadVertexBufferBase = nullptr;
+        uint8_t *QuadVertexBufferPtr = nullptr;
 
         uint32_t CircleIndexCount = 0;
-        CircleVertex *CircleVertexBufferBase = nullptr;
-        CircleVertex *CircleVertexBufferPtr = nullptr;
+        uint8_t *CircleVertexBufferBase = nullptr;
+        uint8_t *CircleVertexBufferPtr = nullptr;
 
-        uint32_t LineVertexCount = 0;
-        LineVertex *LineVertexBufferBase = nullptr;
-        LineVertex *LineVertexBufferPtr = nullptr;
+        float LineWidth = 2.0f; // 像素
 
-        float LineWidth = 2.0f;
+        // 线段在屏幕空间展开时用，BeginScene 时更新
+        glm::mat4 InverseViewProjection = glm::mat4(1.0f);
+        glm::vec2 ViewportSize = {1.0f, 1.0f};
 
         std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
         uint32_t TextureSlotIndex = 1;
@@ -81,11 +80,31 @@ namespace Himii
 
         Renderer2D::Statistics Stats;
 
+        // 与各着色器的 Camera 块对应（std140）；视口尺寸和默认线宽只有 Renderer2D_Line.glsl 使用
         struct CameraData {
             glm::mat4 ViewProjection;
+            glm::vec2 ViewportSize;
+            float LineWidth;
+            float Padding;
         };
         CameraData CameraBuffer;
         Ref<UniformBuffer> CameraUniformBuffer;
+
+        // 网格（首次 DrawGrid 时创建），与 Renderer2D_Grid.glsl 的 Grid 块对应（std140）
+        struct GridData {
+            glm::mat4 InverseViewProjection;
+            glm::vec4 Color;
+            glm::vec4 MajorColor;
+            float Spacing;
+            float MajorInterval;
+            float Padding[2];
+        };
+        Ref<Shader> GridShader;
+        Ref<VertexArray> GridVertexArray;
+        Ref<UniformBuffer> GridUniformBuffer;
+
+        // LineGeometry 的着色器，首次 DrawLineGeometry 时加载
+        Ref<Shader> LineShader;
     };
 
     static Renderer2DData s_Data;
@@ -93,28 +112,142 @@ namespace Himii
     // 计算当前批次是否需要换批（由调用者在类方法内触发 NextBatch）
     static inline bool NeedsNewBatch(uint32_t verticesNeeded, uint32_t indicesNeeded)
     {
-        const uint32_t usedVertices = (uint32_t)(s_Data.QuadVertexBufferPtr - s_Data.QuadVertexBufferBase);
+        const uint32_t usedVertices =
+                (uint32_t)(s_Data.QuadVertexBufferPtr - s_Data.QuadVertexBufferBase) / s_Data.QuadVertexStride;
         return (usedVertices + verticesNeeded > Renderer2DData::MaxVertices) ||
                (s_Data.QuadIndexCount + indicesNeeded > Renderer2DData::MaxIndices);
     }
 
-    void Renderer2D::Init()
+    // 按当前布局写一个四边形顶点；没有平铺属性时把平铺系数直接乘进 UV（与着色器中相乘等价）
+    static inline void WriteQuadVertex(const glm::vec3 &position, const glm::vec4 &color, const glm::vec2 &texCoord,
+                                       float texIndex, float tilingFactor, int entityID)
+    {
+        QuadVertex *vertex = reinterpret_cast<QuadVertex *>(s_Data.QuadVertexBufferPtr);
+        vertex->Position = position;
+        vertex->Color = color;
+        vertex->TexIndex = texIndex;
+        if (s_Data.QuadTilingOffset)
+        {
+            vertex->TexCoord = texCoord;
+            vertex->TilingFactor = tilingFactor;
+        }
+        else
+            vertex->TexCoord = texCoord * tilingFactor;
+
+        if (s_Data.QuadEntityIDOffset)
+            memcpy(s_Data.QuadVertexBufferPtr + s_Data.QuadEntityIDOffset, &entityID, sizeof(int));
+        s_Data.QuadVertexBufferPtr += s_Data.QuadVertexStride;
+    }
+
+    // 写入相机 uniform block，并记录线段在屏幕空间展开所需的反投影矩阵和视口尺寸
+    static void SetSceneCamera(const glm::mat4 &viewProjection)
+    {
+        s_Data.InverseViewProjection = glm::inverse(viewProjection);
+        uint32_t x, y, width, height;
+        RenderCommand::GetViewport(x, y, width, height);
+        s_Data.ViewportSize = {(float)std::max(width, 1u), (float)std::max(height, 1u)};
+
+        s_Data.CameraBuffer.ViewProjection = viewProjection;
+        s_Data.CameraBuffer.ViewportSize = s_Data.ViewportSize;
+        s_Data.CameraBuffer.LineWidth = s_Data.LineWidth;
+        s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(Renderer2DData::CameraData));
+    }
+
+    // 线段端点的裁剪坐标和以视口中心为原点的像素坐标
+    struct LineScreenPoint {
+        glm::vec4 Clip;
+        glm::vec2 Pixel;
+    };
+
+    static inline bool ProjectLinePoint(const glm::vec3 &position, LineScreenPoint &out)
+    {
+        out.Clip = s_Data.CameraBuffer.ViewProjection * glm::vec4(position, 1.0f);
+        if (out.Clip.w <= 1e-6f) // 在相机后面
+            return false;
+        out.Pixel = glm::vec2(out.Clip) / out.Clip.w * 0.5f * s_Data.ViewportSize;
+        return true;
+    }
+
+    // 屏幕上偏移若干像素、深度不变的世界坐标
+    static inline glm::vec3 OffsetLinePoint(const LineScreenPoint &point, const glm::vec2 &pixelOffset)
+    {
+        glm::vec2 ndcOffset = pixelOffset * 2.0f / s_Data.ViewportSize * point.Clip.w;
+        glm::vec4 world = s_Data.InverseViewProjection * (point.Clip + glm::vec4(ndcOffset, 0.0f, 0.0f));
+        return glm::vec3(world) / world.w;
+    }
+
+    // 像素空间中线段 ab 的单位法线，长度为 0 时返回 false
+    static inline bool LineNormal(const LineScreenPoint &a, const LineScreenPoint &b, glm::vec2 &normal)
+    {
+        glm::vec2 direction = b.Pixel - a.Pixel;
+        float length = glm::length(direction);
+        if (length < 1e-4f)
+            return false;
+        normal = glm::vec2(-direction.y, direction.x) / length;
+        return true;
+    }
+
+    // 一段线写成四边形批次里的一个白色四边形，offsetA / offsetB 是两端沿法线方向的像素偏移（含半个线宽）
+    static inline void WriteLineQuad(const LineScreenPoint &a, const LineScreenPoint &b, const glm::vec2 &offsetA,
+                                     const glm::vec2 &offsetB, const glm::vec4 &color, int entityID)
+    {
+        WriteQuadVertex(OffsetLinePoint(a, -offsetA), color, {0.0f, 0.0f}, 0.0f, 1.0f, entityID);
+        WriteQuadVertex(OffsetLinePoint(b, -offsetB), color, {1.0f, 0.0f}, 0.0f, 1.0f, entityID);
+        WriteQuadVertex(OffsetLinePoint(b, offsetB), color, {1.0f, 1.0f}, 0.0f, 1.0f, entityID);
+        WriteQuadVertex(OffsetLinePoint(a, offsetA), color, {0.0f, 1.0f}, 0.0f, 1.0f, entityID);
+
+        s_Data.QuadIndexCount += 6;
+        s_Data.Stats.QuadCount++;
+    }
+
+    void Renderer2D::Init(const Renderer2DSpecification &specification)
     {
         HIMII_PROFILE_FUNCTION();
 
+        s_Data.Specification = specification;
+        s_Data.TextureSlotCount = specification.TextureSlots <= 16 ? 16 : Renderer2DData::MaxTextureSlots;
+        const bool entityIDs = specification.EntityIDs;
+
+        // 与着色器 #pragma variant 声明的关键字对应
+        std::vector<std::string> shaderKeywords;
+        if (!entityIDs)
+            shaderKeywords.push_back("NO_ENTITY_ID");
+        if (!specification.TilingAttribute)
+            shaderKeywords.push_back("NO_TILING");
+        if (s_Data.TextureSlotCount == 16)
+            shaderKeywords.push_back("TEXTURE_SLOTS_16");
+
         //Quad
+        std::vector<BufferElement> quadElements = {{ShaderDataType::Float3, "a_Position"},
+                                                   {ShaderDataType::Float4, "a_Color"},
+                                                   {ShaderDataType::Float2, "a_TexCoord"},
+                                                   {ShaderDataType::Float, "a_TexIndex"}};
+        s_Data.QuadTilingOffset = 0;
+        s_Data.QuadEntityIDOffset = 0;
+        uint32_t quadStride = offsetof(QuadVertex, TilingFactor);
+        if (specification.TilingAttribute)
+        {
+            quadElements.push_back({ShaderDataType::Float, "a_TilingFactor"});
+            s_Data.QuadTilingOffset = quadStride;
+            quadStride += sizeof(float);
+        }
+        if (entityIDs)
+        {
+            quadElements.push_back({ShaderDataType::Int, "a_EntityID"});
+            s_Data.QuadEntityIDOffset = quadStride;
+            quadStride += sizeof(int);
+        }
+        s_Data.QuadVertexStride = quadStride;
+
+        BufferLayout quadLayout(quadElements);
+        HIMII_CORE_ASSERT(quadLayout.GetStride() == quadStride, "Quad vertex layout mismatch!");
+
         s_Data.QuadVertexArray = VertexArray::Create();
-        s_Data.QuadVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(QuadVertex));
-
-        s_Data.QuadVertexBuffer->SetLayout({{ShaderDataType::Float3, "a_Position"},
-                                            {ShaderDataType::Float4, "a_Color"},
-                                            {ShaderDataType::Float2, "a_TexCoord"},
-                                            {ShaderDataType::Float, "a_TexIndex"},
-                                            {ShaderDataType::Float, "a_TilingFactor"},
-                                            {ShaderDataType::Int, "a_EntityID"}});
+        s_Data.QuadVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * quadStride);
+        s_Data.QuadVertexBuffer->SetLayout(quadLayout);
         s_Data.QuadVertexArray->AddVertexBuffer(s_Data.QuadVertexBuffer);
         
-        s_Data.QuadVertexBufferBase = new QuadVertex[s_Data.MaxVertices];
+        s_Data.QuadVertexBufferBase = new uint8_t[s_Data.MaxVertices * sizeof(QuadVertex)];
 
         uint32_t *quadIndices = new uint32_t[s_Data.MaxIndices];
         
@@ -136,29 +269,22 @@ namespace Himii
         s_Data.QuadVertexArray->SetIndexBuffer(quadIB);
         delete[] quadIndices;
 
-        //Circle
+        //Circle（实体 ID 是最后一项，去掉时只缩短步长）
+        std::vector<BufferElement> circleElements = {{ShaderDataType::Float3, "a_WorldPosition"},
+                                                     {ShaderDataType::Float3, "a_LocalPosition"},
+                                                     {ShaderDataType::Float4, "a_Color"},
+                                                     {ShaderDataType::Float, "a_Thickness"},
+                                                     {ShaderDataType::Float, "a_Fade"}};
+        if (entityIDs)
+            circleElements.push_back({ShaderDataType::Int, "a_EntityID"});
+        s_Data.CircleVertexStride = entityIDs ? sizeof(CircleVertex) : offsetof(CircleVertex, EntityID);
+
         s_Data.CircleVertexArray = VertexArray::Create();
-        s_Data.CircleVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(CircleVertex));
-
-        s_Data.CircleVertexBuffer->SetLayout({{ShaderDataType::Float3, "a_WorldPosition"},
-                                              {ShaderDataType::Float3, "a_LocalPosition"},
-                                            {ShaderDataType::Float4, "a_Color"},
-                                            {ShaderDataType::Float, "a_Thickness"},
-                                            {ShaderDataType::Float, "a_Fade"},
-                                            {ShaderDataType::Int, "a_EntityID"}});
+        s_Data.CircleVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * s_Data.CircleVertexStride);
+        s_Data.CircleVertexBuffer->SetLayout(BufferLayout(circleElements));
         s_Data.CircleVertexArray->AddVertexBuffer(s_Data.CircleVertexBuffer);
         s_Data.CircleVertexArray->SetIndexBuffer(quadIB);
-        s_Data.CircleVertexBufferBase = new CircleVertex[s_Data.MaxVertices];
-
-        // Line
-        s_Data.LineVertexArray = VertexArray::Create();
-        s_Data.LineVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(LineVertex));
-
-        s_Data.LineVertexBuffer->SetLayout({{ShaderDataType::Float3, "a_Position"},
-                                            {ShaderDataType::Float4, "a_Color"},
-                                            {ShaderDataType::Int, "a_EntityID"}});
-        s_Data.LineVertexArray->AddVertexBuffer(s_Data.LineVertexBuffer);
-        s_Data.LineVertexBufferBase = new LineVertex[s_Data.MaxVertices];
+        s_Data.CircleVertexBufferBase = new uint8_t[s_Data.MaxVertices * sizeof(CircleVertex)];
 
 
         s_Data.WhiteTexture = Texture2D::Create(1, 1);
@@ -170,9 +296,11 @@ namespace Himii
             samplers[i] = i;
 
         //  锟斤拷锟斤拷锟斤拷色锟斤拷锟斤拷锟斤拷
-        s_Data.QuadShader = Shader::Create("assets/shaders/Renderer2D_Quad.glsl");
-        s_Data.CircleShader = Shader::Create("assets/shaders/Renderer2D_Circle.glsl");
-        s_Data.LineShader = Shader::Create("assets/shaders/Renderer2D_Line.glsl");
+        auto shaders = Shader::CreateBatch({"assets/shaders/Renderer2D_Quad.glsl",
+                                            "assets/shaders/Renderer2D_Circle.glsl"},
+                                           shaderKeywords);
+        s_Data.QuadShader = shaders[0];
+        s_Data.CircleShader = shaders[1];
 
         s_Data.TextureSlots[0] = s_Data.WhiteTexture;
 
@@ -181,6 +309,8 @@ namespace Himii
         s_Data.QuadVertexPositions[2] = {0.5f, 0.5f, 0.0f, 1.0f};
         s_Data.QuadVertexPositions[3] = {-0.5f, 0.5f, 0.0f, 1.0f};
 
+        // uniform block 绑定点：0 = Camera（Renderer2D 各着色器），1 = Object（Renderer::Submit 的逐次绘制参数），
+        // 2 = Grid（DrawGrid）
         s_Data.CameraUniformBuffer = UniformBuffer::Create(sizeof(Renderer2DData::CameraData), 0);
     }
     void Renderer2D::Shutdown()
@@ -189,27 +319,28 @@ namespace Himii
 
 
         delete[] s_Data.QuadVertexBufferBase;
+        delete[] s_Data.CircleVertexBufferBase;
+
+        s_Data.GridShader.reset();
+        s_Data.GridVertexArray.reset();
+        s_Data.GridUniformBuffer.reset();
+        s_Data.LineShader.reset();
     }
     void Renderer2D::BeginScene(const OrthographicCamera &camera)
     {
         HIMII_PROFILE_FUNCTION();
 
-        s_Data.QuadShader->Bind();
-        s_Data.QuadShader->SetMat4("u_ViewProjection", camera.GetViewProjectionMatrix());
-        s_Data.QuadShader->SetMat4("u_Transform", glm::mat4(1.0f));
+        // 着色器的相机参数在 Camera 块里，按名称设置 u_ViewProjection 不会生效
+        SetSceneCamera(camera.GetViewProjectionMatrix());
 
-        s_Data.QuadIndexCount = 0;
-        s_Data.QuadVertexBufferPtr = s_Data.QuadVertexBufferBase;
-
-        s_Data.TextureSlotIndex = 1;
+        StartBatch();
     }
 
     void Renderer2D::BeginScene(const EditorCamera& camera)
     {
         HIMII_PROFILE_FUNCTION();
 
-        s_Data.CameraBuffer.ViewProjection = camera.GetViewProjection();
-        s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(Renderer2DData::CameraData));
+        SetSceneCamera(camera.GetViewProjection());
 
         StartBatch();
     }
@@ -218,8 +349,7 @@ namespace Himii
     {
         HIMII_PROFILE_FUNCTION();
 
-        s_Data.CameraBuffer.ViewProjection = camera.GetProjection() * glm::inverse(transform);
-        s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(Renderer2DData::CameraData));
+        SetSceneCamera(camera.GetProjection() * glm::inverse(transform));
 
         StartBatch();
     }
@@ -243,9 +373,6 @@ namespace Himii
         s_Data.CircleIndexCount = 0;
         s_Data.CircleVertexBufferPtr = s_Data.CircleVertexBufferBase;
 
-        s_Data.LineVertexCount = 0;
-        s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;
-
         s_Data.TextureSlotIndex = 1; // 0 reserved for white texture
     }
 
@@ -277,18 +404,6 @@ namespace Himii
             s_Data.Stats.DrawCalls++;
         }
 
-        if (s_Data.LineVertexCount)
-        {
-            uint32_t dataSize =
-                    (uint32_t)((uint8_t *)s_Data.LineVertexBufferPtr - (uint8_t *)s_Data.LineVertexBufferBase);
-            s_Data.LineVertexBuffer->SetData(s_Data.LineVertexBufferBase, dataSize);
-
-            s_Data.LineShader->Bind();
-            RenderCommand::SetLineWidth(s_Data.LineWidth);
-            RenderCommand::DrawLines(s_Data.LineVertexArray, s_Data.LineVertexCount);
-            s_Data.Stats.DrawCalls++;
-        }
-
     }
 
     // Some paths request a new batch when buffers/textures reach capacity
@@ -341,15 +456,8 @@ namespace Himii
             NextBatch();
 
         for (size_t i = 0; i < quadVertexCount; i++)
-        {
-            s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-            s_Data.QuadVertexBufferPtr->Color = color;
-            s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-            s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-            s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-            s_Data.QuadVertexBufferPtr->EntityID = entityID;
-            s_Data.QuadVertexBufferPtr++;
-        }
+            WriteQuadVertex(transform * s_Data.QuadVertexPositions[i], color, textureCoords[i], textureIndex,
+                            tilingFactor, entityID);
 
         s_Data.QuadIndexCount += 6;
 
@@ -380,7 +488,7 @@ namespace Himii
 
         if (textureIndex == 0.0f)
         {
-            if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
+            if (s_Data.TextureSlotIndex >= s_Data.TextureSlotCount)
                 NextBatch();
 
             textureIndex = (float)s_Data.TextureSlotIndex;
@@ -389,15 +497,8 @@ namespace Himii
         }
 
         for (size_t i = 0; i < quadVertexCount; i++)
-        {
-            s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
-            s_Data.QuadVertexBufferPtr->Color = tintColor;
-            s_Data.QuadVertexBufferPtr->TexCoord = textureCoords[i];
-            s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-            s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-            s_Data.QuadVertexBufferPtr->EntityID = entityID;
-            s_Data.QuadVertexBufferPtr++;
-        }
+            WriteQuadVertex(transform * s_Data.QuadVertexPositions[i], tintColor, textureCoords[i], textureIndex,
+                            tilingFactor, entityID);
 
         s_Data.QuadIndexCount += 6;
 
@@ -432,7 +533,7 @@ namespace Himii
         }
         if (textureIndex == 0.0f)
         {
-            if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
+            if (s_Data.TextureSlotIndex >= s_Data.TextureSlotCount)
                 NextBatch();
             textureIndex = (float)s_Data.TextureSlotIndex;
             s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
@@ -442,37 +543,8 @@ namespace Himii
         glm::mat4 transform =
                 glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), {size.x, size.y, 1.0f});
 
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[0];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = uvs[0];
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr->EntityID = -1;
-        s_Data.QuadVertexBufferPtr++;
-
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[1];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = uvs[1];
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr->EntityID = -1;
-        s_Data.QuadVertexBufferPtr++;
-
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[2];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = uvs[2];
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr->EntityID = -1;
-        s_Data.QuadVertexBufferPtr++;
-
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[3];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = uvs[3];
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr->EntityID = -1;
-        s_Data.QuadVertexBufferPtr++;
+        for (size_t i = 0; i < 4; i++)
+            WriteQuadVertex(transform * s_Data.QuadVertexPositions[i], color, uvs[i], textureIndex, tilingFactor, -1);
 
         s_Data.QuadIndexCount += 6;
         s_Data.Stats.QuadCount++;
@@ -499,7 +571,7 @@ namespace Himii
         }
         if (textureIndex == 0.0f)
         {
-            if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
+            if (s_Data.TextureSlotIndex >= s_Data.TextureSlotCount)
                 NextBatch();
             textureIndex = (float)s_Data.TextureSlotIndex;
             s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
@@ -510,37 +582,8 @@ namespace Himii
         const glm::vec4 color = tintColor;
 
         // Emit the 4 vertices
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[0];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = uvs[0];
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr->EntityID = entityID;
-        s_Data.QuadVertexBufferPtr++;
-
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[1];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = uvs[1];
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr->EntityID = entityID;
-        s_Data.QuadVertexBufferPtr++;
-
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[2];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = uvs[2];
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr->EntityID = entityID;
-        s_Data.QuadVertexBufferPtr++;
-
-        s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[3];
-        s_Data.QuadVertexBufferPtr->Color = color;
-        s_Data.QuadVertexBufferPtr->TexCoord = uvs[3];
-        s_Data.QuadVertexBufferPtr->TexIndex = textureIndex;
-        s_Data.QuadVertexBufferPtr->TilingFactor = tilingFactor;
-        s_Data.QuadVertexBufferPtr->EntityID = entityID;
-        s_Data.QuadVertexBufferPtr++;
+        for (size_t i = 0; i < 4; i++)
+            WriteQuadVertex(transform * s_Data.QuadVertexPositions[i], color, uvs[i], textureIndex, tilingFactor, entityID);
 
         s_Data.QuadIndexCount += 6;
         s_Data.Stats.QuadCount++;
@@ -588,13 +631,15 @@ namespace Himii
 
         for (size_t i = 0; i < 4; i++)
         {
-            s_Data.CircleVertexBufferPtr->WorldPosition = transform * s_Data.QuadVertexPositions[i];
-            s_Data.CircleVertexBufferPtr->LocalPosition = s_Data.QuadVertexPositions[i]*2.0f;
-            s_Data.CircleVertexBufferPtr->Color = color;
-            s_Data.CircleVertexBufferPtr->Thickness = thickness;
-            s_Data.CircleVertexBufferPtr->Fade = fade;
-            s_Data.CircleVertexBufferPtr->EntityID = entityID;
-            s_Data.CircleVertexBufferPtr++;
+            CircleVertex *vertex = reinterpret_cast<CircleVertex *>(s_Data.CircleVertexBufferPtr);
+            vertex->WorldPosition = transform * s_Data.QuadVertexPositions[i];
+            vertex->LocalPosition = s_Data.QuadVertexPositions[i]*2.0f;
+            vertex->Color = color;
+            vertex->Thickness = thickness;
+            vertex->Fade = fade;
+            if (s_Data.Specification.EntityIDs)
+                vertex->EntityID = entityID;
+            s_Data.CircleVertexBufferPtr += s_Data.CircleVertexStride;
         }
 
         s_Data.CircleIndexCount += 6;
@@ -602,54 +647,190 @@ namespace Himii
         s_Data.Stats.QuadCount++;
     }
 
-    void Renderer2D::DrawLine(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec4 &color, int entityID)
+    void Renderer2D::DrawLine(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec4 &color, int entityID,
+                              float width)
     {
-        s_Data.LineVertexBufferPtr->Position = p0;
-        s_Data.LineVertexBufferPtr->Color = color;
-        s_Data.LineVertexBufferPtr->EntityID = entityID;
-        s_Data.LineVertexBufferPtr++;
+        LineScreenPoint a, b;
+        glm::vec2 normal;
+        if (!ProjectLinePoint(p0, a) || !ProjectLinePoint(p1, b) || !LineNormal(a, b, normal))
+            return;
+
+        if (NeedsNewBatch(4, 6))
+            NextBatch();
+
+        glm::vec2 offset = normal * (0.5f * (width > 0.0f ? width : s_Data.LineWidth));
+        WriteLineQuad(a, b, offset, offset, color, entityID);
+    }
+
+    void Renderer2D::DrawPolyline(const glm::vec3 *points, uint32_t count, const glm::vec4 &color, bool closed,
+                                  int entityID, float width)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!points || count < 2)
+            return;
+
+        const float halfWidth = 0.5f * (width > 0.0f ? width : s_Data.LineWidth);
+        const float miterLimit = 2.0f * halfWidth;
+        const uint32_t segmentCount = closed ? count : count - 1;
+
+        static std::vector<LineScreenPoint> screenPoints;
+        static std::vector<glm::vec2> normals;
+        static std::vector<glm::vec2> joinOffsets;
+        screenPoints.resize(count);
+        normals.resize(segmentCount);
+        joinOffsets.resize(count);
+
+        for (uint32_t i = 0; i < count; i++)
+        {
+            // 有顶点在相机后面时退回逐段绘制，由 DrawLine 跳过不可见的段
+            if (!ProjectLinePoint(points[i], screenPoints[i]))
+            {
+                for (uint32_t s = 0; s < segmentCount; s++)
+                    DrawLine(points[s], points[(s + 1) % count], color, entityID, width);
+                return;
+            }
+        }
+
+        // 退化（长度为 0）的段沿用前一段的法线
+        glm::vec2 lastNormal = {0.0f, 1.0f};
+        for (uint32_t s = 0; s < segmentCount; s++)
+        {
+            if (LineNormal(screenPoints[s], screenPoints[(s + 1) % count], normals[s]))
+                lastNormal = normals[s];
+            else
+                normals[s] = lastNormal;
+        }
+
+        // 连接处取两段法线的角平分方向（斜接），长度使两侧线宽保持一致，尖角时截断到 miterLimit
+        for (uint32_t i = 0; i < count; i++)
+        {
+            if (!closed && (i == 0 || i == count - 1))
+            {
+                joinOffsets[i] = normals[i == 0 ? 0 : segmentCount - 1] * halfWidth;
+                continue;
+            }
+
+            const glm::vec2 &previous = normals[(i + segmentCount - 1) % segmentCount];
+            const glm::vec2 &next = normals[i % segmentCount];
+            glm::vec2 sum = previous + next;
+            float sumLength = glm::length(sum);
+            if (sumLength < 1e-3f) // 原路折返
+            {
+                joinOffsets[i] = next * halfWidth;
+                continue;
+            }
+
+            glm::vec2 miter = sum / sumLength;
+            float miterLength = halfWidth / std::max(glm::dot(miter, next), 1e-3f);
+            joinOffsets[i] = miter * std::min(miterLength, miterLimit);
+        }
 
-        s_Data.LineVertexBufferPtr->Position = p1;
-        s_Data.LineVertexBufferPtr->Color = color;
-        s_Data.LineVertexBufferPtr->EntityID = entityID;
-        s_Data.LineVertexBufferPtr++;
+        for (uint32_t s = 0; s < segmentCount; s++)
+        {
+            if (NeedsNewBatch(4, 6))
+                NextBatch();
 
-        s_Data.LineVertexCount += 2;
+            uint32_t end = (s + 1) % count;
+            WriteLineQuad(screenPoints[s], screenPoints[end], joinOffsets[s], joinOffsets[end], color, entityID);
+        }
     }
 
-    void Renderer2D::DrawRect(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color, int entityID)
+    void Renderer2D::DrawRect(const glm::vec3 &position, const glm::vec2 &size, const glm::vec4 &color, int entityID,
+                              float width)
     {
-        glm::vec3 p0 = glm::vec3(position.x - size.x * 0.5f, position.y - size.y * 0.5f, position.z);
-        glm::vec3 p1 = glm::vec3(position.x + size.x * 0.5f, position.y - size.y * 0.5f, position.z);
-        glm::vec3 p2 = glm::vec3(position.x + size.x * 0.5f, position.y + size.y * 0.5f, position.z);
-        glm::vec3 p3 = glm::vec3(position.x - size.x * 0.5f, position.y + size.y * 0.5f, position.z);
+        glm::vec3 corners[4] = {glm::vec3(position.x - size.x * 0.5f, position.y - size.y * 0.5f, position.z),
+                                glm::vec3(position.x + size.x * 0.5f, position.y - size.y * 0.5f, position.z),
+                                glm::vec3(position.x + size.x * 0.5f, position.y + size.y * 0.5f, position.z),
+                                glm::vec3(position.x - size.x * 0.5f, position.y + size.y * 0.5f, position.z)};
 
-        DrawLine(p0, p1, color, entityID);
-        DrawLine(p1, p2, color, entityID);
-        DrawLine(p2, p3, color, entityID);
-        DrawLine(p3, p0, color, entityID);
+        DrawPolyline(corners, 4, color, true, entityID, width);
     }
 
-    void Renderer2D::DrawRect(const glm::mat4 &transform, const glm::vec4 &color, int entityID)
+    void Renderer2D::DrawRect(const glm::mat4 &transform, const glm::vec4 &color, int entityID, float width)
     {
-        glm::vec3 lineVertices[4];
+        glm::vec3 corners[4];
         for (size_t i = 0; i < 4; i++)
-            lineVertices[i] = transform * s_Data.QuadVertexPositions[i];
+            corners[i] = transform * s_Data.QuadVertexPositions[i];
 
-        DrawLine(lineVertices[0], lineVertices[1], color, entityID);
-        DrawLine(lineVertices[1], lineVertices[2], color, entityID);
-        DrawLine(lineVertices[2], lineVertices[3], color, entityID);
-        DrawLine(lineVertices[3], lineVertices[0], color, entityID);
+        DrawPolyline(corners, 4, color, true, entityID, width);
+    }
+
+    void Renderer2D::DrawLineGeometry(const LineGeometry &geometry)
+    {
+        if (!geometry.GetIndexCount())
+            return;
+
+        if (!s_Data.LineShader)
+        {
+            std::vector<std::string> keywords;
+            if (!s_Data.Specification.EntityIDs)
+                keywords.push_back("NO_ENTITY_ID");
+            s_Data.LineShader = Shader::CreateBatch({"assets/shaders/Renderer2D_Line.glsl"}, keywords)[0];
+        }
+
+        // 展开在顶点着色器中完成，所需的视口尺寸和默认线宽已由 BeginScene 写入 Camera 块
+        s_Data.LineShader->Bind();
+        RenderCommand::DrawIndexed(geometry.GetVertexArray(), geometry.GetIndexCount());
+        s_Data.Stats.DrawCalls++;
+    }
+
+    void Renderer2D::DrawGrid(const Renderer2DGridSettings &settings)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!s_Data.GridShader)
+        {
+            std::vector<std::string> keywords;
+            if (!s_Data.Specification.EntityIDs)
+                keywords.push_back("NO_ENTITY_ID");
+            s_Data.GridShader = Shader::CreateBatch({"assets/shaders/Renderer2D_Grid.glsl"}, keywords)[0];
+
+            // 覆盖整个屏幕的单个三角形
+            float vertices[] = {-1.0f, -1.0f, 3.0f, -1.0f, -1.0f, 3.0f};
+            uint32_t indices[] = {0, 1, 2};
+            Ref<VertexBuffer> vertexBuffer = VertexBuffer::Create(vertices, sizeof(vertices));
+            vertexBuffer->SetLayout({{ShaderDataType::Float2, "a_Position"}});
+            s_Data.GridVertexArray = VertexArray::Create();
+            s_Data.GridVertexArray->AddVertexBuffer(vertexBuffer);
+            s_Data.GridVertexArray->SetIndexBuffer(IndexBuffer::Create(indices, 3));
+
+            s_Data.GridUniformBuffer = UniformBuffer::Create(sizeof(Renderer2DData::GridData), 2);
+        }
+
+        Renderer2DData::GridData grid;
+        grid.InverseViewProjection = glm::inverse(s_Data.CameraBuffer.ViewProjection);
+        grid.Color = settings.Color;
+        grid.MajorColor = settings.MajorColor;
+        grid.Spacing = std::max(settings.Spacing, 1e-4f);
+        grid.MajorInterval = (float)std::max(settings.MajorInterval, 1u);
+        s_Data.GridUniformBuffer->SetData(&grid, sizeof(Renderer2DData::GridData));
+
+        s_Data.GridShader->Bind();
+        RenderCommand::DrawIndexed(s_Data.GridVertexArray);
+        s_Data.Stats.DrawCalls++;
     }
 
     void Renderer2D::DrawSprite(const glm::mat4 &transform, SpriteRendererComponent &sprite, int entityID)
     {
-        if (sprite.Texture)
+        if (sprite.Texture && (sprite.UVMin != glm::vec2(0.0f) || sprite.UVMax != glm::vec2(1.0f)))
+        {
+            // 精灵表的一帧：只取纹理中的子矩形，同一张表的所有精灵可以合批
+            const std::array<glm::vec2, 4> uvs = {sprite.UVMin, glm::vec2{sprite.UVMax.x, sprite.UVMin.y},
+                                                  sprite.UVMax, glm::vec2{sprite.UVMin.x, sprite.UVMax.y}};
+            DrawQuadUV(transform, sprite.Texture, uvs, sprite.TilingFactor, sprite.Color, entityID);
+        }
+        else if (sprite.Texture)
             DrawQuad(transform, sprite.Texture, sprite.TilingFactor, sprite.Color, entityID);
         else
             DrawQuad(transform, sprite.Color, entityID);
     }
 
+    const Renderer2DSpecification &Renderer2D::GetSpecification()
+    {
+        return s_Data.Specification;
+    }
+
     float Renderer2D::GetLineWidth()
     {
         return s_Data.LineWidth;
@@ -666,6 +847,12 @@ namespace Himii
     }
     Renderer2D::Statistics Renderer2D::GetStatistics()
     {
-        return s_Data.Stats;
+        Statistics stats = s_Data.Stats;
+        TextureMemoryStats textureStats = Texture2D::GetMemoryStats();
+        stats.TextureCount = textureStats.TextureCount;
+        stats.CompressedTextureCount = textureStats.CompressedCount;
+        stats.TextureMemoryBytes = textureStats.GPUBytes;
+        stats.TextureMemorySavedBytes = textureStats.GetSavedBytes();
+        return stats;
     }
 } // namespace Himii
@@ -1,4 +1,5 @@
 #pragma once
+#include "Himii/Renderer/LineGeometry.h"
 #include "Himii/Renderer/OrthographicCamera.h"
 #include "Himii/Renderer/Texture.h"
 
@@ -7,10 +8,31 @@
 
 namespace Himii
 {
+    // 决定 Renderer2D 使用的着色器变体和顶点布局；运行时不需要拾取时可以用更精简的配置
+    struct Renderer2DSpecification {
+        bool EntityIDs = true;       // 顶点带实体 ID 并写入整数附件（编辑器拾取用）
+        bool TilingAttribute = true; // false 时平铺系数在 CPU 上乘进 UV，顶点里不再带这一项
+        uint32_t TextureSlots = 32;  // 每批纹理槽数量，32 或 16（OpenGL 保证的片元纹理单元下限）
+
+        // 运行时：去掉实体 ID 和平铺属性，纹理槽减到 16
+        static Renderer2DSpecification Runtime()
+        {
+            return {false, false, 16};
+        }
+    };
+
+    // 编辑器网格：在 z = 0 平面上按片元计算，线宽固定为约 1 像素
+    struct Renderer2DGridSettings {
+        float Spacing = 1.0f;        // 细线间距（世界单位）
+        uint32_t MajorInterval = 10; // 每隔多少条细线画一条粗线
+        glm::vec4 Color = {0.6f, 0.6f, 0.6f, 0.6f};
+        glm::vec4 MajorColor = {0.6f, 0.6f, 0.6f, 1.0f};
+    };
+
     class Renderer2D {
     public:
 
-        static void Init();
+        static void Init(const Renderer2DSpecification &specification = {});
         static void Shutdown();
 
         static void BeginScene(const OrthographicCamera &camera);
@@ -35,13 +57,27 @@ namespace Himii
 
         static void DrawCircle(const glm::mat4 &transform, const glm::vec4 &color,float thickness=1.0f,float fade=0.0025f, int entityID = -1);
 
-        static void DrawLine(const glm::vec3 &p0,const glm::vec3&p1, const glm::vec4 &color, int entityID = -1);
+        // 线段在屏幕空间展开成四边形，与精灵在同一个四边形批次中绘制；
+        // width 以像素计，<= 0 时使用 SetLineWidth 设置的默认线宽
+        static void DrawLine(const glm::vec3 &p0,const glm::vec3&p1, const glm::vec4 &color, int entityID = -1, float width = 0.0f);
+        // 折线，相邻线段斜接（miter），尖角处斜接长度不超过线宽；closed 时首尾相连
+        static void DrawPolyline(const glm::vec3 *points, uint32_t count, const glm::vec4 &color, bool closed = false,
+                                 int entityID = -1, float width = 0.0f);
 
-        static void DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, int entityID = -1);
-		static void DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
+        static void DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, int entityID = -1, float width = 0.0f);
+		static void DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityID = -1, float width = 0.0f);
+
+        // 以下两个不进入批次，调用时立即绘制，需在 BeginScene / EndScene 之间
+        // 已上传的折线集合，一次 draw call；在顶点着色器中按像素线宽展开并斜接，首次调用时加载着色器
+        static void DrawLineGeometry(const LineGeometry &geometry);
+        // 全屏无限网格，按当前相机反投影到 z = 0 平面，用屏幕空间导数做抗锯齿；首次调用时加载着色器
+        static void DrawGrid(const Renderer2DGridSettings &settings = {});
 
         static void DrawSprite(const glm::mat4 &transform, SpriteRendererComponent& sprite,int entityID=-1);
 
+        static const Renderer2DSpecification &GetSpecification();
+
+        // 默认线宽（像素），LineGeometry 使用 BeginScene 时的值
         static float GetLineWidth();
         static void SetLineWidth(float width);
 
@@ -69,6 +105,12 @@ namespace Himii
             uint32_t DrawCalls = 0;
             uint32_t QuadCount = 0;
 
+            // 纹理显存（取自 Texture2D::GetMemoryStats，不随 ResetStats 清零）
+            uint32_t TextureCount = 0;
+            uint32_t CompressedTextureCount = 0;
+            uint64_t TextureMemoryBytes = 0;
+            uint64_t TextureMemorySavedBytes = 0; // 相对于全部按未压缩格式存储
+
             uint32_t GetTotalVertexCount() const
             {
                 return QuadCount * 4;
@@ -18,6 +18,8 @@ namespace Himii
     public:
         virtual void Init() = 0;
         virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) = 0;
+        // 当前生效的视口（包括 Framebuffer::Bind 设置的）
+        virtual void GetViewport(uint32_t &x, uint32_t &y, uint32_t &width, uint32_t &height) = 0;
         virtual void SetClearColor(const glm::vec4 &color) = 0;
         virtual void Clear() = 0;
 
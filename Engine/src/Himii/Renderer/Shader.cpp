@@ -32,6 +32,20 @@ namespace Himii
     return nullptr;
     }
 
+    std::vector<Ref<Shader>> Shader::CreateBatch(const std::vector<std::string> &filepaths,
+                                                 const std::vector<std::string> &keywords)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None:
+                HIMII_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+                return {};
+            case RendererAPI::API::OpenGL:
+                return OpenGLShader::CreateBatch(filepaths, keywords);
+        }
+        return {};
+    }
+
     void ShaderLibrary::Add(Ref<Shader> &shader)
     {
         auto name = shader->GetName();
@@ -2,9 +2,20 @@
 #include "Himii/Core/Core.h"
 #include "glm/glm.hpp"
 #include "string"
+#include <vector>
 
 namespace Himii
 {
+    // 着色器参数句柄，用 GetUniformHandle 取一次后反复使用；Location 为 -1 表示着色器中没有该 uniform，设置时忽略
+    struct ShaderUniformHandle {
+        int32_t Location = -1;
+
+        bool IsValid() const
+        {
+            return Location >= 0;
+        }
+    };
+
     class Shader {
     public:
         virtual ~Shader() = default;
@@ -20,10 +31,28 @@ namespace Himii
         virtual void SetFloat4(const std::string &name, const glm::vec4 &value) = 0;
         virtual void SetMat4(const std::string &name, const glm::mat4 &value) = 0;
 
+        // 位置在链接后由反射表一次性解析，按名称的 Set* 也走这张表
+        virtual ShaderUniformHandle GetUniformHandle(const std::string &name) = 0;
+        virtual void SetInt(ShaderUniformHandle handle, int value) = 0;
+        virtual void SetIntArray(ShaderUniformHandle handle, int *values, uint32_t count) = 0;
+        virtual void SetFloat(ShaderUniformHandle handle, float value) = 0;
+        virtual void SetFloat2(ShaderUniformHandle handle, const glm::vec2 &value) = 0;
+        virtual void SetFloat3(ShaderUniformHandle handle, const glm::vec3 &value) = 0;
+        virtual void SetFloat4(ShaderUniformHandle handle, const glm::vec4 &value) = 0;
+        virtual void SetMat4(ShaderUniformHandle handle, const glm::mat4 &value) = 0;
+
         virtual const std::string &GetName() const = 0;
 
+        // 按源码中 #pragma variant 声明的关键字取变体（启用的关键字以宏定义传给编译器），
+        // 首次请求时编译并缓存；未声明的关键字会被忽略
+        virtual Ref<Shader> GetVariant(const std::vector<std::string> &keywords) = 0;
+
         static Ref<Shader> Create(const std::string &filepath);
         static Ref<Shader> Create(const std::string& name, const std::string &vertexSrc, const std::string &fragmentSrc);
+        // 一次创建多个着色器，编译在工作线程并行，返回顺序与 filepaths 一致；
+        // keywords 对每个文件只启用其声明过的部分，直接得到对应变体
+        static std::vector<Ref<Shader>> CreateBatch(const std::vector<std::string> &filepaths,
+                                                    const std::vector<std::string> &keywords = {});
     };
 
     class ShaderLibrary {
@@ -5,6 +5,9 @@
 
 namespace Himii
 {
+    // 纹理只在主线程创建和销毁
+    static TextureMemoryStats s_TextureMemoryStats;
+
     Ref<Texture2D> Texture2D::Create(uint32_t width,uint32_t height)
     {
         switch (Renderer::GetAPI())
@@ -49,4 +52,40 @@ namespace Himii
         HIMII_CORE_ASSERT(false, "Unknown RendererAPI!");
         return nullptr;
     }
-}
\ No newline at end of file
+    Ref<Texture2D> Texture2D::CreatePlaceholder(const std::string &path)
+    {
+        switch (Renderer::GetAPI())
+        {
+            case RendererAPI::API::None:
+                HIMII_CORE_ASSERT(false, "RendererAPI::None is currently not supported!");
+                return nullptr;
+            case RendererAPI::API::OpenGL:
+                return CreateRef<OpenGLTexture>(path, OpenGLTexture::DeferredLoad{});
+            case RendererAPI::API::Vulkan:
+                HIMII_CORE_ASSERT(false, "RendererAPI::Vulkan is currently not supported!");
+                return nullptr;
+            case RendererAPI::API::DirectX12:
+                HIMII_CORE_ASSERT(false, "RendererAPI::DirectX12 is currently not supported!");
+                return nullptr;
+            case RendererAPI::API::Metal:
+                HIMII_CORE_ASSERT(false, "RendererAPI::Metal is currently not supported!");
+                return nullptr;
+        }
+        HIMII_CORE_ASSERT(false, "Unknown RendererAPI!");
+        return nullptr;
+    }
+
+    TextureMemoryStats Texture2D::GetMemoryStats()
+    {
+        return s_TextureMemoryStats;
+    }
+
+    void Texture2D::TrackMemory(int32_t textureDelta, int32_t compressedDelta, int64_t gpuBytesDelta,
+                                int64_t uncompressedBytesDelta)
+    {
+        s_TextureMemoryStats.TextureCount += textureDelta;
+        s_TextureMemoryStats.CompressedCount += compressedDelta;
+        s_TextureMemoryStats.GPUBytes += gpuBytesDelta;
+        s_TextureMemoryStats.UncompressedBytes += uncompressedBytesDelta;
+    }
+}
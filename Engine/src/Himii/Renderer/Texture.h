@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <array>
+#include <algorithm>
 #include "glm/vec2.hpp"
 #include "Himii/Core/Core.h"
 #include "Himii/Asset/Asset.h"
@@ -12,7 +13,64 @@ namespace Himii
         R8,
         RGB8,
         RGBA8,
-        RGBA32F
+        RGBA32F,
+        // 块压缩格式，以 4x4 像素块为单位存储
+        BC1, // RGB + 1 位 alpha，8 字节/块
+        BC3, // RGBA，16 字节/块
+        BC7  // RGBA，16 字节/块，质量最好
+    };
+
+    inline bool IsBlockCompressed(ImageFormat format)
+    {
+        return format == ImageFormat::BC1 || format == ImageFormat::BC3 || format == ImageFormat::BC7;
+    }
+
+    // 一“行”的字节数：非压缩格式是一行像素，块压缩格式是一行 4x4 块
+    inline uint64_t GetImageRowPitch(ImageFormat format, uint32_t width)
+    {
+        switch (format)
+        {
+            case ImageFormat::R8: return width;
+            case ImageFormat::RGB8: return (uint64_t)width * 3;
+            case ImageFormat::RGBA8: return (uint64_t)width * 4;
+            case ImageFormat::RGBA32F: return (uint64_t)width * 16;
+            case ImageFormat::BC1: return (uint64_t)((width + 3) / 4) * 8;
+            case ImageFormat::BC3:
+            case ImageFormat::BC7: return (uint64_t)((width + 3) / 4) * 16;
+            default: return 0;
+        }
+    }
+
+    inline uint32_t GetImageRowCount(ImageFormat format, uint32_t height)
+    {
+        return IsBlockCompressed(format) ? (height + 3) / 4 : height;
+    }
+
+    inline uint64_t GetImageSize(ImageFormat format, uint32_t width, uint32_t height)
+    {
+        return GetImageRowPitch(format, width) * GetImageRowCount(format, height);
+    }
+
+    // mipCount 包含第 0 级
+    inline uint64_t GetMipChainSize(ImageFormat format, uint32_t width, uint32_t height, uint32_t mipCount)
+    {
+        uint64_t size = 0;
+        for (uint32_t level = 0; level < mipCount; ++level)
+            size += GetImageSize(format, std::max(1u, width >> level), std::max(1u, height >> level));
+        return size;
+    }
+
+    // 所有存活的 Texture2D 的显存占用；UncompressedBytes 是同样尺寸和 mip 数按 RGBA8（原本为 RGB8 的按 RGB8）存储的大小
+    struct TextureMemoryStats {
+        uint32_t TextureCount = 0;
+        uint32_t CompressedCount = 0;
+        uint64_t GPUBytes = 0;
+        uint64_t UncompressedBytes = 0;
+
+        uint64_t GetSavedBytes() const
+        {
+            return UncompressedBytes > GPUBytes ? UncompressedBytes - GPUBytes : 0;
+        }
     };
 
     struct TextureSpecification
@@ -56,5 +114,21 @@ namespace Himii
     public:
         static Ref<Texture2D> Create(uint32_t width,uint32_t height);
         static Ref<Texture2D> Create(const std::string &path);
+        // 流式加载用：先创建 1x1 占位纹理，数据由 TextureStreamer 分块上传完成后原地切换
+        static Ref<Texture2D> CreatePlaceholder(const std::string &path);
+
+        // 分配真实尺寸的存储，上传期间仍显示占位纹理；format 为 RGB8/RGBA8 或块压缩格式，mipCount 包含第 0 级
+        virtual void BeginStreaming(uint32_t width, uint32_t height, ImageFormat format, uint32_t mipCount = 1) = 0;
+        // 上传 mipLevel 级的 [firstRow, firstRow + rowCount) 行（行的含义见 GetImageRowPitch），data 指向第 firstRow 行
+        virtual void StreamRows(const void *data, uint32_t firstRow, uint32_t rowCount, uint32_t mipLevel = 0) = 0;
+        // 全部行上传完毕，切换到真实纹理
+        virtual void EndStreaming() = 0;
+
+        static TextureMemoryStats GetMemoryStats();
+
+    protected:
+        // 后端在分配/释放纹理存储时调用，delta 可以为负
+        static void TrackMemory(int32_t textureDelta, int32_t compressedDelta, int64_t gpuBytesDelta,
+                                int64_t uncompressedBytesDelta);
     };
 } // namespace Himii
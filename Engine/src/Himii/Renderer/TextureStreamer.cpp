@@ -0,0 +1,239 @@
+#include "Hepch.h"
+#include "Himii/Renderer/TextureStreamer.h"
+#include "Himii/Core/Timer.h"
+#include "Himii/Asset/VirtualFileSystem.h"
+
+#include "stb_image.h"
+
+namespace Himii
+{
+    TextureStreamer::TextureStreamer(uint32_t workerCount) : m_Workers(workerCount)
+    {
+    }
+
+    TextureStreamer::~TextureStreamer()
+    {
+        // 先等工作线程结束，再释放尚未上传的像素
+        m_Workers.Wait();
+        for (auto &[texture, request]: m_Requests)
+        {
+            if (request->Pixels)
+                stbi_image_free(request->Pixels);
+            request->Pixels = nullptr;
+        }
+    }
+
+    Ref<Texture2D> TextureStreamer::Load(const std::string &path)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Ref<Texture2D> texture = Texture2D::CreatePlaceholder(path);
+        if (!texture)
+            return nullptr;
+
+        Ref<Request> request = CreateRef<Request>();
+        request->Texture = texture;
+        request->Path = path;
+        request->RequestTime = std::chrono::steady_clock::now();
+        m_Requests[texture.get()] = request;
+        m_FailedTextures.erase(texture.get());
+
+        m_Workers.Submit(
+                [this, request]()
+                {
+                    Decode(*request);
+
+                    std::lock_guard<std::mutex> lock(m_DecodedMutex);
+                    m_DecodedQueue.push_back(request);
+                });
+
+        return texture;
+    }
+
+    void TextureStreamer::Decode(Request &request)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        request.State = TextureLoadState::Decoding;
+        Timer timer;
+
+        VirtualFile &file = request.Source;
+        if (!VirtualFileSystem::ReadFile(request.Path, file))
+        {
+            request.State = TextureLoadState::Failed;
+            return;
+        }
+
+        // 烘焙纹理已经是上传格式并带 mip 链
+        CookedTextureView cooked;
+        if (CookedTexture::Parse(file.GetData(), file.GetSize(), cooked))
+        {
+            request.Levels = std::move(cooked.Levels);
+            request.Width = cooked.Width;
+            request.Height = cooked.Height;
+            request.Format = cooked.GetImageFormat();
+            request.DecodeMs = timer.ElapsedMillis();
+            request.State = TextureLoadState::Uploading;
+            return;
+        }
+
+        // 只支持 RGB/RGBA，灰度等格式扩展为 RGBA
+        int width = 0, height = 0, channels = 0;
+        if (!stbi_info_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels))
+        {
+            request.State = TextureLoadState::Failed;
+            return;
+        }
+        int desiredChannels = channels == 3 ? 3 : 4;
+
+        // 全局的翻转开关不是线程安全的，这里用线程局部的版本
+        stbi_set_flip_vertically_on_load_thread(1);
+        request.Pixels =
+                stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, desiredChannels);
+        if (!request.Pixels)
+        {
+            request.State = TextureLoadState::Failed;
+            return;
+        }
+
+        request.Width = (uint32_t)width;
+        request.Height = (uint32_t)height;
+        request.Format = desiredChannels == 4 ? ImageFormat::RGBA8 : ImageFormat::RGB8;
+        request.Levels = {{request.Pixels, request.Width, request.Height,
+                           GetImageSize(request.Format, request.Width, request.Height)}};
+        file = VirtualFile();
+        request.DecodeMs = timer.ElapsedMillis();
+        request.State = TextureLoadState::Uploading;
+    }
+
+    void TextureStreamer::Update()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        {
+            std::lock_guard<std::mutex> lock(m_DecodedMutex);
+            while (!m_DecodedQueue.empty())
+            {
+                Ref<Request> request = std::move(m_DecodedQueue.front());
+                m_DecodedQueue.pop_front();
+
+                if (request->State == TextureLoadState::Failed)
+                {
+                    HIMII_CORE_ERROR("Failed to load texture: {0}", request->Path);
+                    FinishRequest(request, TextureLoadState::Failed);
+                    continue;
+                }
+
+                m_TotalDecodeMs += request->DecodeMs;
+                ++m_DecodeSamples;
+                m_UploadQueue.push_back(std::move(request));
+            }
+        }
+
+        // 按行切块上传（压缩格式按 4x4 块行），一帧内上传的字节数不超过预算；每帧至少推进一行，保证大纹理也能完成
+        uint64_t uploadedBytes = 0;
+        while (!m_UploadQueue.empty() && uploadedBytes < m_UploadBudget)
+        {
+            Ref<Request> request = m_UploadQueue.front();
+            Texture2D &texture = *request->Texture;
+
+            if (request->NextLevel == 0 && request->NextRow == 0)
+                texture.BeginStreaming(request->Width, request->Height, request->Format,
+                                       (uint32_t)request->Levels.size());
+
+            const CookedTextureLevel &level = request->Levels[request->NextLevel];
+            uint64_t rowBytes = GetImageRowPitch(request->Format, level.Width);
+            uint32_t levelRows = GetImageRowCount(request->Format, level.Height);
+            uint64_t remainingBudget = m_UploadBudget - uploadedBytes;
+            uint32_t remainingRows = levelRows - request->NextRow;
+            uint32_t rowCount = (uint32_t)std::min<uint64_t>(remainingRows, std::max<uint64_t>(1, remainingBudget / rowBytes));
+
+            texture.StreamRows(level.Data + request->NextRow * rowBytes, request->NextRow, rowCount, request->NextLevel);
+            request->NextRow += rowCount;
+            uploadedBytes += rowCount * rowBytes;
+
+            // 逐级上传，最后一级完成后切换
+            if (request->NextRow >= levelRows)
+            {
+                request->NextRow = 0;
+                ++request->NextLevel;
+            }
+            if (request->NextLevel >= request->Levels.size())
+            {
+                texture.EndStreaming();
+                m_UploadQueue.pop_front();
+                FinishRequest(request, TextureLoadState::Ready);
+            }
+        }
+
+        m_Stats.UploadedBytesLastFrame = uploadedBytes;
+        m_Stats.TotalUploadedBytes += uploadedBytes;
+
+        // 清理已释放的失败纹理
+        for (auto it = m_FailedTextures.begin(); it != m_FailedTextures.end();)
+            it = it->second.expired() ? m_FailedTextures.erase(it) : std::next(it);
+
+        m_Stats.Queued = 0;
+        m_Stats.Decoding = 0;
+        m_Stats.Uploading = 0;
+        for (const auto &[texture, request]: m_Requests)
+        {
+            switch (request->State.load())
+            {
+                case TextureLoadState::Queued:
+                    ++m_Stats.Queued;
+                    break;
+                case TextureLoadState::Decoding:
+                    ++m_Stats.Decoding;
+                    break;
+                case TextureLoadState::Uploading:
+                    ++m_Stats.Uploading;
+                    break;
+                default:
+                    break;
+            }
+        }
+        m_Stats.AverageDecodeMs = m_DecodeSamples > 0 ? (float)(m_TotalDecodeMs / m_DecodeSamples) : 0.0f;
+        m_Stats.AverageLatencyMs = m_Stats.Completed > 0 ? (float)(m_TotalLatencyMs / m_Stats.Completed) : 0.0f;
+    }
+
+    void TextureStreamer::FinishRequest(const Ref<Request> &request, TextureLoadState state)
+    {
+        if (request->Pixels)
+        {
+            stbi_image_free(request->Pixels);
+            request->Pixels = nullptr;
+        }
+        request->Levels.clear();
+        request->Source = VirtualFile();
+        request->State = state;
+
+        if (state == TextureLoadState::Ready)
+        {
+            std::chrono::duration<double, std::milli> latency = std::chrono::steady_clock::now() - request->RequestTime;
+            m_TotalLatencyMs += latency.count();
+            ++m_Stats.Completed;
+        }
+        else
+        {
+            // 只记下弱引用，GetLoadState 仍能查到失败；占位纹理继续使用，由持有者决定何时释放
+            ++m_Stats.Failed;
+            m_FailedTextures[request->Texture.get()] = request->Texture;
+        }
+
+        // 完成后不再跟踪，成功的状态由纹理自身的 IsLoaded 给出
+        m_Requests.erase(request->Texture.get());
+    }
+
+    TextureLoadState TextureStreamer::GetLoadState(const Texture2D *texture) const
+    {
+        auto it = m_Requests.find(texture);
+        if (it != m_Requests.end())
+            return it->second->State.load();
+
+        auto failed = m_FailedTextures.find(texture);
+        if (failed != m_FailedTextures.end() && failed->second.lock().get() == texture)
+            return TextureLoadState::Failed;
+        return texture && texture->IsLoaded() ? TextureLoadState::Ready : TextureLoadState::None;
+    }
+} // namespace Himii
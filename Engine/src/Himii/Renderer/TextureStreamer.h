@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Himii/Asset/VirtualFileSystem.h"
+#include "Himii/Core/Core.h"
+#include "Himii/Core/ThreadPool.h"
+#include "Himii/Renderer/CookedTexture.h"
+#include "Himii/Renderer/Texture.h"
+
+namespace Himii
+{
+    enum class TextureLoadState : uint8_t {
+        None = 0, // 不是由 TextureStreamer 加载的纹理
+        Queued,
+        Decoding,
+        Uploading,
+        Ready,
+        Failed
+    };
+
+    struct TextureStreamerStats {
+        uint32_t Queued = 0;
+        uint32_t Decoding = 0;
+        uint32_t Uploading = 0; // 已解码，等待或正在上传
+        uint32_t Completed = 0;
+        uint32_t Failed = 0;
+
+        uint64_t UploadedBytesLastFrame = 0;
+        uint64_t TotalUploadedBytes = 0;
+
+        float AverageDecodeMs = 0.0f;
+        // 从请求到切换为真实纹理的平均耗时
+        float AverageLatencyMs = 0.0f;
+    };
+
+    // 纹理异步加载：工作线程解码，主线程在每帧的上传预算内经 PBO 分块上传，完成后原地切换占位纹理
+    class TextureStreamer {
+    public:
+        explicit TextureStreamer(uint32_t workerCount = 0);
+        ~TextureStreamer();
+
+        // 立即返回占位纹理，之后由 Update 逐步填充
+        Ref<Texture2D> Load(const std::string &path);
+
+        // 主线程每帧调用一次
+        void Update();
+
+        TextureLoadState GetLoadState(const Texture2D *texture) const;
+
+        void SetUploadBudget(uint64_t bytesPerFrame)
+        {
+            m_UploadBudget = bytesPerFrame;
+        }
+
+        uint64_t GetUploadBudget() const
+        {
+            return m_UploadBudget;
+        }
+
+        const TextureStreamerStats &GetStats() const
+        {
+            return m_Stats;
+        }
+
+        bool IsIdle() const
+        {
+            return m_Requests.empty();
+        }
+
+    private:
+        struct Request {
+            Ref<Texture2D> Texture;
+            std::string Path;
+            std::atomic<TextureLoadState> State{TextureLoadState::Queued};
+
+            // 工作线程写入，State 变为 Uploading 后主线程读取
+            unsigned char *Pixels = nullptr; // stbi 解码的结果
+            VirtualFile Source;              // 烘焙纹理不解码，各级 mip 直接指向文件数据
+            std::vector<CookedTextureLevel> Levels;
+            uint32_t Width = 0;
+            uint32_t Height = 0;
+            ImageFormat Format = ImageFormat::None;
+            float DecodeMs = 0.0f;
+
+            uint32_t NextLevel = 0;
+            uint32_t NextRow = 0;
+            std::chrono::steady_clock::time_point RequestTime;
+        };
+
+        void Decode(Request &request);
+        void FinishRequest(const Ref<Request> &request, TextureLoadState state);
+
+    private:
+        ThreadPool m_Workers;
+
+        // 仅主线程访问
+        std::unordered_map<const Texture2D *, Ref<Request>> m_Requests;
+        // 加载失败的纹理，不持有所有权：纹理释放后条目失效，地址被新纹理复用时也不会误报
+        std::unordered_map<const Texture2D *, std::weak_ptr<Texture2D>> m_FailedTextures;
+        std::deque<Ref<Request>> m_UploadQueue;
+
+        // 工作线程解码完成后放入，主线程在 Update 中取走
+        std::mutex m_DecodedMutex;
+        std::deque<Ref<Request>> m_DecodedQueue;
+
+        uint64_t m_UploadBudget = 8 * 1024 * 1024;
+        TextureStreamerStats m_Stats;
+
+        // 用于计算平均值
+        uint32_t m_DecodeSamples = 0;
+        double m_TotalDecodeMs = 0.0;
+        double m_TotalLatencyMs = 0.0;
+    };
+} // namespace Himii
@@ -0,0 +1,183 @@
+#include "Hepch.h"
+#include "Himii/Scene/AsyncSceneLoader.h"
+
+#include "Himii/Core/Timer.h"
+#include "Himii/Project/Project.h"
+#include "Himii/Scene/Components.h"
+#include "Himii/Scene/SceneBinarySerializer.h"
+
+namespace Himii
+{
+    AsyncSceneLoader::AsyncSceneLoader()
+    {
+    }
+
+    AsyncSceneLoader::~AsyncSceneLoader()
+    {
+        // 任务引用了成员，必须在成员析构前等它结束
+        m_Worker.Wait();
+    }
+
+    bool AsyncSceneLoader::Load(const std::filesystem::path &filepath)
+    {
+        if (IsLoading())
+        {
+            HIMII_CORE_WARNING("Scene '{0}' is still loading, ignoring request for '{1}'", m_Path.string(),
+                               filepath.string());
+            return false;
+        }
+
+        m_Path = filepath;
+        m_State = SceneLoadState::Parsing;
+        m_StagingScene = CreateRef<Scene>();
+        m_PendingTextures.clear();
+        m_TextureHandles.clear();
+        m_ReadyTextureCount = 0;
+        m_ParseSucceeded = false;
+        m_ParseFinished = false;
+        m_ParseProgress.EntityCount = 0;
+        m_ParseProgress.EntitiesLoaded = 0;
+
+        // 工作线程只碰暂存场景和 pending 列表，纹理/GL 资源留给主线程
+        Ref<Scene> scene = m_StagingScene;
+        m_Worker.Submit(
+                [this, scene, filepath]()
+                {
+                    Timer timer;
+                    bool succeeded = false;
+                    if (SceneBinarySerializer::IsBinaryScenePath(filepath))
+                    {
+                        SceneBinarySerializer serializer(scene);
+                        serializer.SetDeferredTextureLoads(&m_PendingTextures);
+                        serializer.SetProgress(&m_ParseProgress);
+                        succeeded = serializer.Deserialize(filepath);
+                    }
+                    else
+                    {
+                        SceneSerializer serializer(scene);
+                        serializer.SetDeferredTextureLoads(&m_PendingTextures);
+                        serializer.SetProgress(&m_ParseProgress);
+                        succeeded = serializer.Deserialize(filepath.string());
+                    }
+                    m_ParseMillis = timer.ElapsedMillis();
+                    m_ParseSucceeded = succeeded;
+                    m_ParseFinished.store(true, std::memory_order_release);
+                });
+        return true;
+    }
+
+    void AsyncSceneLoader::Update()
+    {
+        if (m_State == SceneLoadState::Parsing)
+        {
+            if (!m_ParseFinished.load(std::memory_order_acquire))
+                return;
+
+            if (!m_ParseSucceeded)
+            {
+                HIMII_CORE_ERROR("Failed to load scene '{0}' in background", m_Path.string());
+                m_StagingScene = nullptr;
+                m_State = SceneLoadState::Failed;
+                return;
+            }
+
+            HIMII_CORE_INFO("Scene '{0}' parsed on worker in {1:.2f} ms, {2} sprite textures pending", m_Path.string(),
+                            m_ParseMillis, m_PendingTextures.size());
+            RequestTextures();
+            m_State = SceneLoadState::LoadingAssets;
+        }
+
+        if (m_State == SceneLoadState::LoadingAssets)
+        {
+            m_ReadyTextureCount = CountReadyTextures();
+            if (m_ReadyTextureCount == (uint32_t)m_TextureHandles.size())
+                m_State = SceneLoadState::Ready;
+        }
+    }
+
+    Ref<Scene> AsyncSceneLoader::TakeScene()
+    {
+        if (m_State != SceneLoadState::Ready)
+            return nullptr;
+
+        m_State = SceneLoadState::Idle;
+        m_PendingTextures.clear();
+        m_TextureHandles.clear();
+        return std::move(m_StagingScene);
+    }
+
+    bool AsyncSceneLoader::AcknowledgeFailure()
+    {
+        if (m_State != SceneLoadState::Failed)
+            return false;
+
+        m_State = SceneLoadState::Idle;
+        m_PendingTextures.clear();
+        m_TextureHandles.clear();
+        return true;
+    }
+
+    float AsyncSceneLoader::GetProgress() const
+    {
+        switch (m_State)
+        {
+            case SceneLoadState::Idle:
+            case SceneLoadState::Failed:
+                return 0.0f;
+            case SceneLoadState::Parsing:
+            {
+                // 计数由工作线程写入；文档还没解析完时总数为 0
+                uint32_t count = m_ParseProgress.EntityCount.load(std::memory_order_relaxed);
+                if (count == 0)
+                    return 0.0f;
+                uint32_t loaded = m_ParseProgress.EntitiesLoaded.load(std::memory_order_relaxed);
+                return 0.3f * (float)std::min(loaded, count) / (float)count;
+            }
+            case SceneLoadState::LoadingAssets:
+                if (m_TextureHandles.empty())
+                    return 1.0f;
+                return 0.3f + 0.7f * (float)m_ReadyTextureCount / (float)m_TextureHandles.size();
+            case SceneLoadState::Ready:
+                return 1.0f;
+        }
+        return 0.0f;
+    }
+
+    void AsyncSceneLoader::RequestTextures()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        // 异步纹理加载开启时这里只创建占位纹理并排队，解码在 TextureStreamer 的工作线程，上传按帧预算进行
+        auto &registry = m_StagingScene->Registry();
+        std::unordered_set<AssetHandle> uniqueHandles;
+        for (auto &pending: m_PendingTextures)
+        {
+            auto *sprite = registry.try_get<SpriteRendererComponent>(pending.Entity);
+            if (!sprite)
+                continue;
+
+            AssetHandle handle = pending.Handle;
+            sprite->Texture = SceneSerializer::LoadSpriteTexture(handle, pending.Path);
+            sprite->TextureHandle = handle;
+            if (handle != 0 && uniqueHandles.insert(handle).second)
+                m_TextureHandles.push_back(handle);
+        }
+    }
+
+    uint32_t AsyncSceneLoader::CountReadyTextures() const
+    {
+        auto assetManager = Project::GetActive() ? Project::GetAssetManager() : nullptr;
+        if (!assetManager)
+            return (uint32_t)m_TextureHandles.size();
+
+        uint32_t ready = 0;
+        for (AssetHandle handle: m_TextureHandles)
+        {
+            TextureLoadState state = assetManager->GetTextureLoadState(handle);
+            if (state != TextureLoadState::Queued && state != TextureLoadState::Decoding &&
+                state != TextureLoadState::Uploading)
+                ++ready;
+        }
+        return ready;
+    }
+} // namespace Himii
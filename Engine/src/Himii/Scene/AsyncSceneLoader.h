@@ -0,0 +1,79 @@
+#pragma once
+#include "Himii/Core/ThreadPool.h"
+#include "Himii/Scene/Scene.h"
+#include "Himii/Scene/SceneSerializer.h"
+
+#include <atomic>
+#include <filesystem>
+
+namespace Himii
+{
+    enum class SceneLoadState : uint8_t {
+        Idle = 0,
+        Parsing,       // 工作线程反序列化到暂存场景
+        LoadingAssets, // 主线程已提交纹理请求，等待工作线程解码和分帧上传
+        Ready,         // 可以 TakeScene
+        Failed
+    };
+
+    // 后台加载场景：解析在工作线程写入暂存 Scene，纹理经 AssetManager 的 TextureStreamer 解码上传，
+    // 主线程每帧调用 Update 推进，全部就绪后 TakeScene 取走场景替换当前场景
+    class AsyncSceneLoader {
+    public:
+        AsyncSceneLoader();
+        ~AsyncSceneLoader();
+
+        AsyncSceneLoader(const AsyncSceneLoader &) = delete;
+        AsyncSceneLoader &operator=(const AsyncSceneLoader &) = delete;
+
+        // 正在加载时返回 false
+        bool Load(const std::filesystem::path &filepath);
+
+        // 主线程每帧调用
+        void Update();
+
+        // Ready 时返回场景并回到 Idle，否则返回 nullptr
+        Ref<Scene> TakeScene();
+
+        // Failed 时回到 Idle 并返回 true，调用方据此只处理一次失败
+        bool AcknowledgeFailure();
+
+        SceneLoadState GetState() const
+        {
+            return m_State;
+        }
+
+        bool IsLoading() const
+        {
+            return m_State == SceneLoadState::Parsing || m_State == SceneLoadState::LoadingAssets;
+        }
+
+        // 0~1，解析按已反序列化的实体数占前 30%，纹理就绪占后 70%
+        float GetProgress() const;
+
+        const std::filesystem::path &GetPath() const
+        {
+            return m_Path;
+        }
+
+    private:
+        void RequestTextures();
+        uint32_t CountReadyTextures() const;
+
+    private:
+        ThreadPool m_Worker{1};
+        std::filesystem::path m_Path;
+        SceneLoadState m_State = SceneLoadState::Idle;
+
+        Ref<Scene> m_StagingScene;
+        std::vector<PendingSpriteTexture> m_PendingTextures;
+        std::vector<AssetHandle> m_TextureHandles; // 去重后的纹理，用于统计进度
+        uint32_t m_ReadyTextureCount = 0;
+
+        // 工作线程完成后置位，主线程在 Update 中读取
+        std::atomic<bool> m_ParseFinished{false};
+        SceneLoadProgress m_ParseProgress;
+        bool m_ParseSucceeded = false;
+        float m_ParseMillis = 0.0f;
+    };
+} // namespace Himii
@@ -62,7 +62,11 @@ namespace Himii
     struct SpriteRendererComponent {
         glm::vec4 Color{1.0f, 1.0f, 1.0f, 1.0f};
         Ref<Texture2D> Texture{};
+        AssetHandle TextureHandle = 0; // 纹理资产，相同纹理的精灵共享同一个 Texture
         float TilingFactor = 1.0f;
+        // 纹理内的 UV 矩形，精灵表动画每帧更新，默认是整张纹理
+        glm::vec2 UVMin{0.0f, 0.0f};
+        glm::vec2 UVMax{1.0f, 1.0f};
 
         SpriteRendererComponent() = default;
         SpriteRendererComponent(const SpriteRendererComponent&) = default;
@@ -119,7 +123,15 @@ namespace Himii
         void *RuntimeBody = nullptr;
 
         Rigidbody2DComponent() = default;
-        Rigidbody2DComponent(const Rigidbody2DComponent &other) = default;
+        // 复制实体/场景时不共享原组件的刚体，由新场景按需重新创建
+        Rigidbody2DComponent(const Rigidbody2DComponent &other)
+        {
+            *this = other;
+            RuntimeBody = nullptr;
+        }
+        Rigidbody2DComponent(Rigidbody2DComponent &&) = default;
+        Rigidbody2DComponent &operator=(const Rigidbody2DComponent &) = default;
+        Rigidbody2DComponent &operator=(Rigidbody2DComponent &&) = default;
     };
 
     struct BoxCollider2DComponent
@@ -132,11 +144,26 @@ namespace Himii
         float Restitution = 0.0f;
         float RestitutionThreshold = 0.5f;
 
+        // 传感器只产生进入/离开事件，不参与碰撞响应
+        bool IsSensor = false;
+
+        // 碰撞过滤：所属层与可碰撞层，最终掩码还要与项目层矩阵取交集
+        uint32_t CategoryBits = 0x00000001;
+        uint32_t MaskBits = 0xFFFFFFFF;
+
         // 运行时存储 FixtureId
         void *RuntimeFixture = nullptr;
 
         BoxCollider2DComponent() = default;
-        BoxCollider2DComponent(const BoxCollider2DComponent &) = default;
+        // 与刚体相同，复制出的组件不持有原组件的形状
+        BoxCollider2DComponent(const BoxCollider2DComponent &other)
+        {
+            *this = other;
+            RuntimeFixture = nullptr;
+        }
+        BoxCollider2DComponent(BoxCollider2DComponent &&) = default;
+        BoxCollider2DComponent &operator=(const BoxCollider2DComponent &) = default;
+        BoxCollider2DComponent &operator=(BoxCollider2DComponent &&) = default;
     };
 
     struct CircleCollider2DComponent {
@@ -148,11 +175,26 @@ namespace Himii
         float Restitution = 0.0f;
         float RestitutionThreshold = 0.5f;
 
+        // 传感器只产生进入/离开事件，不参与碰撞响应
+        bool IsSensor = false;
+
+        // 碰撞过滤：所属层与可碰撞层，最终掩码还要与项目层矩阵取交集
+        uint32_t CategoryBits = 0x00000001;
+        uint32_t MaskBits = 0xFFFFFFFF;
+
         // 运行时存储 FixtureId
         void *RuntimeFixture = nullptr;
 
         CircleCollider2DComponent() = default;
-        CircleCollider2DComponent(const CircleCollider2DComponent &) = default;
+        // 与刚体相同，复制出的组件不持有原组件的形状
+        CircleCollider2DComponent(const CircleCollider2DComponent &other)
+        {
+            *this = other;
+            RuntimeFixture = nullptr;
+        }
+        CircleCollider2DComponent(CircleCollider2DComponent &&) = default;
+        CircleCollider2DComponent &operator=(const CircleCollider2DComponent &) = default;
+        CircleCollider2DComponent &operator=(CircleCollider2DComponent &&) = default;
     };
 
     struct SpriteAnimationComponent {
@@ -163,6 +205,10 @@ namespace Himii
         float FrameRate = 10.0f; // 默认 10 帧/秒
         bool Playing = true;
 
+        // Runtime：SpriteAnimationSystem 烘焙后的帧表索引
+        int32_t RuntimeClip = -1;
+        AssetHandle RuntimeClipHandle = 0;
+
         SpriteAnimationComponent() = default;
         SpriteAnimationComponent(const SpriteAnimationComponent &) = default;
     };
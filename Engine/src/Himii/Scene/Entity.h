@@ -44,6 +44,13 @@ namespace Himii
             return m_Scene->Registry().get<T>(m_EntityHandle);
         }
 
+        // 直接修改 GetComponent 返回的引用不会产生通知，修改后调用以触发 on_update（脏实体追踪）
+        template<typename T>
+        void PatchComponent()
+        {
+            m_Scene->Registry().patch<T>(m_EntityHandle);
+        }
+
         template<typename T>
         void RemoveComponent()
         {
@@ -6,7 +6,6 @@
 #include "Himii/Asset/AssetManager.h"
 #include "Himii/Project/Project.h"
 #include "Himii/Renderer/Renderer2D.h"
-#include "Himii/Scene/SpriteAnimation.h"
 #include "Himii/Scripting/ScriptEngine.h"
 #include "ScriptableEntity.h"
 
@@ -22,20 +21,10 @@ namespace Himii
 
     Scene::~Scene()
     {
+        // 同时断开物理信号，避免 registry 析构时回调到已销毁的世界
         if (b2World_IsValid(m_Box2DWorld))
-        {
-            b2DestroyWorld(m_Box2DWorld);
-        }
-    }
-
-    static void *ToPtr(b2BodyId id)
-    {
-        return reinterpret_cast<void *>(*reinterpret_cast<uintptr_t *>(&id));
-    }
-    static b2BodyId ToBodyId(void *ptr)
-    {
-        uintptr_t val = reinterpret_cast<uintptr_t>(ptr);
-        return *reinterpret_cast<b2BodyId *>(&val);
+            OnPhysics2DStop();
+        SetChangeTrackingEnabled(false);
     }
 
     Entity Scene::CreateEntityWithUUID(UUID uuid, const std::string &name)
@@ -87,6 +76,7 @@ namespace Himii
     {
         ScriptEngine::OnRuntimeStart(this);
         OnPhysics2DStart();
+        m_SpriteAnimationSystem.OnRuntimeStart(m_Registry);
         // 3. 实例化所有拥有 ScriptComponent 的实体
         {
             auto view = m_Registry.view<ScriptComponent>();
@@ -111,6 +101,7 @@ namespace Himii
     void Scene::OnRuntimeStop()
     {
         OnPhysics2DStop();
+        m_SpriteAnimationSystem.OnRuntimeStop();
         ScriptEngine::OnRuntimeStop();
     }
 
@@ -145,80 +136,15 @@ namespace Himii
         }
 
         // Animation Update
-        {
-            auto view = m_Registry.group<SpriteAnimationComponent, SpriteRendererComponent>();
-
-            // 获取 AssetManager
-            auto assetManager = Project::GetAssetManager();
-
-            for (auto e: view)
-            {
-                auto [animComponent, spriteComponent] = view.get<SpriteAnimationComponent, SpriteRendererComponent>(e);
-
-                // 确保有有效的动画资产句柄
-                if (animComponent.AnimationHandle != 0 && animComponent.Playing)
-                {
-                    // 从 AssetManager 获取动画数据
-                    if (assetManager->IsAssetHandleValid(animComponent.AnimationHandle))
-                    {
-                        Ref<SpriteAnimation> animation = std::static_pointer_cast<SpriteAnimation>(
-                                assetManager->GetAsset(animComponent.AnimationHandle));
-
-                        if (animation && animation->GetFrameCount() > 0)
-                        {
-                            // 计时器逻辑
-                            animComponent.Timer += ts;
-                            float frameDuration = 1.0f / animComponent.FrameRate;
-
-                            if (animComponent.Timer >= frameDuration)
-                            {
-                                animComponent.Timer -= frameDuration;
-                                animComponent.CurrentFrame =
-                                        (animComponent.CurrentFrame + 1) % animation->GetFrameCount();
-                            }
-
-                            // 获取当前帧的纹理句柄
-                            AssetHandle textureHandle = animation->GetFrame(animComponent.CurrentFrame);
-
-                            // 将纹理应用到 SpriteRenderer
-                            if (assetManager->IsAssetHandleValid(textureHandle))
-                            {
-                                Ref<Texture2D> texture =
-                                        std::static_pointer_cast<Texture2D>(assetManager->GetAsset(textureHandle));
-                                spriteComponent.Texture = texture;
-                            }
-                        }
-                    }
-                }
-            }
-        }
+        m_SpriteAnimationSystem.OnUpdate(m_Registry, ts);
 
         // Box2D 物理更新
         {
-            const int32_t subStepCount = 2;
-            b2World_Step(m_Box2DWorld, ts, subStepCount);
+            StepPhysics2D(ts);
 
-            auto view = m_Registry.view<Rigidbody2DComponent>();
-            for (auto e: view)
-            {
-                Entity entity = {e, this};
-                auto &transform = entity.GetComponent<TransformComponent>();
-                auto &rb2d = entity.GetComponent<Rigidbody2DComponent>();
-
-                if (rb2d.RuntimeBody)
-                {
-                    b2BodyId bodyId = ToBodyId(rb2d.RuntimeBody);
-                    if (b2Body_IsValid(bodyId))
-                    {
-                        b2Vec2 position = b2Body_GetPosition(bodyId);
-                        transform.Position.x = position.x;
-                        transform.Position.y = position.y;
-
-                        b2Rot rotation = b2Body_GetRotation(bodyId);
-                        transform.Rotation.z = b2Rot_GetAngle(rotation);
-                    }
-                }
-            }
+            // 整帧的碰撞事件只跨一次托管边界
+            if (!m_Physics2DEvents.Empty())
+                ScriptEngine::OnPhysics2DEvents(m_Physics2DEvents);
         }
 
         Camera *mainCamera = nullptr;
@@ -259,32 +185,7 @@ namespace Himii
     void Scene::OnUpdateSimulation(Timestep ts, EditorCamera &camera)
     {
         // Box2D 物理更新
-        {
-            const int32_t subStepCount = 2;
-            b2World_Step(m_Box2DWorld, ts, subStepCount);
-
-            auto view = m_Registry.view<Rigidbody2DComponent>();
-            for (auto e: view)
-            {
-                Entity entity = {e, this};
-                auto &transform = entity.GetComponent<TransformComponent>();
-                auto &rb2d = entity.GetComponent<Rigidbody2DComponent>();
-
-                if (rb2d.RuntimeBody)
-                {
-                    b2BodyId bodyId = ToBodyId(rb2d.RuntimeBody);
-                    if (b2Body_IsValid(bodyId))
-                    {
-                        b2Vec2 position = b2Body_GetPosition(bodyId);
-                        transform.Position.x = position.x;
-                        transform.Position.y = position.y;
-
-                        b2Rot rotation = b2Body_GetRotation(bodyId);
-                        transform.Rotation.z = b2Rot_GetAngle(rotation);
-                    }
-                }
-            }
-        }
+        StepPhysics2D(ts);
 
         RenderScene(camera);
     }
@@ -419,6 +320,93 @@ namespace Himii
         }
     }
 
+    template<typename T>
+    void Scene::ConnectChangeTracking(bool connect)
+    {
+        if (connect)
+        {
+            m_Registry.on_construct<T>().template connect<&Scene::OnTrackedComponentChanged>(*this);
+            m_Registry.on_update<T>().template connect<&Scene::OnTrackedComponentChanged>(*this);
+            m_Registry.on_destroy<T>().template connect<&Scene::OnTrackedComponentChanged>(*this);
+        }
+        else
+        {
+            m_Registry.on_construct<T>().template disconnect<&Scene::OnTrackedComponentChanged>(*this);
+            m_Registry.on_update<T>().template disconnect<&Scene::OnTrackedComponentChanged>(*this);
+            m_Registry.on_destroy<T>().template disconnect<&Scene::OnTrackedComponentChanged>(*this);
+        }
+    }
+
+    void Scene::SetChangeTrackingEnabled(bool enabled)
+    {
+        if (enabled == m_ChangeTrackingEnabled)
+            return;
+        m_ChangeTrackingEnabled = enabled;
+
+        // 只跟踪会被序列化的组件；编辑器直接修改组件引用时需要调用 Entity::PatchComponent 触发 on_update
+        ConnectChangeTracking<TagComponent>(enabled);
+        ConnectChangeTracking<TransformComponent>(enabled);
+        ConnectChangeTracking<CameraComponent>(enabled);
+        ConnectChangeTracking<ScriptComponent>(enabled);
+        ConnectChangeTracking<SpriteRendererComponent>(enabled);
+        ConnectChangeTracking<CircleRendererComponent>(enabled);
+        ConnectChangeTracking<Rigidbody2DComponent>(enabled);
+        ConnectChangeTracking<BoxCollider2DComponent>(enabled);
+        ConnectChangeTracking<CircleCollider2DComponent>(enabled);
+        ConnectChangeTracking<SpriteAnimationComponent>(enabled);
+
+        if (enabled)
+            m_Registry.on_destroy<IDComponent>().connect<&Scene::OnTrackedEntityDestroyed>(*this);
+        else
+            m_Registry.on_destroy<IDComponent>().disconnect<&Scene::OnTrackedEntityDestroyed>(*this);
+
+        m_DirtyEntities.clear();
+        m_RemovedEntities.clear();
+    }
+
+    void Scene::OnTrackedComponentChanged(entt::registry &registry, entt::entity entity)
+    {
+        // 实体销毁时 IDComponent 可能已先被移除，此时由 OnTrackedEntityDestroyed 记录
+        if (auto *id = registry.try_get<IDComponent>(entity))
+            m_DirtyEntities.insert(id->ID);
+    }
+
+    void Scene::OnTrackedEntityDestroyed(entt::registry &registry, entt::entity entity)
+    {
+        UUID id = registry.get<IDComponent>(entity).ID;
+        m_DirtyEntities.erase(id);
+        m_RemovedEntities.push_back(id);
+    }
+
+    void Scene::ConsumeChanges(std::vector<UUID> &dirtyEntities, std::vector<UUID> &removedEntities)
+    {
+        dirtyEntities.assign(m_DirtyEntities.begin(), m_DirtyEntities.end());
+        removedEntities = std::move(m_RemovedEntities);
+        m_DirtyEntities.clear();
+        m_RemovedEntities.clear();
+    }
+
+    std::vector<AssetHandle> Scene::CollectAssetDependencies()
+    {
+        std::vector<AssetHandle> dependencies;
+        std::unordered_set<AssetHandle> visited;
+        auto add = [&](AssetHandle handle)
+        {
+            if (handle != 0 && visited.insert(handle).second)
+                dependencies.push_back(handle);
+        };
+
+        auto sprites = m_Registry.view<SpriteRendererComponent>();
+        for (auto e: sprites)
+            add(sprites.get<SpriteRendererComponent>(e).TextureHandle);
+
+        auto animations = m_Registry.view<SpriteAnimationComponent>();
+        for (auto e: animations)
+            add(animations.get<SpriteAnimationComponent>(e).AnimationHandle);
+
+        return dependencies;
+    }
+
     Entity Scene::GetPrimaryCameraEntity()
     {
         auto view = m_Registry.view<CameraComponent>();
@@ -433,91 +421,521 @@ namespace Himii
         return {};
     }
 
+    static b2Filter MakeShapeFilter(uint32_t categoryBits, uint32_t maskBits, bool filteringEnabled)
+    {
+        b2Filter filter = b2DefaultFilter();
+        if (!filteringEnabled)
+            return filter;
+
+        filter.categoryBits = categoryBits;
+        filter.maskBits = maskBits;
+        if (Project::GetActive())
+            filter.maskBits &= Project::GetConfig().Physics2DLayers.GetMaskForCategory(categoryBits);
+        return filter;
+    }
+
     void Scene::OnPhysics2DStart()
     {
         b2WorldDef worldDef = b2DefaultWorldDef();
         worldDef.gravity = b2Vec2{0.0f, -9.8f};
         m_Box2DWorld = b2CreateWorld(&worldDef);
 
+        // 运行期间新增/删除的刚体和碰撞体通过信号增量维护
+        m_Registry.on_construct<Rigidbody2DComponent>().connect<&Scene::OnRigidbody2DConstruct>(*this);
+        m_Registry.on_destroy<Rigidbody2DComponent>().connect<&Scene::OnRigidbody2DDestroy>(*this);
+        m_Registry.on_construct<BoxCollider2DComponent>().connect<&Scene::OnCollider2DConstruct>(*this);
+        m_Registry.on_destroy<BoxCollider2DComponent>().connect<&Scene::OnBoxCollider2DDestroy>(*this);
+        m_Registry.on_construct<CircleCollider2DComponent>().connect<&Scene::OnCollider2DConstruct>(*this);
+        m_Registry.on_destroy<CircleCollider2DComponent>().connect<&Scene::OnCircleCollider2DDestroy>(*this);
+
         auto view = m_Registry.view<Rigidbody2DComponent>();
+        if (m_Physics2DBodiesPerFrame > 0)
+        {
+            // 延迟创建：由 FlushPendingPhysics2D 每帧按预算创建
+            m_DeferredPhysics2DBodies.assign(view.begin(), view.end());
+            return;
+        }
+
         for (auto e: view)
+            CreatePhysics2DBody(e);
+    }
+
+    void Scene::OnPhysics2DStop()
+    {
+        m_Registry.on_construct<Rigidbody2DComponent>().disconnect(this);
+        m_Registry.on_destroy<Rigidbody2DComponent>().disconnect(this);
+        m_Registry.on_construct<BoxCollider2DComponent>().disconnect(this);
+        m_Registry.on_destroy<BoxCollider2DComponent>().disconnect(this);
+        m_Registry.on_construct<CircleCollider2DComponent>().disconnect(this);
+        m_Registry.on_destroy<CircleCollider2DComponent>().disconnect(this);
+
+        m_PendingPhysics2DBodies.clear();
+        m_PendingPhysics2DShapes.clear();
+        m_DeferredPhysics2DBodies.clear();
+        m_Physics2DShapeEntities.clear();
+        m_RetiredPhysics2DShapes.clear();
+
+        // 世界销毁后旧 id 可能与下一次运行的新刚体/形状重合，必须清空
+        for (auto e: m_Registry.view<Rigidbody2DComponent>())
+            m_Registry.get<Rigidbody2DComponent>(e).RuntimeBody = nullptr;
+        for (auto e: m_Registry.view<BoxCollider2DComponent>())
+            m_Registry.get<BoxCollider2DComponent>(e).RuntimeFixture = nullptr;
+        for (auto e: m_Registry.view<CircleCollider2DComponent>())
+            m_Registry.get<CircleCollider2DComponent>(e).RuntimeFixture = nullptr;
+
+        if (b2World_IsValid(m_Box2DWorld))
+        {
+            b2DestroyWorld(m_Box2DWorld);
+            m_Box2DWorld = b2_nullWorldId; // Reset ID
+        }
+        m_Physics2DEvents.Clear();
+    }
+
+    void Scene::CreatePhysics2DBody(entt::entity e)
+    {
+        if (!m_Registry.valid(e))
+            return;
+
+        auto *rigidbody2D = m_Registry.try_get<Rigidbody2DComponent>(e);
+        // 已创建过（同一帧重复入队）或组件已被移除
+        if (!rigidbody2D || OwnsPhysics2DBody(e, rigidbody2D->RuntimeBody))
+            return;
+
+        Entity entity = {e, this};
+        auto &transform = entity.GetComponent<TransformComponent>();
+
+        b2BodyDef bodyDef = b2DefaultBodyDef();
+
+        switch (rigidbody2D->Type)
         {
-            Entity entity = {e, this};
-            auto &transform = entity.GetComponent<TransformComponent>();
-            auto &rigidbody2D = entity.GetComponent<Rigidbody2DComponent>();
+            case Rigidbody2DComponent::BodyType::Static:
+                bodyDef.type = b2BodyType::b2_staticBody;
+                break;
+            case Rigidbody2DComponent::BodyType::Dynamic:
+                bodyDef.type = b2BodyType::b2_dynamicBody;
+                break;
+            case Rigidbody2DComponent::BodyType::Kinematic:
+                bodyDef.type = b2BodyType::b2_kinematicBody;
+                break;
+        }
+
+        bodyDef.position = {transform.Position.x, transform.Position.y};
+        bodyDef.rotation = b2MakeRot(transform.Rotation.z);
+        bodyDef.fixedRotation = rigidbody2D->FixedRotation;
+        bodyDef.userData = (void *)(uintptr_t)(uint64_t)entity.GetUUID(); // 存储 Entity UUID，事件回调直接使用
 
-            b2BodyDef bodyDef = b2DefaultBodyDef();
+        b2BodyId bodyId = b2CreateBody(m_Box2DWorld, &bodyDef);
+        rigidbody2D->RuntimeBody = Physics2DUtils::BodyIdToPtr(bodyId);
 
-            switch (rigidbody2D.Type)
+        CreatePhysics2DShapes(e);
+    }
+
+    void Scene::CreatePhysics2DShapes(entt::entity e)
+    {
+        if (!m_Registry.valid(e))
+            return;
+
+        auto *rigidbody2D = m_Registry.try_get<Rigidbody2DComponent>(e);
+        if (!rigidbody2D)
+            return;
+
+        if (!OwnsPhysics2DBody(e, rigidbody2D->RuntimeBody))
+            return;
+        b2BodyId bodyId = Physics2DUtils::PtrToBodyId(rigidbody2D->RuntimeBody);
+
+        auto &transform = m_Registry.get<TransformComponent>(e);
+        UUID entityID = m_Registry.get<IDComponent>(e).ID;
+
+        auto *bc2d = m_Registry.try_get<BoxCollider2DComponent>(e);
+        if (bc2d && !OwnsPhysics2DShape(bodyId, bc2d->RuntimeFixture))
+        {
+            b2ShapeDef shapeDef = b2DefaultShapeDef();
+            shapeDef.density = bc2d->Density;
+            shapeDef.material.friction = bc2d->Friction;
+            shapeDef.material.restitution = bc2d->Restitution;
+            shapeDef.material.rollingResistance = bc2d->RestitutionThreshold;
+            shapeDef.isSensor = bc2d->IsSensor;
+            shapeDef.filter = MakeShapeFilter(bc2d->CategoryBits, bc2d->MaskBits, m_Physics2DFilteringEnabled);
+            shapeDef.enableSensorEvents = true;
+            shapeDef.enableContactEvents = true;
+            shapeDef.enableHitEvents = true;
+            shapeDef.userData = (void *)(uintptr_t)(uint64_t)entityID;
+
+            // Box2D v3 b2MakeBox 参数是半宽/半高
+            float hx = bc2d->Size.x * transform.Scale.x * 0.5f;
+            float hy = bc2d->Size.y * transform.Scale.y * 0.5f;
+
+            b2Polygon polygon = b2MakeBox(hx, hy);
+            // 应用 Offset
+            polygon.centroid = {bc2d->Offset.x, bc2d->Offset.y};
+
+            b2ShapeId shapeId = b2CreatePolygonShape(bodyId, &shapeDef, &polygon);
+            bc2d->RuntimeFixture = Physics2DUtils::ShapeIdToPtr(shapeId);
+            RegisterPhysics2DShape(shapeId, entityID);
+        }
+
+        auto *cc2d = m_Registry.try_get<CircleCollider2DComponent>(e);
+        if (cc2d && !OwnsPhysics2DShape(bodyId, cc2d->RuntimeFixture))
+        {
+            b2ShapeDef shapeDef = b2DefaultShapeDef();
+            shapeDef.density = cc2d->Density;
+            shapeDef.material.friction = cc2d->Friction;
+            shapeDef.material.restitution = cc2d->Restitution;
+            shapeDef.material.rollingResistance = cc2d->RestitutionThreshold;
+            shapeDef.isSensor = cc2d->IsSensor;
+            shapeDef.filter = MakeShapeFilter(cc2d->CategoryBits, cc2d->MaskBits, m_Physics2DFilteringEnabled);
+            shapeDef.enableSensorEvents = true;
+            shapeDef.enableContactEvents = true;
+            shapeDef.enableHitEvents = true;
+            shapeDef.userData = (void *)(uintptr_t)(uint64_t)entityID;
+
+            b2Circle circle;
+            // 应用 Offset
+            circle.center = {cc2d->Offset.x * transform.Scale.x, cc2d->Offset.y * transform.Scale.y};
+            float maxScale = std::max(transform.Scale.x, transform.Scale.y);
+            circle.radius = cc2d->Radius * maxScale;
+
+            b2ShapeId shapeId = b2CreateCircleShape(bodyId, &shapeDef, &circle);
+            cc2d->RuntimeFixture = Physics2DUtils::ShapeIdToPtr(shapeId);
+            RegisterPhysics2DShape(shapeId, entityID);
+        }
+    }
+
+    void Scene::FlushPendingPhysics2D()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        // 本帧新增的刚体/碰撞体统一在物理步之前创建，此时组件的字段已经由调用方填好
+        for (size_t i = 0; i < m_PendingPhysics2DBodies.size(); ++i)
+            CreatePhysics2DBody(m_PendingPhysics2DBodies[i]);
+        m_PendingPhysics2DBodies.clear();
+
+        for (size_t i = 0; i < m_PendingPhysics2DShapes.size(); ++i)
+            CreatePhysics2DShapes(m_PendingPhysics2DShapes[i]);
+        m_PendingPhysics2DShapes.clear();
+
+        // 开始运行时延迟创建的刚体，每帧最多创建 m_Physics2DBodiesPerFrame 个
+        if (!m_DeferredPhysics2DBodies.empty())
+        {
+            size_t count = std::min<size_t>(m_DeferredPhysics2DBodies.size(),
+                                            m_Physics2DBodiesPerFrame > 0 ? m_Physics2DBodiesPerFrame : SIZE_MAX);
+            for (size_t i = 0; i < count; ++i)
+                CreatePhysics2DBody(m_DeferredPhysics2DBodies[i]);
+            m_DeferredPhysics2DBodies.erase(m_DeferredPhysics2DBodies.begin(),
+                                            m_DeferredPhysics2DBodies.begin() + count);
+        }
+    }
+
+    // 只有本场景当前物理世界中、userData 指向该实体的刚体才算已创建，复制来的或上一次运行残留的 id 都不算
+    bool Scene::OwnsPhysics2DBody(entt::entity e, void *runtimeBody) const
+    {
+        b2BodyId bodyId = Physics2DUtils::PtrToBodyId(runtimeBody);
+        if (!runtimeBody || !b2World_IsValid(m_Box2DWorld) || !b2Body_IsValid(bodyId))
+            return false;
+        if (!B2_ID_EQUALS(b2Body_GetWorld(bodyId), m_Box2DWorld))
+            return false;
+        return (uint64_t)(uintptr_t)b2Body_GetUserData(bodyId) == (uint64_t)m_Registry.get<IDComponent>(e).ID;
+    }
+
+    bool Scene::OwnsPhysics2DShape(b2BodyId bodyId, void *runtimeFixture) const
+    {
+        b2ShapeId shapeId = Physics2DUtils::PtrToShapeId(runtimeFixture);
+        if (!runtimeFixture || !b2Shape_IsValid(shapeId))
+            return false;
+        return B2_ID_EQUALS(b2Shape_GetBody(shapeId), bodyId);
+    }
+
+    void Scene::OnRigidbody2DConstruct(entt::registry &registry, entt::entity entity)
+    {
+        m_PendingPhysics2DBodies.push_back(entity);
+    }
+
+    void Scene::OnRigidbody2DDestroy(entt::registry &registry, entt::entity entity)
+    {
+        auto &rb2d = registry.get<Rigidbody2DComponent>(entity);
+        b2BodyId bodyId = Physics2DUtils::PtrToBodyId(rb2d.RuntimeBody);
+        // 销毁刚体会同时销毁其上的所有形状
+        if (b2Body_IsValid(bodyId))
+            b2DestroyBody(bodyId);
+        rb2d.RuntimeBody = nullptr;
+
+        if (auto *bc2d = registry.try_get<BoxCollider2DComponent>(entity))
+        {
+            RetirePhysics2DShape(bc2d->RuntimeFixture);
+            bc2d->RuntimeFixture = nullptr;
+        }
+        if (auto *cc2d = registry.try_get<CircleCollider2DComponent>(entity))
+        {
+            RetirePhysics2DShape(cc2d->RuntimeFixture);
+            cc2d->RuntimeFixture = nullptr;
+        }
+    }
+
+    void Scene::OnCollider2DConstruct(entt::registry &registry, entt::entity entity)
+    {
+        // 没有刚体的碰撞体等刚体创建时一并处理
+        if (registry.all_of<Rigidbody2DComponent>(entity))
+            m_PendingPhysics2DShapes.push_back(entity);
+    }
+
+    void Scene::OnBoxCollider2DDestroy(entt::registry &registry, entt::entity entity)
+    {
+        auto &bc2d = registry.get<BoxCollider2DComponent>(entity);
+        b2ShapeId shapeId = Physics2DUtils::PtrToShapeId(bc2d.RuntimeFixture);
+        if (b2Shape_IsValid(shapeId))
+            b2DestroyShape(shapeId, true);
+        RetirePhysics2DShape(bc2d.RuntimeFixture);
+        bc2d.RuntimeFixture = nullptr;
+    }
+
+    void Scene::OnCircleCollider2DDestroy(entt::registry &registry, entt::entity entity)
+    {
+        auto &cc2d = registry.get<CircleCollider2DComponent>(entity);
+        b2ShapeId shapeId = Physics2DUtils::PtrToShapeId(cc2d.RuntimeFixture);
+        if (b2Shape_IsValid(shapeId))
+            b2DestroyShape(shapeId, true);
+        RetirePhysics2DShape(cc2d.RuntimeFixture);
+        cc2d.RuntimeFixture = nullptr;
+    }
+
+    void Scene::StepPhysics2D(Timestep ts)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!b2World_IsValid(m_Box2DWorld))
+            return;
+
+        FlushPendingPhysics2D();
+
+        // 在这之前销毁的形状，其结束事件在本次物理步之后上报，收集完再移除映射
+        std::vector<uint64_t> retiredShapes = std::move(m_RetiredPhysics2DShapes);
+        m_RetiredPhysics2DShapes.clear();
+
+        const int32_t subStepCount = 2;
+        b2World_Step(m_Box2DWorld, ts, subStepCount);
+        CollectPhysics2DEvents();
+        for (uint64_t key: retiredShapes)
+            m_Physics2DShapeEntities.erase(key);
+        UpdatePhysics2DStats();
+
+        auto view = m_Registry.view<Rigidbody2DComponent, TransformComponent>();
+        for (auto e: view)
+        {
+            auto [rb2d, transform] = view.get<Rigidbody2DComponent, TransformComponent>(e);
+            if (!rb2d.RuntimeBody)
+                continue;
+
+            b2BodyId bodyId = Physics2DUtils::PtrToBodyId(rb2d.RuntimeBody);
+            if (b2Body_IsValid(bodyId))
             {
-                case Rigidbody2DComponent::BodyType::Static:
-                    bodyDef.type = b2BodyType::b2_staticBody;
-                    break;
-                case Rigidbody2DComponent::BodyType::Dynamic:
-                    bodyDef.type = b2BodyType::b2_dynamicBody;
-                    break;
-                case Rigidbody2DComponent::BodyType::Kinematic:
-                    bodyDef.type = b2BodyType::b2_kinematicBody;
-                    break;
+                b2Vec2 position = b2Body_GetPosition(bodyId);
+                transform.Position.x = position.x;
+                transform.Position.y = position.y;
+
+                b2Rot rotation = b2Body_GetRotation(bodyId);
+                transform.Rotation.z = b2Rot_GetAngle(rotation);
             }
+        }
+    }
 
-            bodyDef.position = {transform.Position.x, transform.Position.y};
-            bodyDef.rotation = b2MakeRot(transform.Rotation.z);
-            bodyDef.fixedRotation = rigidbody2D.FixedRotation;
-            bodyDef.userData = (void *)(uintptr_t)(uint32_t)entity; // 存储 Entity ID
+    bool Scene::SavePhysics2DSnapshot(Physics2DSnapshot &snapshot)
+    {
+        HIMII_PROFILE_FUNCTION();
 
-            b2BodyId bodyId = b2CreateBody(m_Box2DWorld, &bodyDef);
-            rigidbody2D.RuntimeBody = ToPtr(bodyId);
+        snapshot.Bodies.clear();
+        if (!b2World_IsValid(m_Box2DWorld))
+            return false;
 
-            // 3. 添加碰撞体
-            if (entity.HasComponent<BoxCollider2DComponent>())
-            {
-                auto &bc2d = entity.GetComponent<BoxCollider2DComponent>();
+        auto view = m_Registry.view<Rigidbody2DComponent>();
+        snapshot.Bodies.reserve(view.size());
+        for (auto e: view)
+        {
+            const auto &rb2d = view.get<Rigidbody2DComponent>(e);
+            b2BodyId bodyId = Physics2DUtils::PtrToBodyId(rb2d.RuntimeBody);
+            if (!b2Body_IsValid(bodyId))
+                continue;
 
-                b2ShapeDef shapeDef = b2DefaultShapeDef();
-                shapeDef.density = bc2d.Density;
-                shapeDef.material.friction = bc2d.Friction;
-                shapeDef.material.restitution = bc2d.Restitution;
-                shapeDef.material.rollingResistance = bc2d.RestitutionThreshold;
+            Physics2DBodyState state;
+            state.Body = bodyId;
+            state.Entity = (uint32_t)e;
+            b2Transform xf = b2Body_GetTransform(bodyId);
+            state.Position = xf.p;
+            state.Rotation = xf.q;
+            state.LinearVelocity = b2Body_GetLinearVelocity(bodyId);
+            state.AngularVelocity = b2Body_GetAngularVelocity(bodyId);
+            if (b2Body_IsAwake(bodyId))
+                state.Flags |= Physics2DBodyState::Awake;
+            if (b2Body_IsEnabled(bodyId))
+                state.Flags |= Physics2DBodyState::Enabled;
+
+            snapshot.Bodies.push_back(state);
+        }
+        return true;
+    }
+
+    uint32_t Scene::RestorePhysics2DSnapshot(const Physics2DSnapshot &snapshot)
+    {
+        HIMII_PROFILE_FUNCTION();
 
-                // Box2D v3 b2MakeBox 参数是半宽/半高
-                float hx = bc2d.Size.x * transform.Scale.x * 0.5f;
-                float hy = bc2d.Size.y * transform.Scale.y * 0.5f;
+        if (!b2World_IsValid(m_Box2DWorld))
+            return 0;
 
-                b2Polygon polygon = b2MakeBox(hx, hy);
-                // 应用 Offset
-                polygon.centroid = {bc2d.Offset.x, bc2d.Offset.y};
+        uint32_t restored = 0;
+        for (const auto &state: snapshot.Bodies)
+        {
+            // 快照之后销毁的实体/刚体直接跳过
+            entt::entity e = (entt::entity)state.Entity;
+            if (!b2Body_IsValid(state.Body) || !m_Registry.valid(e))
+                continue;
 
-                b2CreatePolygonShape(bodyId, &shapeDef, &polygon);
+            bool enabled = (state.Flags & Physics2DBodyState::Enabled) != 0;
+            if (b2Body_IsEnabled(state.Body) != enabled)
+            {
+                if (enabled)
+                    b2Body_Enable(state.Body);
+                else
+                    b2Body_Disable(state.Body);
             }
 
-            if (entity.HasComponent<CircleCollider2DComponent>())
+            b2Body_SetTransform(state.Body, state.Position, state.Rotation);
+            b2Body_SetLinearVelocity(state.Body, state.LinearVelocity);
+            b2Body_SetAngularVelocity(state.Body, state.AngularVelocity);
+            b2Body_SetAwake(state.Body, (state.Flags & Physics2DBodyState::Awake) != 0);
+
+            // 同步关联的 Transform，保证恢复后这一帧渲染的就是快照状态
+            if (auto *transform = m_Registry.try_get<TransformComponent>(e))
             {
-                auto &cc2d = entity.GetComponent<CircleCollider2DComponent>();
+                transform->Position.x = state.Position.x;
+                transform->Position.y = state.Position.y;
+                transform->Rotation.z = b2Rot_GetAngle(state.Rotation);
+            }
+            ++restored;
+        }
 
-                b2ShapeDef shapeDef = b2DefaultShapeDef();
-                shapeDef.density = cc2d.Density;
-                shapeDef.material.friction = cc2d.Friction;
-                shapeDef.material.restitution = cc2d.Restitution;
-                shapeDef.material.rollingResistance = cc2d.RestitutionThreshold;
+        // 快照之前的事件不应再派发
+        m_Physics2DEvents.Clear();
+        return restored;
+    }
 
-                b2Circle circle;
-                // 应用 Offset
-                circle.center = {cc2d.Offset.x * transform.Scale.x, cc2d.Offset.y * transform.Scale.y};
-                float maxScale = std::max(transform.Scale.x, transform.Scale.y);
-                circle.radius = cc2d.Radius * maxScale;
+    void Scene::SetPhysics2DFilteringEnabled(bool enabled)
+    {
+        if (m_Physics2DFilteringEnabled == enabled)
+            return;
 
-                b2CreateCircleShape(bodyId, &shapeDef, &circle);
-            }
+        m_Physics2DFilteringEnabled = enabled;
+        if (!b2World_IsValid(m_Box2DWorld))
+            return;
+
+        // 运行中切换：重设所有形状的过滤器，Box2D 会在下一步重新建立接触
+        auto boxView = m_Registry.view<BoxCollider2DComponent>();
+        for (auto e: boxView)
+        {
+            auto &bc2d = boxView.get<BoxCollider2DComponent>(e);
+            b2ShapeId shapeId = Physics2DUtils::PtrToShapeId(bc2d.RuntimeFixture);
+            if (b2Shape_IsValid(shapeId))
+                b2Shape_SetFilter(shapeId, MakeShapeFilter(bc2d.CategoryBits, bc2d.MaskBits, enabled));
+        }
+        auto circleView = m_Registry.view<CircleCollider2DComponent>();
+        for (auto e: circleView)
+        {
+            auto &cc2d = circleView.get<CircleCollider2DComponent>(e);
+            b2ShapeId shapeId = Physics2DUtils::PtrToShapeId(cc2d.RuntimeFixture);
+            if (b2Shape_IsValid(shapeId))
+                b2Shape_SetFilter(shapeId, MakeShapeFilter(cc2d.CategoryBits, cc2d.MaskBits, enabled));
         }
     }
 
-    void Scene::OnPhysics2DStop()
+    void Scene::UpdatePhysics2DStats()
     {
-        if (b2World_IsValid(m_Box2DWorld))
+        b2Counters counters = b2World_GetCounters(m_Box2DWorld);
+        m_Physics2DStats.BodyCount = counters.bodyCount;
+        m_Physics2DStats.ShapeCount = counters.shapeCount;
+        m_Physics2DStats.ContactPairCount = counters.contactCount;
+        if (m_Physics2DFilteringEnabled)
+            m_Physics2DStats.FilteredPairCount = counters.contactCount;
+        else
+            m_Physics2DStats.UnfilteredPairCount = counters.contactCount;
+    }
+
+    void Scene::RegisterPhysics2DShape(b2ShapeId shapeId, UUID entityID)
+    {
+        m_Physics2DShapeEntities[(uint64_t)(uintptr_t)Physics2DUtils::ShapeIdToPtr(shapeId)] = entityID;
+    }
+
+    void Scene::RetirePhysics2DShape(void *runtimeFixture)
+    {
+        if (runtimeFixture)
+            m_RetiredPhysics2DShapes.push_back((uint64_t)(uintptr_t)runtimeFixture);
+    }
+
+    // 形状 userData 中的 UUID；结束事件中的形状可能已经被销毁，此时查创建时记录的映射
+    uint64_t Scene::GetShapeEntityID(b2ShapeId shapeId) const
+    {
+        if (b2Shape_IsValid(shapeId))
+            return (uint64_t)(uintptr_t)b2Shape_GetUserData(shapeId);
+
+        auto it = m_Physics2DShapeEntities.find((uint64_t)(uintptr_t)Physics2DUtils::ShapeIdToPtr(shapeId));
+        return it != m_Physics2DShapeEntities.end() ? (uint64_t)it->second : 0;
+    }
+
+    void Scene::CollectPhysics2DEvents()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        m_Physics2DEvents.Clear();
+
+        b2ContactEvents contactEvents = b2World_GetContactEvents(m_Box2DWorld);
+        for (int i = 0; i < contactEvents.beginCount; ++i)
         {
-            b2DestroyWorld(m_Box2DWorld);
-            m_Box2DWorld = {0}; // Reset ID
+            const b2ContactBeginTouchEvent &event = contactEvents.beginEvents[i];
+            ContactEvent2D e;
+            e.EntityA = GetShapeEntityID(event.shapeIdA);
+            e.EntityB = GetShapeEntityID(event.shapeIdB);
+            if (e.EntityA && e.EntityB)
+                m_Physics2DEvents.BeginEvents.push_back(e);
+        }
+        for (int i = 0; i < contactEvents.endCount; ++i)
+        {
+            const b2ContactEndTouchEvent &event = contactEvents.endEvents[i];
+            ContactEvent2D e;
+            e.EntityA = GetShapeEntityID(event.shapeIdA);
+            e.EntityB = GetShapeEntityID(event.shapeIdB);
+            if (e.EntityA && e.EntityB)
+                m_Physics2DEvents.EndEvents.push_back(e);
+        }
+        for (int i = 0; i < contactEvents.hitCount; ++i)
+        {
+            const b2ContactHitEvent &event = contactEvents.hitEvents[i];
+            ContactHitEvent2D e;
+            e.EntityA = GetShapeEntityID(event.shapeIdA);
+            e.EntityB = GetShapeEntityID(event.shapeIdB);
+            e.Point = {event.point.x, event.point.y};
+            e.Normal = {event.normal.x, event.normal.y};
+            e.ApproachSpeed = event.approachSpeed;
+            if (e.EntityA && e.EntityB)
+                m_Physics2DEvents.HitEvents.push_back(e);
+        }
+
+        b2SensorEvents sensorEvents = b2World_GetSensorEvents(m_Box2DWorld);
+        for (int i = 0; i < sensorEvents.beginCount; ++i)
+        {
+            const b2SensorBeginTouchEvent &event = sensorEvents.beginEvents[i];
+            ContactEvent2D e;
+            e.EntityA = GetShapeEntityID(event.sensorShapeId);
+            e.EntityB = GetShapeEntityID(event.visitorShapeId);
+            e.IsSensor = 1;
+            if (e.EntityA && e.EntityB)
+                m_Physics2DEvents.BeginEvents.push_back(e);
+        }
+        for (int i = 0; i < sensorEvents.endCount; ++i)
+        {
+            const b2SensorEndTouchEvent &event = sensorEvents.endEvents[i];
+            ContactEvent2D e;
+            e.EntityA = GetShapeEntityID(event.sensorShapeId);
+            e.EntityB = GetShapeEntityID(event.visitorShapeId);
+            e.IsSensor = 1;
+            if (e.EntityA && e.EntityB)
+                m_Physics2DEvents.EndEvents.push_back(e);
         }
     }
 
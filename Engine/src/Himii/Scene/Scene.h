@@ -3,9 +3,13 @@
 #include <glm/glm.hpp>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include "Himii/Core/Timestep.h"
 #include "Himii/Core/UUID.h"
+#include "Himii/Asset/Asset.h"
+#include "Himii/Physics/Physics2D.h"
 #include "Himii/Renderer/EditorCamera.h"
+#include "Himii/Scene/SpriteAnimationSystem.h"
 
 #include "box2d/box2d.h"
 
@@ -60,6 +64,42 @@ namespace Himii
 
         Entity GetPrimaryCameraEntity();
 
+        // 场景直接引用的资产（精灵纹理、动画），去重；动画引用的帧纹理由 AssetManager::PreloadAssets 展开
+        std::vector<AssetHandle> CollectAssetDependencies();
+
+        // 单步推进物理并把刚体位姿写回 Transform，回滚重算时可脱离渲染单独调用
+        void StepPhysics2D(Timestep ts);
+
+        // 保存/原地恢复所有刚体状态及对应的 Transform，返回恢复的刚体数
+        bool SavePhysics2DSnapshot(Physics2DSnapshot &snapshot);
+        uint32_t RestorePhysics2DSnapshot(const Physics2DSnapshot &snapshot);
+
+        // 大场景开始运行时按帧分批创建刚体，0 表示开始时全部创建
+        void SetPhysics2DBodiesPerFrame(uint32_t count)
+        {
+            m_Physics2DBodiesPerFrame = count;
+        }
+
+        // 关闭时忽略碰撞层，用于对比过滤前后的形状对数量
+        void SetPhysics2DFilteringEnabled(bool enabled);
+        bool IsPhysics2DFilteringEnabled() const
+        {
+            return m_Physics2DFilteringEnabled;
+        }
+        const Physics2DStats &GetPhysics2DStats() const
+        {
+            return m_Physics2DStats;
+        }
+
+        // 编辑器增量保存用：记录组件被添加、patch 或移除的实体，以及被销毁的实体
+        void SetChangeTrackingEnabled(bool enabled);
+        bool IsChangeTrackingEnabled() const
+        {
+            return m_ChangeTrackingEnabled;
+        }
+        // 取走自上次调用以来的变更并清空
+        void ConsumeChanges(std::vector<UUID> &dirtyEntities, std::vector<UUID> &removedEntities);
+
         template<typename... Components> 
         auto GetAllEntitiesWith()
         {
@@ -71,6 +111,27 @@ namespace Himii
 
         void OnPhysics2DStart();
         void OnPhysics2DStop();
+        void CollectPhysics2DEvents();
+        void CreatePhysics2DBody(entt::entity e);
+        void CreatePhysics2DShapes(entt::entity e);
+        void FlushPendingPhysics2D();
+        bool OwnsPhysics2DBody(entt::entity e, void *runtimeBody) const;
+        bool OwnsPhysics2DShape(b2BodyId bodyId, void *runtimeFixture) const;
+
+        void OnRigidbody2DConstruct(entt::registry &registry, entt::entity entity);
+        void OnRigidbody2DDestroy(entt::registry &registry, entt::entity entity);
+        void OnCollider2DConstruct(entt::registry &registry, entt::entity entity);
+        void OnBoxCollider2DDestroy(entt::registry &registry, entt::entity entity);
+        void OnCircleCollider2DDestroy(entt::registry &registry, entt::entity entity);
+        void UpdatePhysics2DStats();
+        void RegisterPhysics2DShape(b2ShapeId shapeId, UUID entityID);
+        void RetirePhysics2DShape(void *runtimeFixture);
+        uint64_t GetShapeEntityID(b2ShapeId shapeId) const;
+
+        template<typename T>
+        void ConnectChangeTracking(bool connect);
+        void OnTrackedComponentChanged(entt::registry &registry, entt::entity entity);
+        void OnTrackedEntityDestroyed(entt::registry &registry, entt::entity entity);
 
         void RenderScene(EditorCamera &camera);
     private:
@@ -82,8 +143,27 @@ namespace Himii
 
         friend class Entity;
         friend class SceneSerializer;
+        friend class SceneBinarySerializer;
         friend class SceneHierarchyPanel;
 
-        b2WorldId m_Box2DWorld;
+        b2WorldId m_Box2DWorld = b2_nullWorldId;
+        Physics2DEvents m_Physics2DEvents;
+        SpriteAnimationSystem m_SpriteAnimationSystem;
+        Physics2DStats m_Physics2DStats;
+        bool m_Physics2DFilteringEnabled = true;
+
+        // 运行期间待创建的刚体/形状，在下一次物理步之前统一创建
+        std::vector<entt::entity> m_PendingPhysics2DBodies;
+        std::vector<entt::entity> m_PendingPhysics2DShapes;
+        std::vector<entt::entity> m_DeferredPhysics2DBodies;
+        // 形状 -> 实体 UUID。结束事件里的形状可能已被销毁，无法再从 Box2D 读取 userData，
+        // 所以创建时另存一份；销毁的形状在下一次物理步的事件收集完之后才移除
+        std::unordered_map<uint64_t, UUID> m_Physics2DShapeEntities;
+        std::vector<uint64_t> m_RetiredPhysics2DShapes;
+        uint32_t m_Physics2DBodiesPerFrame = 0;
+
+        bool m_ChangeTrackingEnabled = false;
+        std::unordered_set<UUID> m_DirtyEntities;
+        std::vector<UUID> m_RemovedEntities;
     };
 }
@@ -0,0 +1,246 @@
+#include "Hepch.h"
+#include "Himii/Scene/SceneAutosaver.h"
+
+#include "Himii/Core/Timer.h"
+#include "Himii/Scene/Components.h"
+#include "Himii/Scene/Entity.h"
+#include "Himii/Scene/SceneSerializer.h"
+
+#include <fstream>
+#include <limits>
+
+namespace Himii
+{
+    SceneAutosaver::SceneAutosaver()
+    {
+    }
+
+    SceneAutosaver::~SceneAutosaver()
+    {
+        Detach();
+    }
+
+    void SceneAutosaver::Attach(const Ref<Scene> &scene, const std::filesystem::path &filepath)
+    {
+        if (m_Scene == scene)
+        {
+            m_Path = filepath;
+            return;
+        }
+
+        Detach();
+        if (!scene)
+            return;
+
+        m_Scene = scene;
+        m_Path = filepath;
+        m_Scene->SetChangeTrackingEnabled(true);
+
+        // 刚打开的场景与磁盘一致，片段在之后的帧里逐步生成
+        auto view = m_Scene->Registry().view<IDComponent>();
+        for (auto e: view)
+            m_PendingEntities.insert(view.get<IDComponent>(e).ID);
+        m_HasChanges = false;
+        m_TimeSinceSave = 0.0f;
+    }
+
+    void SceneAutosaver::Detach()
+    {
+        if (m_WriteInFlight)
+        {
+            m_Writer.Wait();
+            PollWrite();
+        }
+
+        if (m_Scene)
+            m_Scene->SetChangeTrackingEnabled(false);
+        m_Scene = nullptr;
+        m_Path.clear();
+        m_Fragments.clear();
+        m_PendingEntities.clear();
+        m_HasChanges = false;
+        m_SaveRequested = false;
+        m_Stats.CachedEntities = 0;
+        m_Stats.PendingEntities = 0;
+    }
+
+    void SceneAutosaver::Update(Timestep ts)
+    {
+        if (!m_Scene)
+            return;
+
+        PollWrite();
+        CollectChanges();
+        bool snapshotComplete = SnapshotPendingEntities(m_FrameBudgetMs);
+        m_TimeSinceSave += ts;
+
+        if (!snapshotComplete || m_WriteInFlight || m_Path.empty())
+            return;
+
+        if (m_SaveRequested || (m_Enabled && m_HasChanges && m_TimeSinceSave >= m_Interval))
+            StartWrite();
+    }
+
+    void SceneAutosaver::SaveNow()
+    {
+        if (!m_Scene)
+            return;
+
+        PollWrite();
+        CollectChanges();
+        SnapshotPendingEntities(std::numeric_limits<float>::max());
+
+        if (m_Path.empty())
+            return;
+
+        // 上一次写入还没结束时排队，结束后在 Update 中立即再写一次
+        if (m_WriteInFlight)
+            m_SaveRequested = true;
+        else
+            StartWrite();
+    }
+
+    void SceneAutosaver::CollectChanges()
+    {
+        std::vector<UUID> dirtyEntities, removedEntities;
+        m_Scene->ConsumeChanges(dirtyEntities, removedEntities);
+
+        for (UUID id: removedEntities)
+        {
+            m_Fragments.erase((uint64_t)id);
+            m_PendingEntities.erase(id);
+        }
+        for (UUID id: dirtyEntities)
+            m_PendingEntities.insert(id);
+
+        if (!dirtyEntities.empty() || !removedEntities.empty())
+            m_HasChanges = true;
+    }
+
+    bool SceneAutosaver::SnapshotPendingEntities(float budgetMs)
+    {
+        if (m_PendingEntities.empty())
+            return true;
+
+        HIMII_PROFILE_FUNCTION();
+
+        Timer timer;
+        uint32_t count = 0;
+        while (!m_PendingEntities.empty())
+        {
+            // 每 16 个实体检查一次时间，避免频繁读时钟
+            if (count > 0 && count % 16 == 0 && timer.ElapsedMillis() > budgetMs)
+                break;
+
+            UUID id = *m_PendingEntities.begin();
+            m_PendingEntities.erase(m_PendingEntities.begin());
+            ++count;
+
+            Entity entity = m_Scene->GetEntityByUUID(id);
+            if (!entity)
+            {
+                m_Fragments.erase((uint64_t)id);
+                continue;
+            }
+
+            // 每个片段是只含一个元素的块序列，拼接后就是 Entities 下的完整序列
+            YAML::Emitter out;
+            out << YAML::BeginSeq;
+            SceneSerializer::SerializeEntity(out, entity);
+            out << YAML::EndSeq;
+
+            std::string fragment = out.c_str();
+            fragment += '\n';
+            m_Fragments[(uint64_t)id] = CreateRef<const std::string>(std::move(fragment));
+        }
+
+        m_Stats.LastSnapshotEntities = count;
+        m_Stats.LastSnapshotMs = timer.ElapsedMillis();
+        m_Stats.CachedEntities = (uint32_t)m_Fragments.size();
+        m_Stats.PendingEntities = (uint32_t)m_PendingEntities.size();
+        return m_PendingEntities.empty();
+    }
+
+    void SceneAutosaver::StartWrite()
+    {
+        // 主线程只按注册表顺序复制片段指针，拼接和写盘都在工作线程
+        std::vector<Ref<const std::string>> fragments;
+        fragments.reserve(m_Fragments.size());
+        m_Scene->Registry().view<IDComponent>().each(
+                [&](auto entity, IDComponent &id)
+                {
+                    auto it = m_Fragments.find((uint64_t)id.ID);
+                    if (it != m_Fragments.end())
+                        fragments.push_back(it->second);
+                });
+
+        m_WriteInFlight = true;
+        m_WriteFinished = false;
+        m_HasChanges = false;
+        m_SaveRequested = false;
+        m_TimeSinceSave = 0.0f;
+
+        std::filesystem::path path = m_Path;
+        m_Writer.Submit(
+                [this, fragments, path]()
+                {
+                    Timer timer;
+
+                    size_t totalSize = 64;
+                    for (const auto &fragment: fragments)
+                        totalSize += fragment->size();
+
+                    std::string text;
+                    text.reserve(totalSize);
+                    text += "Scene: Untitled\n";
+                    text += fragments.empty() ? "Entities: []\n" : "Entities:\n";
+                    for (const auto &fragment: fragments)
+                        text += *fragment;
+
+                    bool succeeded = false;
+                    std::filesystem::path tempPath = std::filesystem::path(path).concat(".tmp");
+                    {
+                        std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+                        out.write(text.data(), (std::streamsize)text.size());
+                        succeeded = (bool)out;
+                    }
+
+                    std::error_code error;
+                    if (succeeded)
+                    {
+                        std::filesystem::rename(tempPath, path, error);
+                        succeeded = !error;
+                    }
+                    if (!succeeded)
+                        std::filesystem::remove(tempPath, error);
+
+                    m_WriteMs = timer.ElapsedMillis();
+                    m_WriteBytes = text.size();
+                    m_WriteSucceeded = succeeded;
+                    m_WriteFinished.store(true, std::memory_order_release);
+                });
+    }
+
+    void SceneAutosaver::PollWrite()
+    {
+        if (!m_WriteInFlight || !m_WriteFinished.load(std::memory_order_acquire))
+            return;
+
+        m_WriteInFlight = false;
+        m_Stats.LastWriteMs = m_WriteMs;
+        m_Stats.LastWriteBytes = m_WriteBytes;
+        m_Stats.LastWriteSucceeded = m_WriteSucceeded;
+        if (m_WriteSucceeded)
+        {
+            ++m_Stats.SaveCount;
+            HIMII_CORE_INFO("Saved scene '{0}' ({1} entities, {2} KB) in background in {3:.2f} ms", m_Path.string(),
+                            m_Fragments.size(), m_WriteBytes / 1024, m_WriteMs);
+        }
+        else
+        {
+            // 下一次间隔到达时重试
+            m_HasChanges = true;
+            HIMII_CORE_ERROR("Failed to save scene '{0}'", m_Path.string());
+        }
+    }
+} // namespace Himii
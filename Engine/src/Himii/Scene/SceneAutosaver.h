@@ -0,0 +1,126 @@
+#pragma once
+#include "Himii/Core/ThreadPool.h"
+#include "Himii/Core/Timestep.h"
+#include "Himii/Scene/Scene.h"
+
+#include <atomic>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace Himii
+{
+    struct SceneAutosaveStats {
+        uint32_t CachedEntities = 0;
+        uint32_t PendingEntities = 0; // 已变更、尚未重新生成 YAML 片段的实体
+        uint32_t LastSnapshotEntities = 0;
+        float LastSnapshotMs = 0.0f;
+        float LastWriteMs = 0.0f; // 后台线程拼接并写盘的耗时
+        uint64_t LastWriteBytes = 0;
+        uint32_t SaveCount = 0;
+        bool LastWriteSucceeded = true;
+    };
+
+    // 增量保存 YAML 场景：每个实体缓存一段 YAML 片段，只重新生成脏实体的片段（每帧有时间预算），
+    // 拼接和写盘在后台线程完成，先写临时文件再原子替换
+    class SceneAutosaver {
+    public:
+        SceneAutosaver();
+        ~SceneAutosaver();
+
+        SceneAutosaver(const SceneAutosaver &) = delete;
+        SceneAutosaver &operator=(const SceneAutosaver &) = delete;
+
+        // 开始跟踪场景；同一场景只更新路径。新场景的所有实体分帧生成片段，不会立即写盘
+        void Attach(const Ref<Scene> &scene, const std::filesystem::path &filepath);
+        void Detach();
+
+        bool IsAttachedTo(const Ref<Scene> &scene) const
+        {
+            return m_Scene && m_Scene == scene;
+        }
+
+        // 主线程每帧调用：在预算内更新脏实体片段，自动保存间隔到达且有修改时启动后台写入
+        void Update(Timestep ts);
+
+        // 立即更新全部脏实体并写盘（Ctrl+S），写入仍在后台
+        void SaveNow();
+
+        void SetInterval(float seconds)
+        {
+            m_Interval = seconds;
+        }
+
+        float GetInterval() const
+        {
+            return m_Interval;
+        }
+
+        void SetEnabled(bool enabled)
+        {
+            m_Enabled = enabled;
+        }
+
+        bool IsEnabled() const
+        {
+            return m_Enabled;
+        }
+
+        void SetFrameBudget(float milliseconds)
+        {
+            m_FrameBudgetMs = milliseconds;
+        }
+
+        float GetFrameBudget() const
+        {
+            return m_FrameBudgetMs;
+        }
+
+        bool HasUnsavedChanges() const
+        {
+            return m_HasChanges || !m_PendingEntities.empty();
+        }
+
+        bool IsWriting() const
+        {
+            return m_WriteInFlight;
+        }
+
+        const SceneAutosaveStats &GetStats() const
+        {
+            return m_Stats;
+        }
+
+    private:
+        void CollectChanges();
+        // 返回 true 表示待处理实体已全部完成
+        bool SnapshotPendingEntities(float budgetMs);
+        void StartWrite();
+        void PollWrite();
+
+    private:
+        Ref<Scene> m_Scene;
+        std::filesystem::path m_Path;
+
+        // 写盘时按注册表顺序（与 SceneSerializer 相同）拼接，自动保存不会打乱实体顺序
+        std::unordered_map<uint64_t, Ref<const std::string>> m_Fragments;
+        std::unordered_set<UUID> m_PendingEntities;
+        bool m_HasChanges = false;
+
+        bool m_Enabled = true;
+        float m_Interval = 30.0f;
+        float m_FrameBudgetMs = 2.0f;
+        float m_TimeSinceSave = 0.0f;
+        bool m_SaveRequested = false;
+
+        ThreadPool m_Writer{1};
+        bool m_WriteInFlight = false;
+        // 工作线程写完后置位，结果在 PollWrite 中读取
+        std::atomic<bool> m_WriteFinished{false};
+        float m_WriteMs = 0.0f;
+        uint64_t m_WriteBytes = 0;
+        bool m_WriteSucceeded = false;
+
+        SceneAutosaveStats m_Stats;
+    };
+} // namespace Himii
@@ -0,0 +1,780 @@
+#include "Hepch.h"
+#include "Himii/Scene/SceneBinarySerializer.h"
+
+#include "Himii/Project/Project.h"
+#include "Himii/Scene/Components.h"
+#include "Himii/Asset/VirtualFileSystem.h"
+
+#include <fstream>
+#include <string_view>
+
+namespace Himii
+{
+    namespace
+    {
+        // 文件布局：Header | Chunk[ChunkCount] | UUID[EntityCount] | 各块数据 | 字符串表
+        // 每块数据：uint32_t EntityIndex[Count]（严格递增）| 8 字节对齐 | Record[Count]
+        struct SceneBinaryString {
+            uint32_t Offset = 0; // 字符串表内偏移
+            uint32_t Length = 0;
+        };
+
+        struct SceneBinaryHeader {
+            char Magic[4] = {'H', 'S', 'C', 'N'};
+            uint32_t Version = 1;
+            uint32_t EntityCount = 0;
+            uint32_t ChunkCount = 0;
+            uint64_t EntityTableOffset = 0;
+            uint64_t StringTableOffset = 0;
+            uint64_t StringTableSize = 0;
+        };
+
+        enum class SceneChunkType : uint32_t {
+            Tag = 1,
+            Transform,
+            Camera,
+            Script,
+            SpriteRenderer,
+            CircleRenderer,
+            Rigidbody2D,
+            BoxCollider2D,
+            CircleCollider2D,
+            SpriteAnimation
+        };
+        constexpr uint32_t s_MaxChunkCount = (uint32_t)SceneChunkType::SpriteAnimation;
+
+        struct SceneBinaryChunk {
+            SceneChunkType Type = SceneChunkType::Tag;
+            uint32_t Count = 0;
+            uint64_t IndexOffset = 0;
+            uint64_t RecordOffset = 0;
+            uint32_t RecordSize = 0;
+            uint32_t Padding = 0;
+        };
+
+        struct TagRecord {
+            SceneBinaryString Tag;
+        };
+
+        struct TransformRecord {
+            glm::vec3 Position;
+            glm::vec3 Rotation;
+            glm::vec3 Scale;
+        };
+
+        struct CameraRecord {
+            int32_t ProjectionType = 0;
+            float PerspectiveFOV = 0.0f;
+            float PerspectiveNear = 0.0f;
+            float PerspectiveFar = 0.0f;
+            float OrthographicSize = 0.0f;
+            float OrthographicNear = 0.0f;
+            float OrthographicFar = 0.0f;
+            glm::vec4 BackgroundColor;
+            uint8_t Primary = 0;
+            uint8_t FixedAspectRatio = 0;
+            uint8_t Padding[2] = {};
+        };
+
+        struct ScriptRecord {
+            SceneBinaryString ClassName;
+        };
+
+        struct SpriteRendererRecord {
+            enum Flag : uint32_t {
+                HasTexture = 1 << 0
+            };
+
+            glm::vec4 Color;
+            uint64_t TextureHandle = 0; // 注册表中无效时为 0，加载时按 TexturePath 重新导入
+            SceneBinaryString TexturePath;
+            float TilingFactor = 1.0f;
+            uint32_t Flags = 0;
+        };
+
+        struct CircleRendererRecord {
+            glm::vec4 Color;
+            float Radius = 0.0f;
+            float Thickness = 0.0f;
+            float Fade = 0.0f;
+            float Padding = 0.0f;
+        };
+
+        struct Rigidbody2DRecord {
+            int32_t BodyType = 0;
+            uint32_t FixedRotation = 0;
+        };
+
+        struct BoxCollider2DRecord {
+            glm::vec2 Offset;
+            glm::vec2 Size;
+            float Density = 0.0f;
+            float Friction = 0.0f;
+            float Restitution = 0.0f;
+            float RestitutionThreshold = 0.0f;
+            uint32_t IsSensor = 0;
+            uint32_t CategoryBits = 0;
+            uint32_t MaskBits = 0;
+            uint32_t Padding = 0;
+        };
+
+        struct CircleCollider2DRecord {
+            glm::vec2 Offset;
+            float Radius = 0.0f;
+            float Density = 0.0f;
+            float Friction = 0.0f;
+            float Restitution = 0.0f;
+            float RestitutionThreshold = 0.0f;
+            uint32_t IsSensor = 0;
+            uint32_t CategoryBits = 0;
+            uint32_t MaskBits = 0;
+        };
+
+        struct SpriteAnimationRecord {
+            uint64_t AnimationHandle = 0;
+            float FrameRate = 0.0f;
+            uint32_t Playing = 0;
+        };
+
+        static_assert(sizeof(SceneBinaryHeader) == 40, "Scene header layout changed");
+        static_assert(sizeof(SceneBinaryChunk) == 32, "Scene chunk layout changed");
+        static_assert(sizeof(TransformRecord) == 36, "Transform record layout changed");
+        static_assert(sizeof(CameraRecord) == 48, "Camera record layout changed");
+        static_assert(sizeof(SpriteRendererRecord) == 40, "SpriteRenderer record layout changed");
+        static_assert(sizeof(CircleRendererRecord) == 32, "CircleRenderer record layout changed");
+        static_assert(sizeof(BoxCollider2DRecord) == 48, "BoxCollider2D record layout changed");
+        static_assert(sizeof(CircleCollider2DRecord) == 40, "CircleCollider2D record layout changed");
+        static_assert(sizeof(SpriteAnimationRecord) == 16, "SpriteAnimation record layout changed");
+
+        constexpr uint32_t s_SceneBinaryVersion = 1;
+
+        // 相同字符串只存一份（大量同名实体、同一脚本类）
+        class StringTableBuilder {
+        public:
+            SceneBinaryString Add(const std::string &text)
+            {
+                auto it = m_Offsets.find(text);
+                if (it == m_Offsets.end())
+                {
+                    it = m_Offsets.emplace(text, (uint32_t)m_Data.size()).first;
+                    m_Data += text;
+                }
+                return {it->second, (uint32_t)text.size()};
+            }
+
+            const std::string &GetData() const
+            {
+                return m_Data;
+            }
+
+        private:
+            std::string m_Data;
+            std::unordered_map<std::string, uint32_t> m_Offsets;
+        };
+
+        size_t AlignTo8(size_t value)
+        {
+            return (value + 7) & ~(size_t)7;
+        }
+
+        template<typename T>
+        void AppendBytes(std::vector<uint8_t> &buffer, const T *data, size_t count)
+        {
+            const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data);
+            buffer.insert(buffer.end(), bytes, bytes + count * sizeof(T));
+        }
+
+        // 写入阶段的块，组件按实体顺序收集，因此下标天然递增
+        template<typename Record>
+        struct ChunkBuilder {
+            std::vector<uint32_t> Indices;
+            std::vector<Record> Records;
+
+            void Add(uint32_t index, const Record &record)
+            {
+                Indices.push_back(index);
+                Records.push_back(record);
+            }
+
+            void Write(SceneChunkType type, std::vector<uint8_t> &buffer, std::vector<SceneBinaryChunk> &chunks) const
+            {
+                if (Records.empty())
+                    return;
+
+                SceneBinaryChunk chunk;
+                chunk.Type = type;
+                chunk.Count = (uint32_t)Records.size();
+                chunk.RecordSize = sizeof(Record);
+
+                buffer.resize(AlignTo8(buffer.size()));
+                chunk.IndexOffset = buffer.size();
+                AppendBytes(buffer, Indices.data(), Indices.size());
+
+                buffer.resize(AlignTo8(buffer.size()));
+                chunk.RecordOffset = buffer.size();
+                AppendBytes(buffer, Records.data(), Records.size());
+
+                chunks.push_back(chunk);
+            }
+        };
+
+        // 校验块的边界、记录大小和下标，通过后才开始创建实体，避免半途失败留下残缺场景
+        bool ValidateChunk(const SceneBinaryChunk &chunk, const VirtualFile &file, uint32_t entityCount,
+                           uint32_t expectedRecordSize)
+        {
+            if (chunk.RecordSize != expectedRecordSize)
+                return false;
+
+            uint64_t indexEnd = chunk.IndexOffset + (uint64_t)chunk.Count * sizeof(uint32_t);
+            uint64_t recordEnd = chunk.RecordOffset + (uint64_t)chunk.Count * chunk.RecordSize;
+            if (chunk.IndexOffset % 8 != 0 || chunk.RecordOffset % 8 != 0 || indexEnd > file.GetSize() ||
+                recordEnd > file.GetSize())
+                return false;
+
+            const auto *indices = reinterpret_cast<const uint32_t *>(file.GetData() + chunk.IndexOffset);
+            for (uint32_t i = 0; i < chunk.Count; ++i)
+            {
+                if (indices[i] >= entityCount || (i > 0 && indices[i] <= indices[i - 1]))
+                    return false;
+            }
+            return true;
+        }
+
+        uint32_t GetRecordSize(SceneChunkType type)
+        {
+            switch (type)
+            {
+                case SceneChunkType::Tag:              return sizeof(TagRecord);
+                case SceneChunkType::Transform:        return sizeof(TransformRecord);
+                case SceneChunkType::Camera:           return sizeof(CameraRecord);
+                case SceneChunkType::Script:           return sizeof(ScriptRecord);
+                case SceneChunkType::SpriteRenderer:   return sizeof(SpriteRendererRecord);
+                case SceneChunkType::CircleRenderer:   return sizeof(CircleRendererRecord);
+                case SceneChunkType::Rigidbody2D:      return sizeof(Rigidbody2DRecord);
+                case SceneChunkType::BoxCollider2D:    return sizeof(BoxCollider2DRecord);
+                case SceneChunkType::CircleCollider2D: return sizeof(CircleCollider2DRecord);
+                case SceneChunkType::SpriteAnimation:  return sizeof(SpriteAnimationRecord);
+            }
+            return 0;
+        }
+
+        // 整块组件先在连续数组中构造，再一次 insert 进 entt 存储
+        template<typename Component, typename Record, typename Func>
+        void InsertChunk(entt::registry &registry, const std::vector<entt::entity> &entities,
+                         const SceneBinaryChunk &chunk, const VirtualFile &file, Func func)
+        {
+            const auto *indices = reinterpret_cast<const uint32_t *>(file.GetData() + chunk.IndexOffset);
+            const auto *records = reinterpret_cast<const Record *>(file.GetData() + chunk.RecordOffset);
+
+            std::vector<entt::entity> targets(chunk.Count);
+            std::vector<Component> components(chunk.Count);
+            for (uint32_t i = 0; i < chunk.Count; ++i)
+            {
+                targets[i] = entities[indices[i]];
+                func(records[i], components[i]);
+            }
+            registry.insert<Component>(targets.begin(), targets.end(), components.begin());
+        }
+    } // namespace
+
+    SceneBinarySerializer::SceneBinarySerializer(const Ref<Scene> &scene) : m_Scene(scene)
+    {
+    }
+
+    bool SceneBinarySerializer::IsBinaryScenePath(const std::filesystem::path &filepath)
+    {
+        return filepath.extension() == ".hscn";
+    }
+
+    bool SceneBinarySerializer::Serialize(const std::filesystem::path &filepath)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        auto &registry = m_Scene->m_Registry;
+
+        // 与 YAML 序列化使用相同的实体顺序
+        std::vector<entt::entity> entities;
+        std::vector<uint64_t> uuids;
+        registry.view<IDComponent>().each(
+                [&](auto entity, IDComponent &id)
+                {
+                    entities.push_back(entity);
+                    uuids.push_back((uint64_t)id.ID);
+                });
+
+        auto assetManager = Project::GetActive() ? Project::GetAssetManager() : nullptr;
+
+        // 纹理延迟加载的场景（后台解析、构建时烘焙）精灵上还没有 Texture，按 pending 列表写出
+        std::unordered_map<entt::entity, const PendingSpriteTexture *> pendingTextures;
+        if (m_PendingTextures)
+        {
+            for (const auto &pending: *m_PendingTextures)
+                pendingTextures[pending.Entity] = &pending;
+        }
+
+        StringTableBuilder strings;
+        ChunkBuilder<TagRecord> tags;
+        ChunkBuilder<TransformRecord> transforms;
+        ChunkBuilder<CameraRecord> cameras;
+        ChunkBuilder<ScriptRecord> scripts;
+        ChunkBuilder<SpriteRendererRecord> sprites;
+        ChunkBuilder<CircleRendererRecord> circles;
+        ChunkBuilder<Rigidbody2DRecord> rigidbodies;
+        ChunkBuilder<BoxCollider2DRecord> boxColliders;
+        ChunkBuilder<CircleCollider2DRecord> circleColliders;
+        ChunkBuilder<SpriteAnimationRecord> animations;
+
+        for (uint32_t index = 0; index < (uint32_t)entities.size(); ++index)
+        {
+            entt::entity entity = entities[index];
+
+            if (auto *tag = registry.try_get<TagComponent>(entity))
+                tags.Add(index, {strings.Add(tag->Tag)});
+
+            if (auto *tc = registry.try_get<TransformComponent>(entity))
+                transforms.Add(index, {tc->Position, tc->Rotation, tc->Scale});
+
+            if (auto *cc = registry.try_get<CameraComponent>(entity))
+            {
+                CameraRecord record;
+                record.ProjectionType = (int32_t)cc->Camera.GetProjectionType();
+                record.PerspectiveFOV = cc->Camera.GetPerspectiveVerticalFOV();
+                record.PerspectiveNear = cc->Camera.GetPerspectiveNearClip();
+                record.PerspectiveFar = cc->Camera.GetPerspectiveFarClip();
+                record.OrthographicSize = cc->Camera.GetOrthographicSize();
+                record.OrthographicNear = cc->Camera.GetOrthographicNearClip();
+                record.OrthographicFar = cc->Camera.GetOrthographicFarClip();
+                record.BackgroundColor = cc->Camera.GetBackgroundColor();
+                record.Primary = cc->Primary ? 1 : 0;
+                record.FixedAspectRatio = cc->FixedAspectRatio ? 1 : 0;
+                cameras.Add(index, record);
+            }
+
+            if (auto *sc = registry.try_get<ScriptComponent>(entity))
+                scripts.Add(index, {strings.Add(sc->ClassName)});
+
+            if (auto *src = registry.try_get<SpriteRendererComponent>(entity))
+            {
+                SpriteRendererRecord record;
+                record.Color = src->Color;
+                record.TilingFactor = src->TilingFactor;
+                if (src->Texture)
+                {
+                    // 与 YAML 相同：Handle 有效时写 Handle 和注册表路径，否则只写纹理自身的路径
+                    record.Flags |= SpriteRendererRecord::HasTexture;
+                    if (assetManager && assetManager->IsAssetHandleValid(src->TextureHandle))
+                    {
+                        record.TextureHandle = (uint64_t)src->TextureHandle;
+                        record.TexturePath =
+                                strings.Add(assetManager->GetMetadata(src->TextureHandle).FilePath.generic_string());
+                    }
+                    else
+                    {
+                        record.TexturePath = strings.Add(src->Texture->GetPath());
+                    }
+                }
+                else if (auto it = pendingTextures.find(entity); it != pendingTextures.end())
+                {
+                    record.Flags |= SpriteRendererRecord::HasTexture;
+                    record.TextureHandle = (uint64_t)it->second->Handle;
+                    record.TexturePath = strings.Add(it->second->Path);
+                }
+                sprites.Add(index, record);
+            }
+
+            if (auto *crc = registry.try_get<CircleRendererComponent>(entity))
+            {
+                CircleRendererRecord record;
+                record.Color = crc->Color;
+                record.Radius = crc->Radius;
+                record.Thickness = crc->Thickness;
+                record.Fade = crc->Fade;
+                circles.Add(index, record);
+            }
+
+            if (auto *rbc = registry.try_get<Rigidbody2DComponent>(entity))
+                rigidbodies.Add(index, {(int32_t)rbc->Type, rbc->FixedRotation ? 1u : 0u});
+
+            if (auto *bcc = registry.try_get<BoxCollider2DComponent>(entity))
+            {
+                BoxCollider2DRecord record;
+                record.Offset = bcc->Offset;
+                record.Size = bcc->Size;
+                record.Density = bcc->Density;
+                record.Friction = bcc->Friction;
+                record.Restitution = bcc->Restitution;
+                record.RestitutionThreshold = bcc->RestitutionThreshold;
+                record.IsSensor = bcc->IsSensor ? 1 : 0;
+                record.CategoryBits = bcc->CategoryBits;
+                record.MaskBits = bcc->MaskBits;
+                boxColliders.Add(index, record);
+            }
+
+            if (auto *ccc = registry.try_get<CircleCollider2DComponent>(entity))
+            {
+                CircleCollider2DRecord record;
+                record.Offset = ccc->Offset;
+                record.Radius = ccc->Radius;
+                record.Density = ccc->Density;
+                record.Friction = ccc->Friction;
+                record.Restitution = ccc->Restitution;
+                record.RestitutionThreshold = ccc->RestitutionThreshold;
+                record.IsSensor = ccc->IsSensor ? 1 : 0;
+                record.CategoryBits = ccc->CategoryBits;
+                record.MaskBits = ccc->MaskBits;
+                circleColliders.Add(index, record);
+            }
+
+            if (auto *sac = registry.try_get<SpriteAnimationComponent>(entity))
+                animations.Add(index, {(uint64_t)sac->AnimationHandle, sac->FrameRate, sac->Playing ? 1u : 0u});
+        }
+
+        // 块表大小依赖非空块数量，先把数据写到块表之后，最后回填头和块表
+        std::vector<SceneBinaryChunk> chunks;
+        std::vector<uint8_t> buffer;
+        SceneBinaryHeader header;
+        size_t chunkTableSize = sizeof(SceneBinaryChunk) * s_MaxChunkCount;
+        buffer.resize(sizeof(header) + chunkTableSize);
+
+        header.EntityCount = (uint32_t)uuids.size();
+        header.EntityTableOffset = buffer.size();
+        AppendBytes(buffer, uuids.data(), uuids.size());
+
+        tags.Write(SceneChunkType::Tag, buffer, chunks);
+        transforms.Write(SceneChunkType::Transform, buffer, chunks);
+        cameras.Write(SceneChunkType::Camera, buffer, chunks);
+        scripts.Write(SceneChunkType::Script, buffer, chunks);
+        sprites.Write(SceneChunkType::SpriteRenderer, buffer, chunks);
+        circles.Write(SceneChunkType::CircleRenderer, buffer, chunks);
+        rigidbodies.Write(SceneChunkType::Rigidbody2D, buffer, chunks);
+        boxColliders.Write(SceneChunkType::BoxCollider2D, buffer, chunks);
+        circleColliders.Write(SceneChunkType::CircleCollider2D, buffer, chunks);
+        animations.Write(SceneChunkType::SpriteAnimation, buffer, chunks);
+
+        header.StringTableOffset = buffer.size();
+        header.StringTableSize = strings.GetData().size();
+        AppendBytes(buffer, strings.GetData().data(), strings.GetData().size());
+
+        // 未用满的块表位置保持为 0，读取时只看 ChunkCount
+        header.ChunkCount = (uint32_t)chunks.size();
+        memcpy(buffer.data(), &header, sizeof(header));
+        memcpy(buffer.data() + sizeof(header), chunks.data(), chunks.size() * sizeof(SceneBinaryChunk));
+
+        // 先写临时文件再替换，保存中途失败不会破坏原场景
+        std::filesystem::path tempPath = std::filesystem::path(filepath).concat(".tmp");
+        {
+            std::ofstream out(tempPath, std::ios::binary | std::ios::trunc);
+            if (!out)
+            {
+                HIMII_CORE_ERROR("Failed to write binary scene '{0}'", filepath.string());
+                return false;
+            }
+            out.write(reinterpret_cast<const char *>(buffer.data()), (std::streamsize)buffer.size());
+            if (!out)
+            {
+                HIMII_CORE_ERROR("Failed to write binary scene '{0}'", filepath.string());
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(tempPath, filepath, error);
+        if (error)
+        {
+            HIMII_CORE_ERROR("Failed to replace binary scene '{0}': {1}", filepath.string(), error.message());
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+    bool SceneBinarySerializer::Deserialize(const std::filesystem::path &filepath)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        // 散文件整体映射；打包后直接使用 .hpak 中未压缩条目的映射内存
+        VirtualFile file;
+        if (!VirtualFileSystem::ReadFile(filepath, file))
+        {
+            HIMII_CORE_ERROR("Failed to load binary scene '{0}'", filepath.string());
+            return false;
+        }
+        return Deserialize(file, filepath);
+    }
+
+    bool SceneBinarySerializer::IsBinarySceneData(const uint8_t *data, size_t size)
+    {
+        return data && size >= sizeof(SceneBinaryHeader) && memcmp(data, "HSCN", 4) == 0;
+    }
+
+    bool SceneBinarySerializer::Deserialize(const VirtualFile &file, const std::filesystem::path &filepath)
+    {
+        if (file.GetSize() < sizeof(SceneBinaryHeader))
+        {
+            HIMII_CORE_ERROR("Failed to load binary scene '{0}'", filepath.string());
+            return false;
+        }
+
+        SceneBinaryHeader header;
+        memcpy(&header, file.GetData(), sizeof(header));
+        if (memcmp(header.Magic, "HSCN", 4) != 0 || header.Version != s_SceneBinaryVersion)
+        {
+            HIMII_CORE_ERROR("'{0}' is not a binary scene of version {1}", filepath.string(), s_SceneBinaryVersion);
+            return false;
+        }
+
+        uint64_t chunkTableEnd = sizeof(header) + (uint64_t)header.ChunkCount * sizeof(SceneBinaryChunk);
+        uint64_t entityTableEnd = header.EntityTableOffset + (uint64_t)header.EntityCount * sizeof(uint64_t);
+        if (chunkTableEnd > file.GetSize() || header.EntityTableOffset % 8 != 0 || entityTableEnd > file.GetSize() ||
+            header.StringTableOffset + header.StringTableSize > file.GetSize())
+        {
+            HIMII_CORE_ERROR("Binary scene '{0}' is truncated", filepath.string());
+            return false;
+        }
+
+        std::vector<SceneBinaryChunk> chunks(header.ChunkCount);
+        memcpy(chunks.data(), file.GetData() + sizeof(header), chunks.size() * sizeof(SceneBinaryChunk));
+        // 每种组件只能有一个块，重复的块会让第二次 insert 给已有组件的实体再插入一次
+        uint32_t seenChunkTypes = 0;
+        for (const auto &chunk: chunks)
+        {
+            uint32_t recordSize = GetRecordSize(chunk.Type);
+            if (recordSize == 0)
+            {
+                HIMII_CORE_WARNING("Binary scene '{0}': skipping unknown chunk type {1}", filepath.string(),
+                                   (uint32_t)chunk.Type);
+                continue;
+            }
+            uint32_t typeBit = 1u << (uint32_t)chunk.Type;
+            if (seenChunkTypes & typeBit)
+            {
+                HIMII_CORE_ERROR("Binary scene '{0}' has a duplicate chunk (type {1})", filepath.string(),
+                                 (uint32_t)chunk.Type);
+                return false;
+            }
+            seenChunkTypes |= typeBit;
+            if (!ValidateChunk(chunk, file, header.EntityCount, recordSize))
+            {
+                HIMII_CORE_ERROR("Binary scene '{0}' has a corrupt chunk (type {1})", filepath.string(),
+                                 (uint32_t)chunk.Type);
+                return false;
+            }
+        }
+
+        const char *stringTable = reinterpret_cast<const char *>(file.GetData() + header.StringTableOffset);
+        auto getString = [&](const SceneBinaryString &ref) -> std::string
+        {
+            if ((uint64_t)ref.Offset + ref.Length > header.StringTableSize)
+                return {};
+            return std::string(stringTable + ref.Offset, ref.Length);
+        };
+
+        auto &registry = m_Scene->m_Registry;
+        const auto *uuids = reinterpret_cast<const uint64_t *>(file.GetData() + header.EntityTableOffset);
+
+        // 实体批量创建；ID / Transform / Tag 与 CreateEntityWithUUID 一样每个实体都有
+        std::vector<entt::entity> entities(header.EntityCount);
+        registry.create(entities.begin(), entities.end());
+
+        std::vector<IDComponent> ids;
+        ids.reserve(header.EntityCount);
+        m_Scene->m_EntityMap.reserve(m_Scene->m_EntityMap.size() + header.EntityCount);
+        for (uint32_t i = 0; i < header.EntityCount; ++i)
+        {
+            ids.push_back(IDComponent{UUID(uuids[i])});
+            m_Scene->m_EntityMap[ids.back().ID] = entities[i];
+        }
+        registry.insert<IDComponent>(entities.begin(), entities.end(), ids.begin());
+
+        std::vector<TransformComponent> transforms(header.EntityCount);
+        std::vector<TagComponent> tags(header.EntityCount, TagComponent("Entity"));
+        for (const auto &chunk: chunks)
+        {
+            const auto *indices = reinterpret_cast<const uint32_t *>(file.GetData() + chunk.IndexOffset);
+            if (chunk.Type == SceneChunkType::Transform)
+            {
+                const auto *records = reinterpret_cast<const TransformRecord *>(file.GetData() + chunk.RecordOffset);
+                for (uint32_t i = 0; i < chunk.Count; ++i)
+                {
+                    auto &tc = transforms[indices[i]];
+                    tc.Position = records[i].Position;
+                    tc.Rotation = records[i].Rotation;
+                    tc.Scale = records[i].Scale;
+                }
+            }
+            else if (chunk.Type == SceneChunkType::Tag)
+            {
+                const auto *records = reinterpret_cast<const TagRecord *>(file.GetData() + chunk.RecordOffset);
+                for (uint32_t i = 0; i < chunk.Count; ++i)
+                {
+                    std::string tag = getString(records[i].Tag);
+                    if (!tag.empty())
+                        tags[indices[i]].Tag = std::move(tag);
+                }
+            }
+        }
+        registry.insert<TransformComponent>(entities.begin(), entities.end(), transforms.begin());
+        registry.insert<TagComponent>(entities.begin(), entities.end(), tags.begin());
+
+        if (m_Progress)
+            m_Progress->EntityCount.store(header.EntityCount, std::memory_order_relaxed);
+
+        for (size_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex)
+        {
+            const auto &chunk = chunks[chunkIndex];
+            if (m_Progress)
+                m_Progress->EntitiesLoaded.store((uint32_t)((uint64_t)header.EntityCount * chunkIndex / chunks.size()),
+                                                 std::memory_order_relaxed);
+            switch (chunk.Type)
+            {
+                case SceneChunkType::Camera:
+                    InsertChunk<CameraComponent, CameraRecord>(
+                            registry, entities, chunk, file,
+                            [&](const CameraRecord &record, CameraComponent &cc)
+                            {
+                                cc.Camera.SetProjectionType((SceneCamera::ProjectionType)record.ProjectionType);
+                                cc.Camera.SetPerspectiveVerticalFOV(record.PerspectiveFOV);
+                                cc.Camera.SetPerspectiveNearClip(record.PerspectiveNear);
+                                cc.Camera.SetPerspectiveFarClip(record.PerspectiveFar);
+                                cc.Camera.SetOrthographicSize(record.OrthographicSize);
+                                cc.Camera.SetOrthographicNearClip(record.OrthographicNear);
+                                cc.Camera.SetOrthographicFarClip(record.OrthographicFar);
+                                cc.Camera.SetBackgroundColor(record.BackgroundColor);
+                                cc.Primary = record.Primary != 0;
+                                cc.FixedAspectRatio = record.FixedAspectRatio != 0;
+                                // 批量插入不经过 OnComponentAdded，这里补上视口尺寸
+                                if (m_Scene->m_ViewportWidth > 0 && m_Scene->m_ViewportHeight > 0)
+                                    cc.Camera.SetViewportSize(m_Scene->m_ViewportWidth, m_Scene->m_ViewportHeight);
+                            });
+                    break;
+                case SceneChunkType::Script:
+                    InsertChunk<ScriptComponent, ScriptRecord>(registry, entities, chunk, file,
+                                                               [&](const ScriptRecord &record, ScriptComponent &sc)
+                                                               { sc.ClassName = getString(record.ClassName); });
+                    break;
+                case SceneChunkType::SpriteRenderer:
+                    InsertChunk<SpriteRendererComponent, SpriteRendererRecord>(
+                            registry, entities, chunk, file,
+                            [&](const SpriteRendererRecord &record, SpriteRendererComponent &src)
+                            {
+                                src.Color = record.Color;
+                                src.TilingFactor = record.TilingFactor;
+                                if (record.Flags & SpriteRendererRecord::HasTexture)
+                                {
+                                    src.TextureHandle = record.TextureHandle;
+                                    if (!m_PendingTextures)
+                                        src.Texture = SceneSerializer::LoadSpriteTexture(
+                                                src.TextureHandle, getString(record.TexturePath));
+                                }
+                            });
+                    if (m_PendingTextures)
+                    {
+                        const auto *indices = reinterpret_cast<const uint32_t *>(file.GetData() + chunk.IndexOffset);
+                        const auto *records =
+                                reinterpret_cast<const SpriteRendererRecord *>(file.GetData() + chunk.RecordOffset);
+                        for (uint32_t i = 0; i < chunk.Count; ++i)
+                        {
+                            if (records[i].Flags & SpriteRendererRecord::HasTexture)
+                                m_PendingTextures->push_back({entities[indices[i]], records[i].TextureHandle,
+                                                              getString(records[i].TexturePath)});
+                        }
+                    }
+                    break;
+                case SceneChunkType::CircleRenderer:
+                    InsertChunk<CircleRendererComponent, CircleRendererRecord>(
+                            registry, entities, chunk, file,
+                            [](const CircleRendererRecord &record, CircleRendererComponent &crc)
+                            {
+                                crc.Color = record.Color;
+                                crc.Radius = record.Radius;
+                                crc.Thickness = record.Thickness;
+                                crc.Fade = record.Fade;
+                            });
+                    break;
+                case SceneChunkType::Rigidbody2D:
+                    InsertChunk<Rigidbody2DComponent, Rigidbody2DRecord>(
+                            registry, entities, chunk, file,
+                            [](const Rigidbody2DRecord &record, Rigidbody2DComponent &rbc)
+                            {
+                                rbc.Type = (Rigidbody2DComponent::BodyType)record.BodyType;
+                                rbc.FixedRotation = record.FixedRotation != 0;
+                            });
+                    break;
+                case SceneChunkType::BoxCollider2D:
+                    InsertChunk<BoxCollider2DComponent, BoxCollider2DRecord>(
+                            registry, entities, chunk, file,
+                            [](const BoxCollider2DRecord &record, BoxCollider2DComponent &bcc)
+                            {
+                                bcc.Offset = record.Offset;
+                                bcc.Size = record.Size;
+                                bcc.Density = record.Density;
+                                bcc.Friction = record.Friction;
+                                bcc.Restitution = record.Restitution;
+                                bcc.RestitutionThreshold = record.RestitutionThreshold;
+                                bcc.IsSensor = record.IsSensor != 0;
+                                bcc.CategoryBits = record.CategoryBits;
+                                bcc.MaskBits = record.MaskBits;
+                            });
+                    break;
+                case SceneChunkType::CircleCollider2D:
+                    InsertChunk<CircleCollider2DComponent, CircleCollider2DRecord>(
+                            registry, entities, chunk, file,
+                            [](const CircleCollider2DRecord &record, CircleCollider2DComponent &ccc)
+                            {
+                                ccc.Offset = record.Offset;
+                                ccc.Radius = record.Radius;
+                                ccc.Density = record.Density;
+                                ccc.Friction = record.Friction;
+                                ccc.Restitution = record.Restitution;
+                                ccc.RestitutionThreshold = record.RestitutionThreshold;
+                                ccc.IsSensor = record.IsSensor != 0;
+                                ccc.CategoryBits = record.CategoryBits;
+                                ccc.MaskBits = record.MaskBits;
+                            });
+                    break;
+                case SceneChunkType::SpriteAnimation:
+                    InsertChunk<SpriteAnimationComponent, SpriteAnimationRecord>(
+                            registry, entities, chunk, file,
+                            [](const SpriteAnimationRecord &record, SpriteAnimationComponent &sac)
+                            {
+                                sac.AnimationHandle = record.AnimationHandle;
+                                sac.FrameRate = record.FrameRate;
+                                sac.Playing = record.Playing != 0;
+                            });
+                    break;
+                default:
+                    // Tag / Transform 已在上面处理，未知类型已跳过
+                    break;
+            }
+        }
+        if (m_Progress)
+            m_Progress->EntitiesLoaded.store(header.EntityCount, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    bool SceneBinarySerializer::ConvertYamlToBinary(const std::filesystem::path &yamlPath,
+                                                    const std::filesystem::path &binaryPath)
+    {
+        Ref<Scene> scene = CreateRef<Scene>();
+        SceneSerializer yamlSerializer(scene);
+        if (!yamlSerializer.Deserialize(yamlPath.string()))
+            return false;
+
+        SceneBinarySerializer binarySerializer(scene);
+        return binarySerializer.Serialize(binaryPath);
+    }
+
+    bool SceneBinarySerializer::ConvertBinaryToYaml(const std::filesystem::path &binaryPath,
+                                                    const std::filesystem::path &yamlPath)
+    {
+        Ref<Scene> scene = CreateRef<Scene>();
+        SceneBinarySerializer binarySerializer(scene);
+        if (!binarySerializer.Deserialize(binaryPath))
+            return false;
+
+        SceneSerializer yamlSerializer(scene);
+        yamlSerializer.Serialize(yamlPath.string());
+        return true;
+    }
+} // namespace Himii
@@ -0,0 +1,46 @@
+#pragma once
+#include "Himii/Scene/Scene.h"
+#include "Himii/Asset/VirtualFileSystem.h"
+#include "Himii/Scene/SceneSerializer.h"
+
+#include <filesystem>
+
+namespace Himii
+{
+    // 二进制场景格式（.hscn）：按组件类型分块，每块是实体下标数组 + 连续的 POD 记录，字符串集中在字符串表。
+    // 读取时整个文件内存映射，每种组件一次性批量插入 entt 存储，内容与 YAML 场景一一对应
+    class SceneBinarySerializer {
+    public:
+        SceneBinarySerializer(const Ref<Scene> &scene);
+
+        bool Serialize(const std::filesystem::path &filepath);
+        bool Deserialize(const std::filesystem::path &filepath);
+        // 文件已经读入内存时使用（例如 SceneSerializer 按文件头识别出烘焙后的二进制场景）
+        bool Deserialize(const VirtualFile &file, const std::filesystem::path &filepath);
+
+        // 与 SceneSerializer::SetDeferredTextureLoads 相同，设置后可在工作线程读取；
+        // Serialize 时没有 Texture 的精灵按列表中的 Handle 和路径写出
+        void SetDeferredTextureLoads(std::vector<PendingSpriteTexture> *pending)
+        {
+            m_PendingTextures = pending;
+        }
+
+        // 与 SceneSerializer::SetProgress 相同；组件按块批量插入，进度按已处理的块推进
+        void SetProgress(SceneLoadProgress *progress)
+        {
+            m_Progress = progress;
+        }
+
+        static bool IsBinaryScenePath(const std::filesystem::path &filepath);
+        static bool IsBinarySceneData(const uint8_t *data, size_t size);
+
+        // YAML 与二进制互转，经过一个临时 Scene，双向无损
+        static bool ConvertYamlToBinary(const std::filesystem::path &yamlPath, const std::filesystem::path &binaryPath);
+        static bool ConvertBinaryToYaml(const std::filesystem::path &binaryPath, const std::filesystem::path &yamlPath);
+
+    private:
+        Ref<Scene> m_Scene{};
+        std::vector<PendingSpriteTexture> *m_PendingTextures = nullptr;
+        SceneLoadProgress *m_Progress = nullptr;
+    };
+} // namespace Himii
@@ -4,6 +4,9 @@
 #include "Himii/Scene/Entity.h"
 #include "Himii/Scene/Components.h"
 #include "Himii/Core/UUID.h"
+#include "Himii/Project/Project.h"
+#include "Himii/Asset/VirtualFileSystem.h"
+#include "Himii/Scene/SceneBinarySerializer.h"
 
 #include <fstream>
 
@@ -111,6 +114,46 @@ namespace Himii
         return out;
     }
 
+    // 旧场景保存的是 Texture2D::Create 时的文件系统路径，尽量转换为相对资产目录的路径；
+    // 资产目录之外的文件保留绝对路径，GetAssetFileSystemPath 拼接绝对路径时会直接使用它
+    static std::filesystem::path ToAssetRelativePath(const std::filesystem::path &path)
+    {
+        std::filesystem::path assetDirectory = Project::GetAssetDirectory();
+        if (path.is_relative() && VirtualFileSystem::Exists(assetDirectory / path))
+            return path.lexically_normal();
+
+        std::filesystem::path absolutePath = std::filesystem::absolute(path).lexically_normal();
+        std::filesystem::path relativePath =
+                absolutePath.lexically_relative(std::filesystem::absolute(assetDirectory).lexically_normal());
+        if (relativePath.empty() || *relativePath.begin() == "..")
+            return absolutePath;
+        return relativePath;
+    }
+
+    // 精灵纹理统一经过 AssetManager，同一纹理只加载一次
+    Ref<Texture2D> SceneSerializer::LoadSpriteTexture(AssetHandle &handle, const std::string &texturePath)
+    {
+        auto assetManager = Project::GetActive() ? Project::GetAssetManager() : nullptr;
+        if (!assetManager)
+            return texturePath.empty() ? nullptr : Texture2D::Create(texturePath);
+
+        if (!assetManager->IsAssetHandleValid(handle))
+        {
+            // Handle 不在注册表中（旧场景，或注册表没有随场景保存），按路径重新导入
+            handle = texturePath.empty() ? AssetHandle(0) : assetManager->ImportAsset(ToAssetRelativePath(texturePath));
+            if (handle == 0)
+                return nullptr;
+        }
+
+        if (assetManager->GetMetadata(handle).Type != AssetType::Texture2D)
+        {
+            HIMII_CORE_WARNING("Sprite texture asset {0} is not a Texture2D", (uint64_t)handle);
+            handle = 0;
+            return nullptr;
+        }
+        return assetManager->GetAsset<Texture2D>(handle);
+    }
+
     SceneSerializer::SceneSerializer(const Ref<Scene> &scene) : m_Scene(scene)
     {
     }
@@ -183,7 +226,20 @@ namespace Himii
             auto &spriteRenderer = entity.GetComponent<SpriteRendererComponent>();
             out << YAML::Key << "Color" << YAML::Value << spriteRenderer.Color;
             if (spriteRenderer.Texture)
-                out << YAML::Key << "TexturePath" << YAML::Value << spriteRenderer.Texture->GetPath();
+            {
+                auto assetManager = Project::GetActive() ? Project::GetAssetManager() : nullptr;
+                if (assetManager && assetManager->IsAssetHandleValid(spriteRenderer.TextureHandle))
+                {
+                    // 路径作为注册表丢失时的后备
+                    out << YAML::Key << "TextureHandle" << YAML::Value << (uint64_t)spriteRenderer.TextureHandle;
+                    out << YAML::Key << "TexturePath" << YAML::Value
+                        << assetManager->GetMetadata(spriteRenderer.TextureHandle).FilePath.generic_string();
+                }
+                else
+                {
+                    out << YAML::Key << "TexturePath" << YAML::Value << spriteRenderer.Texture->GetPath();
+                }
+            }
             out << YAML::Key << "TilingFactor" << YAML::Value << spriteRenderer.TilingFactor;
             out << YAML::EndMap;
         }
@@ -217,6 +273,9 @@ namespace Himii
             out << YAML::Key << "Friction" << YAML::Value << boxCollider2D.Friction;
             out << YAML::Key << "Restitution" << YAML::Value << boxCollider2D.Restitution;
             out << YAML::Key << "RestitutionThreshold" << YAML::Value << boxCollider2D.RestitutionThreshold;
+            out << YAML::Key << "IsSensor" << YAML::Value << boxCollider2D.IsSensor;
+            out << YAML::Key << "CategoryBits" << YAML::Value << YAML::Hex << boxCollider2D.CategoryBits << YAML::Dec;
+            out << YAML::Key << "MaskBits" << YAML::Value << YAML::Hex << boxCollider2D.MaskBits << YAML::Dec;
             out << YAML::EndMap;
         }
         if (entity.HasComponent<CircleCollider2DComponent>())
@@ -230,6 +289,9 @@ namespace Himii
             out << YAML::Key << "Friction" << YAML::Value << circleCollider2D.Friction;
             out << YAML::Key << "Restitution" << YAML::Value << circleCollider2D.Restitution;
             out << YAML::Key << "RestitutionThreshold" << YAML::Value << circleCollider2D.RestitutionThreshold;
+            out << YAML::Key << "IsSensor" << YAML::Value << circleCollider2D.IsSensor;
+            out << YAML::Key << "CategoryBits" << YAML::Value << YAML::Hex << circleCollider2D.CategoryBits << YAML::Dec;
+            out << YAML::Key << "MaskBits" << YAML::Value << YAML::Hex << circleCollider2D.MaskBits << YAML::Dec;
             out << YAML::EndMap;
         }
         if (entity.HasComponent<SpriteAnimationComponent>())
@@ -273,10 +335,26 @@ namespace Himii
 
     bool SceneSerializer::Deserialize(const std::string &filepath)
     {
+        VirtualFile file;
+        if (!VirtualFileSystem::ReadFile(filepath, file))
+        {
+            HIMII_CORE_ERROR("Failed to read scene file '{0}'", filepath);
+            return false;
+        }
+
+        // 构建时烘焙的场景保留 .himii 文件名，内容已是二进制格式
+        if (SceneBinarySerializer::IsBinarySceneData(file.GetData(), file.GetSize()))
+        {
+            SceneBinarySerializer serializer(m_Scene);
+            serializer.SetDeferredTextureLoads(m_PendingTextures);
+            serializer.SetProgress(m_Progress);
+            return serializer.Deserialize(file, filepath);
+        }
+
         YAML::Node data;
         try
         {
-            data = YAML::LoadFile(filepath);
+            data = YAML::Load(std::string(reinterpret_cast<const char *>(file.GetData()), file.GetSize()));
         }
         catch (YAML::ParserException &e)
         {
@@ -291,15 +369,38 @@ namespace Himii
         auto entities = data["Entities"];
         if (entities)
         {
+            if (m_Progress)
+                m_Progress->EntityCount.store((uint32_t)entities.size(), std::memory_order_relaxed);
             for (auto entity: entities)
             {
-                DeserializeEntity(entity, m_Scene);
+                DeserializeEntity(entity, m_Scene, m_PendingTextures);
+                if (m_Progress)
+                    m_Progress->EntitiesLoaded.fetch_add(1, std::memory_order_relaxed);
             }
         }
+
+        // 纹理去重统计：请求数是带纹理的精灵数，实际加载数是不同 Texture 的数量
+        uint32_t requestedTextures = 0;
+        std::unordered_set<const Texture2D *> uniqueTextures;
+        auto view = m_Scene->m_Registry.view<SpriteRendererComponent>();
+        for (auto e: view)
+        {
+            const auto &sprite = view.get<SpriteRendererComponent>(e);
+            if (sprite.Texture)
+            {
+                ++requestedTextures;
+                uniqueTextures.insert(sprite.Texture.get());
+            }
+        }
+        if (requestedTextures > 0)
+            HIMII_CORE_INFO("Scene '{0}': {1} sprite textures requested, {2} unique loaded", sceneName,
+                            requestedTextures, uniqueTextures.size());
+
         return true;
     }
 
-    void SceneSerializer::DeserializeEntity(YAML::Node& entity, Ref<Scene> scene)
+    void SceneSerializer::DeserializeEntity(YAML::Node& entity, Ref<Scene> scene,
+                                            std::vector<PendingSpriteTexture> *pendingTextures)
     {
         uint64_t uuid = entity["Entity"].as<uint64_t>();
 
@@ -355,11 +456,17 @@ namespace Himii
             auto &src = deserializedEntity.AddComponent<SpriteRendererComponent>();
             src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
 
-            if (spriteRendererComponent["TexturePath"])
+            if (spriteRendererComponent["TextureHandle"] || spriteRendererComponent["TexturePath"])
             {
-                std::string texturePath = spriteRendererComponent["TexturePath"].as<std::string>();
-                //auto path = Project::GetAssetFileSystemPath(texturePath);
-                src.Texture = Texture2D::Create(texturePath);
+                if (spriteRendererComponent["TextureHandle"])
+                    src.TextureHandle = spriteRendererComponent["TextureHandle"].as<uint64_t>();
+                std::string texturePath;
+                if (spriteRendererComponent["TexturePath"])
+                    texturePath = spriteRendererComponent["TexturePath"].as<std::string>();
+                if (pendingTextures)
+                    pendingTextures->push_back({(entt::entity)deserializedEntity, src.TextureHandle, texturePath});
+                else
+                    src.Texture = LoadSpriteTexture(src.TextureHandle, texturePath);
             }
             if (spriteRendererComponent["TilingFactor"])
             {
@@ -392,6 +499,12 @@ namespace Himii
             bcc.Friction = boxCollider2DComponent["Friction"].as<float>();
             bcc.Restitution = boxCollider2DComponent["Restitution"].as<float>();
             bcc.RestitutionThreshold = boxCollider2DComponent["RestitutionThreshold"].as<float>();
+            if (boxCollider2DComponent["IsSensor"])
+                bcc.IsSensor = boxCollider2DComponent["IsSensor"].as<bool>();
+            if (boxCollider2DComponent["CategoryBits"])
+                bcc.CategoryBits = boxCollider2DComponent["CategoryBits"].as<uint32_t>();
+            if (boxCollider2DComponent["MaskBits"])
+                bcc.MaskBits = boxCollider2DComponent["MaskBits"].as<uint32_t>();
         }
         auto circleCollider2DComponent = entity["CircleCollider2DComponent"];
         if (circleCollider2DComponent)
@@ -403,6 +516,12 @@ namespace Himii
             ccc.Friction = circleCollider2DComponent["Friction"].as<float>();
             ccc.Restitution = circleCollider2DComponent["Restitution"].as<float>();
             ccc.RestitutionThreshold = circleCollider2DComponent["RestitutionThreshold"].as<float>();
+            if (circleCollider2DComponent["IsSensor"])
+                ccc.IsSensor = circleCollider2DComponent["IsSensor"].as<bool>();
+            if (circleCollider2DComponent["CategoryBits"])
+                ccc.CategoryBits = circleCollider2DComponent["CategoryBits"].as<uint32_t>();
+            if (circleCollider2DComponent["MaskBits"])
+                ccc.MaskBits = circleCollider2DComponent["MaskBits"].as<uint32_t>();
         }
         auto spriteAnimationComponent = entity["SpriteAnimationComponent"];
         if (spriteAnimationComponent)
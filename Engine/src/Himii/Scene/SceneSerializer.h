@@ -1,9 +1,25 @@
 #pragma once
 #include "Himii/Scene/Scene.h"
+#include "Himii/Renderer/Texture.h"
 #include <yaml-cpp/yaml.h>
 
+#include <atomic>
+
 namespace Himii {
 
+// 后台加载场景时纹理不能在工作线程创建，先记录下来，由主线程调用 LoadSpriteTexture 补上
+struct PendingSpriteTexture {
+    entt::entity Entity = entt::null;
+    AssetHandle Handle = 0;
+    std::string Path;
+};
+
+// 反序列化进度：工作线程写入，主线程读取用于显示加载进度
+struct SceneLoadProgress {
+    std::atomic<uint32_t> EntityCount{0};
+    std::atomic<uint32_t> EntitiesLoaded{0};
+};
+
 // 简单的 YAML 场景序列化/反序列化器
 class SceneSerializer {
 public:
@@ -15,10 +31,28 @@ public:
     bool Deserialize(const std::string &filepath);
     bool DeserializeRuntime(const std::string &filepath);
 
+    // 设置后 Deserialize 不访问 AssetManager，精灵纹理写入 pending，可在工作线程调用
+    void SetDeferredTextureLoads(std::vector<PendingSpriteTexture> *pending)
+    {
+        m_PendingTextures = pending;
+    }
+
+    // 设置后 Deserialize 在文档解析完成后写入实体总数，并随反序列化逐个累加已完成的实体数
+    void SetProgress(SceneLoadProgress *progress)
+    {
+        m_Progress = progress;
+    }
+
     static void SerializeEntity(YAML::Emitter &out, Entity entity);
-    static void DeserializeEntity(YAML::Node& entityNode, Ref<Scene> scene);
+    static void DeserializeEntity(YAML::Node& entityNode, Ref<Scene> scene,
+                                  std::vector<PendingSpriteTexture> *pendingTextures = nullptr);
+
+    // 按 Handle（失效时按路径导入）经 AssetManager 取精灵纹理，二进制场景格式共用
+    static Ref<Texture2D> LoadSpriteTexture(AssetHandle &handle, const std::string &texturePath);
 
 private:
     Ref<Scene> m_Scene{};
+    std::vector<PendingSpriteTexture> *m_PendingTextures = nullptr;
+    SceneLoadProgress *m_Progress = nullptr;
 };
 }
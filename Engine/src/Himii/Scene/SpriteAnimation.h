@@ -1,10 +1,17 @@
 #pragma once
 
 #include <vector>
+#include <glm/glm.hpp>
 #include "Himii/Asset/Asset.h"
 
 namespace Himii
 {
+    // 精灵表中的一帧：纹理内的 UV 矩形（左下角/右上角）和持续时间
+    struct SpriteSheetFrame {
+        glm::vec2 UVMin{0.0f, 0.0f};
+        glm::vec2 UVMax{1.0f, 1.0f};
+        float Duration = 0.0f; // 秒，0 表示使用组件上的 FrameRate
+    };
 
     class SpriteAnimation : public Asset {
     public:
@@ -34,12 +41,57 @@ namespace Himii
             return 0;
         }
 
+        // 精灵表模式：所有帧共用一张纹理，帧只是其中的 UV 矩形
+        bool IsSpriteSheet() const
+        {
+            return m_SpriteSheet != 0;
+        }
+
+        void SetSpriteSheet(AssetHandle textureHandle)
+        {
+            m_SpriteSheet = textureHandle;
+        }
+
+        AssetHandle GetSpriteSheet() const
+        {
+            return m_SpriteSheet;
+        }
+
+        void AddSheetFrame(const SpriteSheetFrame &frame)
+        {
+            m_SheetFrames.push_back(frame);
+        }
+
+        void ClearSheetFrames()
+        {
+            m_SheetFrames.clear();
+        }
+
+        std::vector<SpriteSheetFrame> &GetSheetFrames()
+        {
+            return m_SheetFrames;
+        }
+
+        const std::vector<SpriteSheetFrame> &GetSheetFrames() const
+        {
+            return m_SheetFrames;
+        }
+
         size_t GetFrameCount() const
         {
-            return m_Frames.size();
+            return IsSpriteSheet() ? m_SheetFrames.size() : m_Frames.size();
+        }
+
+        virtual uint64_t GetMemorySize() const override
+        {
+            return sizeof(SpriteAnimation) + m_Frames.capacity() * sizeof(AssetHandle) +
+                   m_SheetFrames.capacity() * sizeof(SpriteSheetFrame);
         }
 
     private:
         std::vector<AssetHandle> m_Frames;
+
+        AssetHandle m_SpriteSheet = 0;
+        std::vector<SpriteSheetFrame> m_SheetFrames;
     };
 } // namespace Himii
@@ -0,0 +1,178 @@
+#include "Hepch.h"
+#include "SpriteAnimationSystem.h"
+
+#include <cmath>
+
+#include "Components.h"
+#include "Himii/Asset/AssetManager.h"
+#include "Himii/Project/Project.h"
+#include "Himii/Scene/SpriteAnimation.h"
+
+namespace Himii
+{
+    void SpriteAnimationSystem::OnRuntimeStart(entt::registry &registry)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        OnRuntimeStop();
+
+        auto view = registry.view<SpriteAnimationComponent>();
+        for (auto e: view)
+        {
+            auto &animation = view.get<SpriteAnimationComponent>(e);
+            animation.RuntimeClip = BakeClip(animation.AnimationHandle);
+            animation.RuntimeClipHandle = animation.AnimationHandle;
+        }
+
+        HIMII_CORE_INFO("SpriteAnimationSystem: baked {0} clips, {1} frames", m_Clips.size(), m_Frames.size());
+    }
+
+    void SpriteAnimationSystem::OnRuntimeStop()
+    {
+        m_Frames.clear();
+        m_Clips.clear();
+        m_ClipLookup.clear();
+    }
+
+    void SpriteAnimationSystem::OnUpdate(entt::registry &registry, Timestep ts)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        auto group = registry.group<SpriteAnimationComponent, SpriteRendererComponent>();
+        for (auto e: group)
+        {
+            auto [animation, sprite] = group.get<SpriteAnimationComponent, SpriteRendererComponent>(e);
+            if (!animation.Playing)
+                continue;
+
+            // 运行中新建的实体或脚本切换了动画，首次遇到时再烘焙
+            if (animation.RuntimeClipHandle != animation.AnimationHandle)
+            {
+                animation.RuntimeClip = BakeClip(animation.AnimationHandle);
+                animation.RuntimeClipHandle = animation.AnimationHandle;
+            }
+            if (animation.RuntimeClip < 0)
+                continue;
+
+            const BakedClip &clip = m_Clips[animation.RuntimeClip];
+            if ((uint32_t)animation.CurrentFrame >= clip.FrameCount)
+                animation.CurrentFrame = 0;
+
+            float frameDuration = animation.FrameRate > 0.0f ? 1.0f / animation.FrameRate : 0.0f;
+            if (clip.HasFrameDurations)
+            {
+                // 未指定时长的帧没有可用的 FrameRate 时保持当前帧
+                if (clip.UntimedFrameCount > 0 && frameDuration <= 0.0f)
+                    continue;
+
+                animation.Timer += ts;
+
+                // 先跳过整圈，长时间卡顿后不需要逐帧循环
+                float cycle = clip.TimedDuration + clip.UntimedFrameCount * frameDuration;
+                if (animation.Timer >= cycle)
+                    animation.Timer = std::fmod(animation.Timer, cycle);
+
+                for (;;)
+                {
+                    float duration = m_Frames[clip.FirstFrame + animation.CurrentFrame].Duration;
+                    if (duration <= 0.0f)
+                        duration = frameDuration;
+                    if (animation.Timer < duration)
+                        break;
+
+                    animation.Timer -= duration;
+                    animation.CurrentFrame = (int)((animation.CurrentFrame + 1) % clip.FrameCount);
+                }
+            }
+            else
+            {
+                if (frameDuration <= 0.0f)
+                    continue;
+
+                // 一帧内可能跨过多帧（低帧率或动画帧率高于游戏帧率）
+                animation.Timer += ts;
+                if (animation.Timer >= frameDuration)
+                {
+                    uint32_t advance = (uint32_t)(animation.Timer / frameDuration);
+                    animation.Timer -= advance * frameDuration;
+                    animation.CurrentFrame = (int)((animation.CurrentFrame + advance) % clip.FrameCount);
+                }
+            }
+
+            // 只在帧真正变化时赋值，避免每帧的引用计数读写；精灵表的帧共用纹理，只改 UV
+            const BakedFrame &frame = m_Frames[clip.FirstFrame + animation.CurrentFrame];
+            if (sprite.Texture != frame.Texture)
+                sprite.Texture = frame.Texture;
+            sprite.UVMin = frame.UVMin;
+            sprite.UVMax = frame.UVMax;
+        }
+    }
+
+    int32_t SpriteAnimationSystem::BakeClip(AssetHandle handle)
+    {
+        if (handle == 0)
+            return -1;
+
+        auto it = m_ClipLookup.find(handle);
+        if (it != m_ClipLookup.end())
+            return it->second;
+
+        int32_t clipIndex = -1;
+        auto assetManager = Project::GetAssetManager();
+        if (assetManager && assetManager->IsAssetHandleValid(handle))
+        {
+            Ref<SpriteAnimation> animation = std::static_pointer_cast<SpriteAnimation>(assetManager->GetAsset(handle));
+            if (animation && animation->GetFrameCount() > 0)
+            {
+                BakedClip clip;
+                clip.FirstFrame = (uint32_t)m_Frames.size();
+                clip.FrameCount = (uint32_t)animation->GetFrameCount();
+
+                if (animation->IsSpriteSheet())
+                {
+                    Ref<Texture2D> sheet;
+                    if (assetManager->IsAssetHandleValid(animation->GetSpriteSheet()))
+                        sheet = std::static_pointer_cast<Texture2D>(assetManager->GetAsset(animation->GetSpriteSheet()));
+
+                    for (const SpriteSheetFrame &sheetFrame: animation->GetSheetFrames())
+                    {
+                        BakedFrame frame;
+                        frame.Texture = sheet;
+                        frame.UVMin = sheetFrame.UVMin;
+                        frame.UVMax = sheetFrame.UVMax;
+                        frame.Duration = sheetFrame.Duration;
+                        m_Frames.push_back(frame);
+
+                        if (sheetFrame.Duration > 0.0f)
+                        {
+                            clip.HasFrameDurations = true;
+                            clip.TimedDuration += sheetFrame.Duration;
+                        }
+                        else
+                        {
+                            ++clip.UntimedFrameCount;
+                        }
+                    }
+                }
+                else
+                {
+                    // 帧纹理在这里一次性加载，运行中切帧不会再触发磁盘读取
+                    for (AssetHandle frameHandle: animation->GetFrames())
+                    {
+                        BakedFrame frame;
+                        if (assetManager->IsAssetHandleValid(frameHandle))
+                            frame.Texture = std::static_pointer_cast<Texture2D>(assetManager->GetAsset(frameHandle));
+                        m_Frames.push_back(frame);
+                    }
+                }
+
+                clipIndex = (int32_t)m_Clips.size();
+                m_Clips.push_back(clip);
+            }
+        }
+
+        // 无效动画也记录下来，避免每帧重复查询
+        m_ClipLookup[handle] = clipIndex;
+        return clipIndex;
+    }
+} // namespace Himii
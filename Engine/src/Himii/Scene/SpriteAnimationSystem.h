@@ -0,0 +1,49 @@
+#pragma once
+
+#include <entt/entt.hpp>
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+#include "Himii/Asset/Asset.h"
+#include "Himii/Core/Core.h"
+#include "Himii/Core/Timestep.h"
+#include "Himii/Renderer/Texture.h"
+
+namespace Himii
+{
+    // 运行时帧动画：开始运行时把动画资产烘焙成连续的帧表，每帧更新不再查询 AssetManager
+    class SpriteAnimationSystem {
+    public:
+        void OnRuntimeStart(entt::registry &registry);
+        void OnRuntimeStop();
+
+        void OnUpdate(entt::registry &registry, Timestep ts);
+
+    private:
+        struct BakedFrame {
+            Ref<Texture2D> Texture;
+            glm::vec2 UVMin{0.0f, 0.0f};
+            glm::vec2 UVMax{1.0f, 1.0f};
+            float Duration = 0.0f; // 0 表示使用组件的 FrameRate
+        };
+
+        struct BakedClip {
+            uint32_t FirstFrame = 0;
+            uint32_t FrameCount = 0;
+            // 有帧带自己的时长时按帧推进，未指定时长的帧仍使用组件 FrameRate
+            bool HasFrameDurations = false;
+            uint32_t UntimedFrameCount = 0;
+            float TimedDuration = 0.0f;
+        };
+
+        // 返回帧表中的 clip 索引，无效动画返回 -1；同一资产只烘焙一次
+        int32_t BakeClip(AssetHandle handle);
+
+    private:
+        // 所有 clip 的帧首尾相接存放，clip 只记录区间
+        std::vector<BakedFrame> m_Frames;
+        std::vector<BakedClip> m_Clips;
+        std::unordered_map<AssetHandle, int32_t> m_ClipLookup;
+    };
+} // namespace Himii
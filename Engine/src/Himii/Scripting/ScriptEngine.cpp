@@ -39,13 +39,19 @@ namespace Himii {
 
 	typedef void(CORECLR_DELEGATE_CALLTYPE *OnCreateFn)(uint64_t entityID, const char *className);
     typedef void(CORECLR_DELEGATE_CALLTYPE *OnUpdateFn)(uint64_t entityID, float ts);
+    typedef void(CORECLR_DELEGATE_CALLTYPE *OnRuntimeStopFn)();
     typedef void(CORECLR_DELEGATE_CALLTYPE *LoadAssemblyFn)(const char *filepath);
     typedef bool(CORECLR_DELEGATE_CALLTYPE *ClassExistsFn)(const char *className);
+    typedef void(CORECLR_DELEGATE_CALLTYPE *OnPhysics2DEventsFn)(const ContactEvent2D *beginEvents, int32_t beginCount,
+                                                                 const ContactEvent2D *endEvents, int32_t endCount,
+                                                                 const ContactHitEvent2D *hitEvents, int32_t hitCount);
 
     static LoadAssemblyFn s_LoadGameAssembly = nullptr;
     static ClassExistsFn s_EntityClassExists = nullptr;
     static OnCreateFn s_OnCreate = nullptr;
     static OnUpdateFn s_OnUpdate = nullptr;
+    static OnRuntimeStopFn s_OnRuntimeStop = nullptr;
+    static OnPhysics2DEventsFn s_OnPhysics2DEvents = nullptr;
 
 	// 加载 hostfxr 库
 	static bool LoadHostFxr()
@@ -198,6 +204,13 @@ namespace Himii {
             nullptr,
             (void**)&s_OnUpdate);
 
+        load_assembly_and_get_function_pointer(filepath.c_str(), STR("Himii.ScriptManager, ScriptCore"),
+                                               STR("OnRuntimeStop"), UNMANAGEDCALLERSONLY_METHOD, nullptr,
+                                               (void **)&s_OnRuntimeStop);
+
+        load_assembly_and_get_function_pointer(filepath.c_str(), STR("Himii.ScriptManager, ScriptCore"),
+                                               STR("OnPhysics2DEvents"), UNMANAGEDCALLERSONLY_METHOD, nullptr,
+                                               (void **)&s_OnPhysics2DEvents);
 
     }
 
@@ -264,6 +277,10 @@ namespace Himii {
 
     void ScriptEngine::OnRuntimeStop()
     {
+        // C# 侧的碰撞订阅和脚本实例只属于本次运行
+        if (s_OnRuntimeStop)
+            s_OnRuntimeStop();
+        s_SceneContext = nullptr;
     }
 
     void ScriptEngine::OnUpdateScript(Entity entity, Timestep ts)
@@ -275,6 +292,16 @@ namespace Himii {
         }
     }
 
+    void ScriptEngine::OnPhysics2DEvents(const Physics2DEvents &events)
+    {
+        if (!s_OnPhysics2DEvents || events.Empty())
+            return;
+
+        s_OnPhysics2DEvents(events.BeginEvents.data(), (int32_t)events.BeginEvents.size(), events.EndEvents.data(),
+                            (int32_t)events.EndEvents.size(), events.HitEvents.data(),
+                            (int32_t)events.HitEvents.size());
+    }
+
     bool ScriptEngine::EntityClassExists(const std::string &fullClassName)
     {
         if (fullClassName.empty())
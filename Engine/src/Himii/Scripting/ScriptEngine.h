@@ -26,6 +26,8 @@ namespace Himii {
         static void OnRuntimeStop();
 
 		static void OnUpdateScript(Entity entity, Timestep ts);
+        // 一帧的物理事件一次性交给 C#
+        static void OnPhysics2DEvents(const Physics2DEvents &events);
 
 		static bool EntityClassExists(const std::string &fullClassName);
 
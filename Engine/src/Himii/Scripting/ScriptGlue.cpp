@@ -6,6 +6,7 @@
 #include "Himii/Scene/Components.h"
 #include "Himii/Core/Input.h"
 #include "Himii/Core/KeyCodes.h"
+#include "Himii/Physics/Physics2D.h"
 #include <iostream>
 
 namespace Himii {
@@ -193,7 +194,7 @@ namespace Himii {
         if (entity.HasComponent<Rigidbody2DComponent>())
         {
             auto &rb2d = entity.GetComponent<Rigidbody2DComponent>();
-            b2BodyId bodyId = b2BodyId{(int32_t)(uintptr_t)rb2d.RuntimeBody}; // 这里的转换取决于你的 ToBodyId 实现
+            b2BodyId bodyId = Physics2DUtils::PtrToBodyId(rb2d.RuntimeBody);
             if (b2Body_IsValid(bodyId))
             {
                 b2Body_ApplyLinearImpulse(bodyId, {impulse->x, impulse->y}, {point->x, point->y}, wake);
@@ -213,8 +214,7 @@ namespace Himii {
         if (entity.HasComponent<Rigidbody2DComponent>())
         {
             auto &rb2d = entity.GetComponent<Rigidbody2DComponent>();
-            // 同样的获取 Body 逻辑...
-            b2BodyId bodyId = *(b2BodyId *)&rb2d.RuntimeBody; // 简化转换
+            b2BodyId bodyId = Physics2DUtils::PtrToBodyId(rb2d.RuntimeBody);
             if (b2Body_IsValid(bodyId))
             {
                 b2Body_ApplyLinearImpulseToCenter(bodyId, {impulse->x, impulse->y}, wake);
@@ -232,7 +232,7 @@ namespace Himii {
             return;
 
         auto &rb2d = entity.GetComponent<Rigidbody2DComponent>();
-        b2BodyId bodyId = *(b2BodyId *)&rb2d.RuntimeBody;
+        b2BodyId bodyId = Physics2DUtils::PtrToBodyId(rb2d.RuntimeBody);
         if (b2Body_IsValid(bodyId))
         {
             b2Vec2 vel = b2Body_GetLinearVelocity(bodyId);
@@ -251,7 +251,7 @@ namespace Himii {
             return;
 
         auto &rb2d = entity.GetComponent<Rigidbody2DComponent>();
-        b2BodyId bodyId = *(b2BodyId *)&rb2d.RuntimeBody;
+        b2BodyId bodyId = Physics2DUtils::PtrToBodyId(rb2d.RuntimeBody);
         if (b2Body_IsValid(bodyId))
         {
             b2Body_SetLinearVelocity(bodyId, {velocity->x, velocity->y});
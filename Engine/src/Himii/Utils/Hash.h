@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Himii
+{
+    namespace Hash
+    {
+        constexpr uint64_t FNV1aOffsetBasis = 0xcbf29ce484222325ull;
+        constexpr uint64_t FNV1aPrime = 0x100000001b3ull;
+
+        // 64 位 FNV-1a，用于内容校验和缓存键；可传入上一次的结果继续累加
+        inline uint64_t FNV1a64(const void *data, size_t size, uint64_t hash = FNV1aOffsetBasis)
+        {
+            const uint8_t *bytes = static_cast<const uint8_t *>(data);
+            for (size_t i = 0; i < size; i++)
+            {
+                hash ^= bytes[i];
+                hash *= FNV1aPrime;
+            }
+            return hash;
+        }
+
+        inline uint64_t FNV1a64(std::string_view text, uint64_t hash = FNV1aOffsetBasis)
+        {
+            return FNV1a64(text.data(), text.size(), hash);
+        }
+    } // namespace Hash
+} // namespace Himii
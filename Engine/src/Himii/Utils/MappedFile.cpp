@@ -0,0 +1,153 @@
+#include "Hepch.h"
+#include "Himii/Utils/MappedFile.h"
+
+#ifndef HIMII_PLATFORM_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Himii
+{
+    MappedFile::MappedFile(const std::filesystem::path &filepath)
+    {
+        Open(filepath);
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile &&other) noexcept
+    {
+        *this = std::move(other);
+    }
+
+    MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+    {
+        if (this != &other)
+        {
+            Close();
+            m_Data = other.m_Data;
+            m_Size = other.m_Size;
+            m_IsOpen = other.m_IsOpen;
+#ifdef HIMII_PLATFORM_WINDOWS
+            m_FileHandle = other.m_FileHandle;
+            m_MappingHandle = other.m_MappingHandle;
+            other.m_FileHandle = nullptr;
+            other.m_MappingHandle = nullptr;
+#endif
+            other.m_Data = nullptr;
+            other.m_Size = 0;
+            other.m_IsOpen = false;
+        }
+        return *this;
+    }
+
+#ifdef HIMII_PLATFORM_WINDOWS
+    bool MappedFile::Open(const std::filesystem::path &filepath)
+    {
+        Close();
+
+        HANDLE file = CreateFileW(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        m_FileHandle = file;
+        m_Size = (size_t)size.QuadPart;
+        m_IsOpen = true;
+
+        // 空文件无法创建映射
+        if (m_Size == 0)
+            return true;
+
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping)
+        {
+            Close();
+            return false;
+        }
+        m_MappingHandle = mapping;
+
+        m_Data = static_cast<const uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!m_Data)
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_MappingHandle)
+            CloseHandle((HANDLE)m_MappingHandle);
+        if (m_FileHandle)
+            CloseHandle((HANDLE)m_FileHandle);
+
+        m_Data = nullptr;
+        m_MappingHandle = nullptr;
+        m_FileHandle = nullptr;
+        m_Size = 0;
+        m_IsOpen = false;
+    }
+#else
+    bool MappedFile::Open(const std::filesystem::path &filepath)
+    {
+        Close();
+
+        int fd = open(filepath.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0)
+        {
+            close(fd);
+            return false;
+        }
+
+        m_Size = (size_t)info.st_size;
+        m_IsOpen = true;
+
+        if (m_Size > 0)
+        {
+            void *data = mmap(nullptr, m_Size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                close(fd);
+                m_Size = 0;
+                m_IsOpen = false;
+                return false;
+            }
+            m_Data = static_cast<const uint8_t *>(data);
+        }
+
+        // 映射建立后文件描述符可以直接关闭
+        close(fd);
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            munmap(const_cast<uint8_t *>(m_Data), m_Size);
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_IsOpen = false;
+    }
+#endif
+} // namespace Himii
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace Himii
+{
+    // 只读内存映射文件，析构时自动解除映射
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::filesystem::path &filepath);
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+
+        // 失败返回 false（文件不存在或映射失败）；空文件成功打开但 GetData 为 nullptr
+        bool Open(const std::filesystem::path &filepath);
+        void Close();
+
+        bool IsOpen() const
+        {
+            return m_IsOpen;
+        }
+
+        const uint8_t *GetData() const
+        {
+            return m_Data;
+        }
+
+        size_t GetSize() const
+        {
+            return m_Size;
+        }
+
+    private:
+        const uint8_t *m_Data = nullptr;
+        size_t m_Size = 0;
+        bool m_IsOpen = false;
+
+#ifdef HIMII_PLATFORM_WINDOWS
+        void *m_FileHandle = nullptr;
+        void *m_MappingHandle = nullptr;
+#endif
+    };
+} // namespace Himii
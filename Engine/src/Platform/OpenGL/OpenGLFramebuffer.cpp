@@ -86,6 +86,15 @@ namespace Himii
             HIMII_CORE_ASSERT(false, "Unknown FramebufferFormat!");
             return 0;
         }
+
+        // 按粒度向上取整的分配尺寸，粒度为 0 时等于可见尺寸
+        static uint32_t GetAllocationSize(uint32_t size, uint32_t granularity)
+        {
+            if (granularity == 0)
+                return size;
+            uint32_t allocated = (size + granularity - 1) / granularity * granularity;
+            return std::min(allocated, std::max(size, s_MaxFramebufferSize));
+        }
     } // namespace Utils
 
     OpenGLFramebuffer::OpenGLFramebuffer(const FramebufferSpecification &spec) : m_Specification(spec)
@@ -101,6 +110,8 @@ namespace Himii
                 m_DepthAttachmentSpecification = spec;
             }
         }
+        m_Stats.AllocatedWidth = Utils::GetAllocationSize(m_Specification.Width, m_Specification.ResizeGranularity);
+        m_Stats.AllocatedHeight = Utils::GetAllocationSize(m_Specification.Height, m_Specification.ResizeGranularity);
         Invalidate();
     }
 
@@ -109,6 +120,14 @@ namespace Himii
         glDeleteFramebuffers(1, &m_RendererID);
         glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
         glDeleteTextures(1, &m_DepthAttachment);
+
+        for (auto &slot: m_PickSlots)
+        {
+            if (slot.Fence)
+                glDeleteSync(slot.Fence);
+            if (slot.Buffer)
+                glDeleteBuffers(1, &slot.Buffer);
+        }
     }
 
     void OpenGLFramebuffer::Invalidate()
@@ -122,6 +141,7 @@ namespace Himii
 
             m_ColorAttachments.clear();
             m_DepthAttachment = 0;
+            m_Stats.ReallocationCount++;
         }
 
         glCreateFramebuffers(1, &m_RendererID);
@@ -141,11 +161,11 @@ namespace Himii
                 {
                     case FramebufferFormat::RGBA8:
                         Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA,
-                                                  m_Specification.Width, m_Specification.Height, (int)i);
+                                                  m_Stats.AllocatedWidth, m_Stats.AllocatedHeight, (int)i);
                         break;
                     case FramebufferFormat::RED_INTEGER:
                         Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER,
-                                                  m_Specification.Width, m_Specification.Height, (int)i);
+                                                  m_Stats.AllocatedWidth, m_Stats.AllocatedHeight, (int)i);
                         break;
                     default:
                         HIMII_CORE_ASSERT(false, "Unknown FramebufferFormat!");
@@ -161,7 +181,7 @@ namespace Himii
             {
                 case FramebufferFormat::DEPTH24STENCIL8:
                     Utils::AttachDepthtexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8,
-                                             m_Specification.Width, m_Specification.Height);
+                                             m_Stats.AllocatedWidth, m_Stats.AllocatedHeight);
                     break;
             }
         }
@@ -188,10 +208,24 @@ namespace Himii
     {
         glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
         glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+
+        // 附件比可见区域大时用 scissor 把 glClear 也限制在可见区域内
+        m_ScissorEnabled = m_Stats.AllocatedWidth != m_Specification.Width ||
+                           m_Stats.AllocatedHeight != m_Specification.Height;
+        if (m_ScissorEnabled)
+        {
+            glEnable(GL_SCISSOR_TEST);
+            glScissor(0, 0, m_Specification.Width, m_Specification.Height);
+        }
     }
 
     void OpenGLFramebuffer::Unbind()
     {
+        if (m_ScissorEnabled)
+        {
+            glDisable(GL_SCISSOR_TEST);
+            m_ScissorEnabled = false;
+        }
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
     void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
@@ -204,6 +238,14 @@ namespace Himii
         m_Specification.Width = width;
         m_Specification.Height = height;
 
+        // 仍在同一档内时只改可见区域，附件保持不变
+        uint32_t allocatedWidth = Utils::GetAllocationSize(width, m_Specification.ResizeGranularity);
+        uint32_t allocatedHeight = Utils::GetAllocationSize(height, m_Specification.ResizeGranularity);
+        if (allocatedWidth == m_Stats.AllocatedWidth && allocatedHeight == m_Stats.AllocatedHeight)
+            return;
+
+        m_Stats.AllocatedWidth = allocatedWidth;
+        m_Stats.AllocatedHeight = allocatedHeight;
         Invalidate();
     }
     int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
@@ -216,6 +258,72 @@ namespace Himii
         return pixelData;
     }
 
+    void OpenGLFramebuffer::RequestPick(uint32_t attachmentIndex, int x, int y)
+    {
+        HIMII_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+
+        if (x < 0 || y < 0 || x >= (int)m_Specification.Width || y >= (int)m_Specification.Height)
+            return;
+
+        PickSlot &slot = m_PickSlots[m_NextPickSlot];
+        m_NextPickSlot = (m_NextPickSlot + 1) % s_PickSlotCount;
+
+        if (!slot.Buffer)
+        {
+            glCreateBuffers(1, &slot.Buffer);
+            glNamedBufferData(slot.Buffer, sizeof(int), nullptr, GL_STREAM_READ);
+        }
+        // GPU 落后超过环的长度时丢弃最旧的请求，而不是等它
+        if (slot.Fence)
+        {
+            glDeleteSync(slot.Fence);
+            slot.Fence = nullptr;
+        }
+
+        // 读到 PBO 时 glReadPixels 只是排入命令队列，立即返回
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, m_RendererID);
+        glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.Buffer);
+        glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, nullptr);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        slot.Fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        slot.X = x;
+        slot.Y = y;
+        slot.Sequence = ++m_PickSequence;
+    }
+
+    bool OpenGLFramebuffer::PollPick(FramebufferPickResult &result)
+    {
+        // 找出已完成的请求中最新的一个；更旧的已完成请求一并作废
+        PickSlot *latest = nullptr;
+        for (auto &slot: m_PickSlots)
+        {
+            if (!slot.Fence)
+                continue;
+
+            // 超时为 0：只查询状态，不会等待
+            GLenum status = glClientWaitSync(slot.Fence, 0, 0);
+            if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED)
+                continue;
+
+            glDeleteSync(slot.Fence);
+            slot.Fence = nullptr;
+            if (!latest || slot.Sequence > latest->Sequence)
+                latest = &slot;
+        }
+
+        if (!latest)
+            return false;
+
+        int value = -1;
+        glGetNamedBufferSubData(latest->Buffer, 0, sizeof(int), &value);
+        result.Value = value;
+        result.X = latest->X;
+        result.Y = latest->Y;
+        return true;
+    }
+
     void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
     {
         HIMII_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
@@ -3,6 +3,8 @@
 #include "Himii/Core/Log.h"
 #include "glad/glad.h"
 
+#include <array>
+
 namespace Himii
 {
     class OpenGLFramebuffer : public Framebuffer {
@@ -18,6 +20,9 @@ namespace Himii
         virtual void Resize(uint32_t width, uint32_t height) override;
         virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) override;
 
+        virtual void RequestPick(uint32_t attachmentIndex, int x, int y) override;
+        virtual bool PollPick(FramebufferPickResult &result) override;
+
         virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
         virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override
         {
@@ -25,6 +30,11 @@ namespace Himii
             return m_ColorAttachments[index];
         }
 
+        virtual const FramebufferStats &GetStats() const override
+        {
+            return m_Stats;
+        }
+
         virtual const FramebufferSpecification &GetSpecification() const override
         {
             return m_Specification;
@@ -39,5 +49,21 @@ namespace Himii
 
         std::vector<uint32_t> m_ColorAttachments;
         uint32_t m_DepthAttachment = 0;
+
+        FramebufferStats m_Stats;
+        bool m_ScissorEnabled = false;
+
+        // 拾取读回环：每个槽一个 PBO 和一个栅栏，GPU 完成后再读，避免 glReadPixels 同步等待
+        struct PickSlot {
+            uint32_t Buffer = 0;
+            GLsync Fence = nullptr;
+            int X = 0;
+            int Y = 0;
+            uint64_t Sequence = 0;
+        };
+        static constexpr uint32_t s_PickSlotCount = 3;
+        std::array<PickSlot, s_PickSlotCount> m_PickSlots;
+        uint32_t m_NextPickSlot = 0;
+        uint64_t m_PickSequence = 0;
     };
 } // namespace Himii
@@ -40,6 +40,16 @@ namespace Himii
         glViewport(x, y, width, height);
     }
 
+    void OpenGLRendererAPI::GetViewport(uint32_t &x, uint32_t &y, uint32_t &width, uint32_t &height)
+    {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        x = (uint32_t)viewport[0];
+        y = (uint32_t)viewport[1];
+        width = (uint32_t)viewport[2];
+        height = (uint32_t)viewport[3];
+    }
+
     void OpenGLRendererAPI::SetClearColor(const glm::vec4 &color)
     {
         glClearColor(color.r, color.g, color.b, color.a);
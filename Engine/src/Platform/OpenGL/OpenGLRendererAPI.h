@@ -7,6 +7,7 @@ namespace Himii
     public:
         virtual void Init() override;
         virtual void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
+        virtual void GetViewport(uint32_t &x, uint32_t &y, uint32_t &width, uint32_t &height) override;
 
         virtual void SetClearColor(const glm::vec4 &color) override;
         virtual void Clear() override;
@@ -11,12 +11,33 @@
 #include "spirv_cross/spirv_cross.hpp"
 #include "spirv_cross/spirv_glsl.hpp"
 
+#include "Himii/Core/ThreadPool.h"
 #include "Himii/Core/Timer.h"
+#include "Himii/Utils/Hash.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace Himii
 {
     namespace Utils
     {
+        // 修改缓存文件格式或编译流程时提升，旧缓存自然失效
+        constexpr uint32_t s_ShaderCacheVersion = 2;
+
+        constexpr bool s_OptimizeVulkanSPIRV = true;
+        constexpr bool s_OptimizeOpenGLSPIRV = false;
+
+        struct ProgramBinaryHeader {
+            char Magic[4] = {'H', 'G', 'L', 'P'};
+            uint32_t Version = s_ShaderCacheVersion;
+            uint64_t DriverHash = 0; // 程序二进制只对生成它的驱动有效
+            uint32_t Format = 0;
+            uint32_t Size = 0;
+            uint32_t UniformCount = 0; // 二进制之后跟 uniform 位置表：(int32 位置, uint32 名称长度, 名称)
+            uint32_t Reserved = 0;
+        };
+
         static GLenum ShaderTypeFromString(const std::string &type)
         {
             if (type == "vertex")
@@ -91,6 +112,104 @@ namespace Himii
             HIMII_CORE_ASSERT(false);
             return "";
         }
+
+        static const char *GetCachedProgramFileExtension()
+        {
+            return ".cached_opengl.program";
+        }
+
+        // 驱动不支持程序二进制时返回 0；需要 GL 上下文，只在主线程调用
+        static uint64_t GetDriverHash()
+        {
+            static uint64_t s_DriverHash = 0;
+            static bool s_Queried = false;
+            if (s_Queried)
+                return s_DriverHash;
+            s_Queried = true;
+
+            GLint formatCount = 0;
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+            if (formatCount <= 0)
+            {
+                HIMII_CORE_WARNING("OpenGL driver has no program binary formats, program cache disabled");
+                return s_DriverHash;
+            }
+
+            uint64_t hash = Hash::FNV1aOffsetBasis;
+            for (GLenum name: {GL_VENDOR, GL_RENDERER, GL_VERSION})
+            {
+                const char *value = reinterpret_cast<const char *>(glGetString(name));
+                hash = Hash::FNV1a64(std::string_view(value ? value : ""), hash);
+                hash = Hash::FNV1a64("\n", 1, hash);
+            }
+            s_DriverHash = hash ? hash : 1;
+            return s_DriverHash;
+        }
+
+        static std::string ExtractName(const std::string &filepath)
+        {
+            auto lastSlash = filepath.find_last_of("/\\");
+            lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
+            auto lastDot = filepath.rfind('.');
+            auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
+            return filepath.substr(lastSlash, count);
+        }
+
+        // 取出 "#pragma variant A B ..." 声明的关键字，并把这些行从源码中清空（保留换行，行号不变）
+        static std::vector<std::string> ParseVariantKeywords(std::string &source)
+        {
+            std::vector<std::string> keywords;
+            const char *token = "#pragma variant";
+            size_t tokenLength = strlen(token);
+            size_t pos = source.find(token);
+            while (pos != std::string::npos)
+            {
+                size_t eol = source.find_first_of("\r\n", pos);
+                if (eol == std::string::npos)
+                    eol = source.size();
+
+                std::istringstream line(source.substr(pos + tokenLength, eol - pos - tokenLength));
+                std::string keyword;
+                while (line >> keyword)
+                {
+                    if (std::find(keywords.begin(), keywords.end(), keyword) == keywords.end())
+                        keywords.push_back(keyword);
+                }
+                source.replace(pos, eol - pos, eol - pos, ' ');
+                pos = source.find(token, eol);
+            }
+
+            if (keywords.size() > 32)
+            {
+                HIMII_CORE_WARNING("Shader declares {0} variant keywords, only the first 32 are used", keywords.size());
+                keywords.resize(32);
+            }
+            return keywords;
+        }
+
+        static bool ReadSPIRV(const std::filesystem::path &path, std::vector<uint32_t> &data)
+        {
+            std::ifstream in(path, std::ios::in | std::ios::binary);
+            if (!in.is_open())
+                return false;
+
+            in.seekg(0, std::ios::end);
+            auto size = in.tellg();
+            in.seekg(0, std::ios::beg);
+            if (size <= 0 || size % sizeof(uint32_t) != 0)
+                return false;
+
+            data.resize(size / sizeof(uint32_t));
+            in.read((char *)data.data(), size);
+            return (bool)in;
+        }
+
+        static void WriteSPIRV(const std::filesystem::path &path, const std::vector<uint32_t> &data)
+        {
+            std::ofstream out(path, std::ios::out | std::ios::binary);
+            if (out.is_open())
+                out.write((const char *)data.data(), data.size() * sizeof(uint32_t));
+        }
     }
 
     OpenGLShader::OpenGLShader(const std::string &filepath) : m_FilePath(filepath)
@@ -98,24 +217,14 @@ namespace Himii
         HIMII_PROFILE_FUNCTION();
 
         Utils::CreateCacheDirectoryIfNeeded();
-
-        std::string source = ReadFile(filepath);
-        auto shaderSources = PreProcess(source);
+        m_Name = Utils::ExtractName(filepath);
 
         {
             Timer timer;
-            CompileOrGetVulkanBinaries(shaderSources);
-            CompileOrGetOpenGLBinaries();
-            CreateProgram();
+            Compile(Utils::GetDriverHash());
+            Link();
             HIMII_CORE_WARNING("OpenGL shader creation took {0} ms", timer.ElapsedMillis());
         }
-
-        // Extract Name from filepath
-        auto lastSlash = filepath.find_last_of("/\\");
-        lastSlash = lastSlash == std::string::npos ? 0 : lastSlash + 1;
-        auto lastDot = filepath.rfind('.');
-        auto count = lastDot == std::string::npos ? filepath.size() - lastSlash : lastDot - lastSlash;
-        m_Name = filepath.substr(lastSlash, count);
     }
 
     OpenGLShader::OpenGLShader(const std::string &name, const std::string &vertexSource,
@@ -123,13 +232,56 @@ namespace Himii
     {
         HIMII_PROFILE_FUNCTION();
 
-        std::unordered_map<GLenum, std::string> sources;
-        sources[GL_VERTEX_SHADER] = vertexSource;
-        sources[GL_FRAGMENT_SHADER] = fragmentSource;
-        
-        CompileOrGetVulkanBinaries(sources);
-        CompileOrGetOpenGLBinaries();
-        CreateProgram();
+        Utils::CreateCacheDirectoryIfNeeded();
+        m_ShaderSources[GL_VERTEX_SHADER] = vertexSource;
+        m_ShaderSources[GL_FRAGMENT_SHADER] = fragmentSource;
+
+        Compile(Utils::GetDriverHash());
+        Link();
+    }
+
+    std::vector<Ref<Shader>> OpenGLShader::CreateBatch(const std::vector<std::string> &filepaths,
+                                                       const std::vector<std::string> &keywords)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        Utils::CreateCacheDirectoryIfNeeded();
+        uint64_t driverHash = Utils::GetDriverHash();
+
+        Timer timer;
+        std::vector<Ref<OpenGLShader>> shaders;
+        shaders.reserve(filepaths.size());
+        for (const auto &filepath: filepaths)
+        {
+            Ref<OpenGLShader> shader(new OpenGLShader());
+            shader->m_FilePath = filepath;
+            shader->m_Name = Utils::ExtractName(filepath);
+            shaders.push_back(shader);
+        }
+
+        if (shaders.size() > 1)
+        {
+            uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+            ThreadPool workers(std::min((uint32_t)shaders.size(), hardwareThreads));
+            for (auto &shader: shaders)
+                workers.Submit([shader, driverHash, &keywords]() { shader->Compile(driverHash, keywords); });
+            workers.Wait();
+        }
+        else
+        {
+            for (auto &shader: shaders)
+                shader->Compile(driverHash, keywords);
+        }
+
+        std::vector<Ref<Shader>> result;
+        result.reserve(shaders.size());
+        for (auto &shader: shaders)
+        {
+            shader->Link();
+            result.push_back(shader);
+        }
+        HIMII_CORE_WARNING("OpenGL shader batch ({0} shaders) took {1} ms", shaders.size(), timer.ElapsedMillis());
+        return result;
     }
 
     OpenGLShader::~OpenGLShader()
@@ -139,6 +291,247 @@ namespace Himii
         glDeleteProgram(m_RendererID);
     }
 
+    Ref<Shader> OpenGLShader::GetVariant(const std::vector<std::string> &keywords)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        uint32_t mask = GetVariantMask(keywords);
+        if (mask == m_VariantMask)
+            return shared_from_this();
+
+        auto it = m_Variants.find(mask);
+        if (it != m_Variants.end())
+            return it->second;
+
+        // 变体共用已经预处理过的源码，只有宏定义不同
+        Ref<OpenGLShader> variant(new OpenGLShader());
+        variant->m_FilePath = m_FilePath;
+        variant->m_Name = m_Name;
+        variant->m_VariantKeywords = m_VariantKeywords;
+        variant->m_ShaderSources = m_ShaderSources;
+
+        Timer timer;
+        variant->Compile(Utils::GetDriverHash(), keywords);
+        variant->Link();
+        HIMII_CORE_INFO("Compiled shader variant {0} (mask {1:#x}) in {2} ms", m_Name, mask, timer.ElapsedMillis());
+
+        m_Variants[mask] = variant;
+        return variant;
+    }
+
+    uint32_t OpenGLShader::GetVariantMask(const std::vector<std::string> &keywords) const
+    {
+        uint32_t mask = 0;
+        for (const auto &keyword: keywords)
+        {
+            auto it = std::find(m_VariantKeywords.begin(), m_VariantKeywords.end(), keyword);
+            if (it != m_VariantKeywords.end())
+                mask |= 1u << (uint32_t)(it - m_VariantKeywords.begin());
+        }
+        return mask;
+    }
+
+    void OpenGLShader::Compile(uint64_t driverHash, const std::vector<std::string> &keywords)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (m_ShaderSources.empty())
+        {
+            std::string source = ReadFile(m_FilePath);
+            m_VariantKeywords = Utils::ParseVariantKeywords(source);
+            m_ShaderSources = PreProcess(source);
+        }
+
+        // 按声明顺序生成宏定义，同一变体的缓存键稳定
+        m_VariantMask = GetVariantMask(keywords);
+        m_Defines.clear();
+        for (size_t i = 0; i < m_VariantKeywords.size(); ++i)
+        {
+            if (m_VariantMask & (1u << i))
+                m_Defines.emplace_back(m_VariantKeywords[i], "1");
+        }
+
+        m_CacheKey = ComputeCacheKey();
+        m_DriverHash = driverHash;
+
+        // 有可用的程序二进制时跳过 shaderc 和 SPIRV-Cross
+        if (driverHash != 0 && LoadProgramBinary(driverHash))
+            return;
+
+        CompileOrGetVulkanBinaries(m_ShaderSources);
+        CompileOrGetOpenGLBinaries();
+    }
+
+    void OpenGLShader::Link()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        if (!m_ProgramBinary.empty())
+        {
+            bool loaded = CreateProgramFromBinary();
+            m_ProgramBinary.clear();
+            m_ProgramBinary.shrink_to_fit();
+            if (loaded)
+                return;
+
+            // 驱动拒绝了缓存的二进制（例如驱动更新），回到 SPIR-V 路径重新生成
+            HIMII_CORE_WARNING("Cached program binary for '{0}' was rejected, recompiling", m_Name);
+            m_UniformLocations.clear();
+            CompileOrGetVulkanBinaries(m_ShaderSources);
+            CompileOrGetOpenGLBinaries();
+        }
+
+        CreateProgram();
+        ResolveUniformLocations();
+        SaveProgramBinary();
+    }
+
+    uint64_t OpenGLShader::ComputeCacheKey() const
+    {
+        uint64_t hash = Hash::FNV1aOffsetBasis;
+        auto hashValue = [&hash](const auto &value) { hash = Hash::FNV1a64(&value, sizeof(value), hash); };
+        auto hashString = [&hash, &hashValue](const std::string &text)
+        {
+            hashValue((uint64_t)text.size());
+            hash = Hash::FNV1a64(std::string_view(text), hash);
+        };
+
+        hashValue(Utils::s_ShaderCacheVersion);
+        hashValue((uint32_t)shaderc_env_version_vulkan_1_2);
+        hashValue((uint32_t)shaderc_env_version_opengl_4_5);
+        hashValue(Utils::s_OptimizeVulkanSPIRV);
+        hashValue(Utils::s_OptimizeOpenGLSPIRV);
+
+        for (const auto &[name, value]: m_Defines)
+        {
+            hashString(name);
+            hashString(value);
+        }
+
+        // unordered_map 的遍历顺序不固定，按阶段排序后再哈希
+        std::vector<GLenum> stages;
+        for (const auto &[stage, source]: m_ShaderSources)
+            stages.push_back(stage);
+        std::sort(stages.begin(), stages.end());
+        for (GLenum stage: stages)
+        {
+            hashValue((uint32_t)stage);
+            hashString(m_ShaderSources.at(stage));
+        }
+        return hash;
+    }
+
+    std::filesystem::path OpenGLShader::GetCachePath(const char *extension) const
+    {
+        char key[17];
+        snprintf(key, sizeof(key), "%016llx", (unsigned long long)m_CacheKey);
+        std::string fileName = m_FilePath.empty() ? m_Name : std::filesystem::path(m_FilePath).filename().string();
+        return std::filesystem::path(Utils::GetCacheDirectory()) / (fileName + "." + key + extension);
+    }
+
+    bool OpenGLShader::LoadProgramBinary(uint64_t driverHash)
+    {
+        std::ifstream in(GetCachePath(Utils::GetCachedProgramFileExtension()), std::ios::in | std::ios::binary);
+        if (!in.is_open())
+            return false;
+
+        Utils::ProgramBinaryHeader header;
+        in.read(reinterpret_cast<char *>(&header), sizeof(header));
+        if (!in || memcmp(header.Magic, "HGLP", 4) != 0 || header.Version != Utils::s_ShaderCacheVersion ||
+            header.DriverHash != driverHash || header.Size == 0)
+            return false;
+
+        m_ProgramBinary.resize(header.Size);
+        in.read(reinterpret_cast<char *>(m_ProgramBinary.data()), header.Size);
+
+        // 位置表随二进制保存，热启动不需要再做反射
+        m_UniformLocations.clear();
+        for (uint32_t i = 0; in && i < header.UniformCount; ++i)
+        {
+            int32_t location = -1;
+            uint32_t nameLength = 0;
+            in.read(reinterpret_cast<char *>(&location), sizeof(location));
+            in.read(reinterpret_cast<char *>(&nameLength), sizeof(nameLength));
+            if (!in || nameLength > 1024)
+                break;
+            std::string name(nameLength, '\0');
+            in.read(name.data(), nameLength);
+            m_UniformLocations[name] = location;
+        }
+
+        if (!in || m_UniformLocations.size() != header.UniformCount)
+        {
+            m_ProgramBinary.clear();
+            m_UniformLocations.clear();
+            return false;
+        }
+        m_ProgramBinaryFormat = header.Format;
+        return true;
+    }
+
+    bool OpenGLShader::CreateProgramFromBinary()
+    {
+        GLuint program = glCreateProgram();
+        glProgramBinary(program, m_ProgramBinaryFormat, m_ProgramBinary.data(), (GLsizei)m_ProgramBinary.size());
+
+        GLint isLinked = GL_FALSE;
+        glGetProgramiv(program, GL_LINK_STATUS, &isLinked);
+        if (isLinked == GL_FALSE)
+        {
+            glDeleteProgram(program);
+            return false;
+        }
+
+        m_RendererID = program;
+        return true;
+    }
+
+    void OpenGLShader::SaveProgramBinary()
+    {
+        if (m_DriverHash == 0 || m_RendererID == 0)
+            return;
+
+        GLint isLinked = GL_FALSE;
+        glGetProgramiv(m_RendererID, GL_LINK_STATUS, &isLinked);
+        GLint length = 0;
+        glGetProgramiv(m_RendererID, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (isLinked == GL_FALSE || length <= 0)
+            return;
+
+        std::vector<uint8_t> binary(length);
+        GLenum format = 0;
+        glGetProgramBinary(m_RendererID, length, &length, &format, binary.data());
+
+        Utils::ProgramBinaryHeader header;
+        header.DriverHash = m_DriverHash;
+        header.Format = format;
+        header.Size = (uint32_t)length;
+        header.UniformCount = (uint32_t)m_UniformLocations.size();
+
+        std::ofstream out(GetCachePath(Utils::GetCachedProgramFileExtension()), std::ios::out | std::ios::binary);
+        if (!out.is_open())
+            return;
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char *>(binary.data()), length);
+        for (const auto &[name, location]: m_UniformLocations)
+        {
+            uint32_t nameLength = (uint32_t)name.size();
+            out.write(reinterpret_cast<const char *>(&location), sizeof(location));
+            out.write(reinterpret_cast<const char *>(&nameLength), sizeof(nameLength));
+            out.write(name.data(), nameLength);
+        }
+    }
+
+    void OpenGLShader::ResolveUniformLocations()
+    {
+        m_UniformLocations.clear();
+        if (m_RendererID == 0)
+            return;
+
+        for (const auto &name: m_ReflectedUniforms)
+            m_UniformLocations[name] = glGetUniformLocation(m_RendererID, name.c_str());
+    }
+
     std::string OpenGLShader::ReadFile(const std::string &filepath)
     {
         HIMII_PROFILE_FUNCTION();
@@ -191,60 +584,40 @@ namespace Himii
 
     void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string> &shaderSources)
     {
-        GLuint program = glCreateProgram();
+        HIMII_PROFILE_FUNCTION();
 
         shaderc::Compiler compiler;
         shaderc::CompileOptions options;
         options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
-        const bool optimize = true;
-        if (optimize)
+        if (Utils::s_OptimizeVulkanSPIRV)
             options.SetOptimizationLevel(shaderc_optimization_level_performance);
-
-        std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
+        for (const auto &[name, value]: m_Defines)
+            options.AddMacroDefinition(name, value);
 
         auto &shaderData = m_VulkanSPIRV;
         shaderData.clear();
+        m_ReflectedUniforms.clear();
+        m_UniformBlockMembers.clear();
         for (auto &&[stage, source]: shaderSources)
         {
-            std::filesystem::path shaderFilePath = m_FilePath;
-            std::filesystem::path cachedPath = cacheDirectory / (shaderFilePath.filename().string() +
-                                                                 Utils::GLShaderStageCachedVulkanFileExtension(stage));
+            // 缓存键包含源码、宏和编译选项，修改着色器后不会读到旧的二进制
+            std::filesystem::path cachedPath = GetCachePath(Utils::GLShaderStageCachedVulkanFileExtension(stage));
 
-            bool loadedFromCache = false;   // 引入标志位
-            auto &data = shaderData[stage]; // 创建引用
+            auto &data = shaderData[stage];
+            if (Utils::ReadSPIRV(cachedPath, data))
+                continue;
 
-            std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-            if (in.is_open())
+            shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
+                    source, Utils::GLShaderStageToShaderC(stage), m_FilePath.empty() ? m_Name.c_str() : m_FilePath.c_str(),
+                    options);
+            if (module.GetCompilationStatus() != shaderc_compilation_status_success)
             {
-                in.seekg(0, std::ios::end);
-                auto size = in.tellg();
-                in.seekg(0, std::ios::beg);
-
-                auto &data = shaderData[stage];
-                data.resize(size / sizeof(uint32_t));
-                in.read((char *)data.data(), size);
+                HIMII_CORE_ERROR(module.GetErrorMessage());
+                HIMII_CORE_ASSERT(false);
             }
-            else
-            {
-                shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
-                        source, Utils::GLShaderStageToShaderC(stage), m_FilePath.c_str(), options);
-                if (module.GetCompilationStatus() != shaderc_compilation_status_success)
-                {
-                    HIMII_CORE_ERROR(module.GetErrorMessage());
-                    HIMII_CORE_ASSERT(false);
-                }
-
-                shaderData[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
 
-                std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-                if (out.is_open())
-                {
-                    auto &data = shaderData[stage];
-                    out.write((char *)data.data(), data.size() * sizeof(uint32_t));
-                    out.flush();
-                    out.close();
-                }
-            }
+            data = std::vector<uint32_t>(module.cbegin(), module.cend());
+            Utils::WriteSPIRV(cachedPath, data);
         }
 
         for (auto &&[stage, data]: shaderData)
@@ -253,67 +626,49 @@ namespace Himii
 
     void OpenGLShader::CompileOrGetOpenGLBinaries()
     {
+        HIMII_PROFILE_FUNCTION();
+
         auto &shaderData = m_OpenGLSPIRV;
 
         shaderc::Compiler compiler;
         shaderc::CompileOptions options;
         options.SetTargetEnvironment(shaderc_target_env_opengl, shaderc_env_version_opengl_4_5);
-        const bool optimize = false;
-        if (optimize)
+        if (Utils::s_OptimizeOpenGLSPIRV)
             options.SetOptimizationLevel(shaderc_optimization_level_performance);
 
-        std::filesystem::path cacheDirectory = Utils::GetCacheDirectory();
-
         shaderData.clear();
         m_OpenGLSourceCode.clear();
         for (auto &&[stage, spirv]: m_VulkanSPIRV)
         {
-            std::filesystem::path shaderFilePath = m_FilePath;
-            std::filesystem::path cachedPath = cacheDirectory / (shaderFilePath.filename().string() +
-                                                                 Utils::GLShaderStageCachedOpenGLFileExtension(stage));
+            std::filesystem::path cachedPath = GetCachePath(Utils::GLShaderStageCachedOpenGLFileExtension(stage));
 
-            std::ifstream in(cachedPath, std::ios::in | std::ios::binary);
-            if (in.is_open())
-            {
-                in.seekg(0, std::ios::end);
-                auto size = in.tellg();
-                in.seekg(0, std::ios::beg);
-
-                auto &data = shaderData[stage];
-                data.resize(size / sizeof(uint32_t));
-                in.read((char *)data.data(), size);
-            }
-            else
-            {
-                spirv_cross::CompilerGLSL glslCompiler(spirv);
-                m_OpenGLSourceCode[stage] = glslCompiler.compile();
-                auto &source = m_OpenGLSourceCode[stage];
-
-                shaderc::SpvCompilationResult module =
-                        compiler.CompileGlslToSpv(source, Utils::GLShaderStageToShaderC(stage), m_FilePath.c_str());
-                if (module.GetCompilationStatus() != shaderc_compilation_status_success)
-                {
-                    HIMII_CORE_ERROR(module.GetErrorMessage());
-                    HIMII_CORE_ASSERT(false);
-                }
+            auto &data = shaderData[stage];
+            if (Utils::ReadSPIRV(cachedPath, data))
+                continue;
 
-                shaderData[stage] = std::vector<uint32_t>(module.cbegin(), module.cend());
+            spirv_cross::CompilerGLSL glslCompiler(spirv);
+            m_OpenGLSourceCode[stage] = glslCompiler.compile();
+            auto &source = m_OpenGLSourceCode[stage];
 
-                std::ofstream out(cachedPath, std::ios::out | std::ios::binary);
-                if (out.is_open())
-                {
-                    auto &data = shaderData[stage];
-                    out.write((char *)data.data(), data.size() * sizeof(uint32_t));
-                    out.flush();
-                    out.close();
-                }
+            shaderc::SpvCompilationResult module = compiler.CompileGlslToSpv(
+                    source, Utils::GLShaderStageToShaderC(stage), m_FilePath.empty() ? m_Name.c_str() : m_FilePath.c_str(),
+                    options);
+            if (module.GetCompilationStatus() != shaderc_compilation_status_success)
+            {
+                HIMII_CORE_ERROR(module.GetErrorMessage());
+                HIMII_CORE_ASSERT(false);
             }
+
+            data = std::vector<uint32_t>(module.cbegin(), module.cend());
+            Utils::WriteSPIRV(cachedPath, data);
         }
     }
 
     void OpenGLShader::CreateProgram()
     {
         GLuint program = glCreateProgram();
+        if (m_DriverHash != 0)
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 
         std::vector<GLuint> shaderIDs;
         for (auto &&[stage, spirv]: m_OpenGLSPIRV)
@@ -341,6 +696,7 @@ namespace Himii
 
             for (auto id: shaderIDs)
                 glDeleteShader(id);
+            return;
         }
 
         for (auto id: shaderIDs)
@@ -373,9 +729,41 @@ namespace Himii
             HIMII_CORE_TRACE("    Size = {0}", bufferSize);
             HIMII_CORE_TRACE("    Binding = {0}", binding);
             HIMII_CORE_TRACE("    Members = {0}", memberCount);
+
+            for (uint32_t i = 0; i < (uint32_t)memberCount; ++i)
+                m_UniformBlockMembers[compiler.get_member_name(resource.base_type_id, i)] = resource.name;
+        }
+
+        // 默认 uniform 块里只剩不透明类型（采样器），其余参数都在 std140 块中
+        for (const auto &resource: resources.sampled_images)
+        {
+            if (std::find(m_ReflectedUniforms.begin(), m_ReflectedUniforms.end(), resource.name) ==
+                m_ReflectedUniforms.end())
+                m_ReflectedUniforms.push_back(resource.name);
         }
     }
 
+    ShaderUniformHandle OpenGLShader::GetUniformHandle(const std::string &name)
+    {
+        auto it = m_UniformLocations.find(name);
+        if (it != m_UniformLocations.end())
+            return {it->second};
+
+        // 反射表里没有：查询一次并缓存结果（包括 -1），同名的后续调用不再进入 GL
+        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
+        if (location < 0)
+        {
+            auto block = m_UniformBlockMembers.find(name);
+            if (block != m_UniformBlockMembers.end())
+                HIMII_CORE_WARNING("Uniform '{0}' in shader {1} is a member of block '{2}', update its UniformBuffer instead",
+                                   name, m_Name, block->second);
+            else
+                HIMII_CORE_WARNING("Uniform '{0}' not found in shader {1}", name, m_Name);
+        }
+        m_UniformLocations.emplace(name, location);
+        return {location};
+    }
+
     void OpenGLShader::Bind() const
     {
         HIMII_PROFILE_FUNCTION();
@@ -439,52 +827,80 @@ namespace Himii
         UploadUniformMat4(name, value);
     }
 
+    // 句柄版本用 DSA 写入，不需要先 Bind；位置为 -1 时 GL 会忽略
+    void OpenGLShader::SetInt(ShaderUniformHandle handle, int value)
+    {
+        glProgramUniform1i(m_RendererID, handle.Location, value);
+    }
+
+    void OpenGLShader::SetIntArray(ShaderUniformHandle handle, int *values, uint32_t count)
+    {
+        glProgramUniform1iv(m_RendererID, handle.Location, count, values);
+    }
+
+    void OpenGLShader::SetFloat(ShaderUniformHandle handle, float value)
+    {
+        glProgramUniform1f(m_RendererID, handle.Location, value);
+    }
+
+    void OpenGLShader::SetFloat2(ShaderUniformHandle handle, const glm::vec2 &value)
+    {
+        glProgramUniform2f(m_RendererID, handle.Location, value.x, value.y);
+    }
+
+    void OpenGLShader::SetFloat3(ShaderUniformHandle handle, const glm::vec3 &value)
+    {
+        glProgramUniform3f(m_RendererID, handle.Location, value.x, value.y, value.z);
+    }
+
+    void OpenGLShader::SetFloat4(ShaderUniformHandle handle, const glm::vec4 &value)
+    {
+        glProgramUniform4f(m_RendererID, handle.Location, value.x, value.y, value.z, value.w);
+    }
+
+    void OpenGLShader::SetMat4(ShaderUniformHandle handle, const glm::mat4 &value)
+    {
+        glProgramUniformMatrix4fv(m_RendererID, handle.Location, 1, GL_FALSE, glm::value_ptr(value));
+    }
+
     void OpenGLShader::UploadUniformInt(const std::string &name, int value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform1i(location, value);
+        SetInt(GetUniformHandle(name), value);
     }
 
     void OpenGLShader::UploadUniformIntArray(const std::string &name, int *values, uint32_t count)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform1iv(location, count, values);
+        SetIntArray(GetUniformHandle(name), values, count);
     }
 
     void OpenGLShader::UploadUniformFloat(const std::string &name, float value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform1f(location, value);
+        SetFloat(GetUniformHandle(name), value);
     }
 
     void OpenGLShader::UploadUniformFloat2(const std::string &name, const glm::vec2 &value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform2f(location, value.x, value.y);
+        SetFloat2(GetUniformHandle(name), value);
     }
 
     void OpenGLShader::UploadUniformFloat3(const std::string &name, const glm::vec3 &value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform3f(location, value.x, value.y, value.z);
+        SetFloat3(GetUniformHandle(name), value);
     }
 
     void OpenGLShader::UploadUniformFloat4(const std::string &name, const glm::vec4 &value)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniform4f(location, value.x, value.y, value.z, value.w);
+        SetFloat4(GetUniformHandle(name), value);
     }
 
     void OpenGLShader::UploadUniformMat3(const std::string &name, const glm::mat3 &matrix)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        glProgramUniformMatrix3fv(m_RendererID, GetUniformHandle(name).Location, 1, GL_FALSE, glm::value_ptr(matrix));
     }
 
     void OpenGLShader::UploadUniformMat4(const std::string &name, const glm::mat4 &matrix)
     {
-        GLint location = glGetUniformLocation(m_RendererID, name.c_str());
-        glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(matrix));
+        SetMat4(GetUniformHandle(name), matrix);
     }
 
 
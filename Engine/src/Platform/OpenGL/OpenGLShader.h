@@ -1,18 +1,25 @@
 #pragma once
 #include "glm/glm.hpp"
 #include "string"
+#include <filesystem>
+#include <memory>
+#include <vector>
 #include "Himii/Renderer/Shader.h"
 #include "glad/glad.h"
 
 namespace Himii
 {
-    class OpenGLShader :public Shader
+    class OpenGLShader : public Shader, public std::enable_shared_from_this<OpenGLShader>
     {
     public:
         OpenGLShader(const std::string &filepath);
         OpenGLShader(const std::string& name, const std::string &vertexSource, const std::string &fragmentSource);
         virtual ~OpenGLShader();
 
+        // 源码读取、shaderc 编译和 SPIRV-Cross 转换在工作线程并行，GL 程序在调用线程创建
+        static std::vector<Ref<Shader>> CreateBatch(const std::vector<std::string> &filepaths,
+                                                    const std::vector<std::string> &keywords = {});
+
         virtual void Bind() const override;
         virtual void Unbind() const override;
 
@@ -24,11 +31,22 @@ namespace Himii
         virtual void SetFloat4(const std::string &name, const glm::vec4 &value)override;
         virtual void SetMat4(const std::string &name, const glm::mat4 &value) override;
 
+        virtual ShaderUniformHandle GetUniformHandle(const std::string &name) override;
+        virtual void SetInt(ShaderUniformHandle handle, int value) override;
+        virtual void SetIntArray(ShaderUniformHandle handle, int *values, uint32_t count) override;
+        virtual void SetFloat(ShaderUniformHandle handle, float value) override;
+        virtual void SetFloat2(ShaderUniformHandle handle, const glm::vec2 &value) override;
+        virtual void SetFloat3(ShaderUniformHandle handle, const glm::vec3 &value) override;
+        virtual void SetFloat4(ShaderUniformHandle handle, const glm::vec4 &value) override;
+        virtual void SetMat4(ShaderUniformHandle handle, const glm::mat4 &value) override;
+
         virtual const std::string &GetName() const override
         {
             return m_Name;
         }
 
+        virtual Ref<Shader> GetVariant(const std::vector<std::string> &keywords) override;
+
         void UploadUniformInt(const std::string &name, int value);
         void UploadUniformIntArray(const std::string &name, int *values,uint32_t count);
 
@@ -41,6 +59,20 @@ namespace Himii
         void UploadUniformMat4(const std::string &name, const glm::mat4 &matrix);
 
     private:
+        OpenGLShader() = default;
+
+        // Compile 不调用 GL，可以在工作线程执行；driverHash 为 0 表示不使用程序二进制缓存
+        void Compile(uint64_t driverHash, const std::vector<std::string> &keywords = {});
+        void Link();
+
+        uint32_t GetVariantMask(const std::vector<std::string> &keywords) const;
+        uint64_t ComputeCacheKey() const;
+        std::filesystem::path GetCachePath(const char *extension) const;
+        bool LoadProgramBinary(uint64_t driverHash);
+        bool CreateProgramFromBinary();
+        void SaveProgramBinary();
+        void ResolveUniformLocations();
+
         std::string ReadFile(const std::string &filepath);
         std::unordered_map<GLenum,std::string> PreProcess(const std::string &source);
         void CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string> &shaderSources);
@@ -48,10 +80,33 @@ namespace Himii
         void CreateProgram();
         void Reflect(GLenum stage, const std::vector<uint32_t> &shaderData);
     private:
-        uint32_t m_RendererID;
+        uint32_t m_RendererID = 0;
         std::string m_FilePath;
         std::string m_Name;
 
+        // 参与缓存键的宏定义（名称, 值）
+        std::vector<std::pair<std::string, std::string>> m_Defines;
+
+        // #pragma variant 声明的关键字，下标即变体掩码中的位
+        std::vector<std::string> m_VariantKeywords;
+        uint32_t m_VariantMask = 0;
+        // 从这个着色器派生出的变体，按掩码缓存
+        std::unordered_map<uint32_t, Ref<OpenGLShader>> m_Variants;
+        std::unordered_map<GLenum, std::string> m_ShaderSources;
+        uint64_t m_CacheKey = 0;
+        uint64_t m_DriverHash = 0;
+
+        // Reflect 得到的默认块 uniform 名称，链接后一次性解析成位置
+        std::vector<std::string> m_ReflectedUniforms;
+        // uniform block 成员名 -> 块名，只用来提示按名称设置块成员的误用
+        std::unordered_map<std::string, std::string> m_UniformBlockMembers;
+        // 名称 -> 位置；按名称查询过的其它 uniform 也缓存在这里（包括 -1）
+        std::unordered_map<std::string, int32_t> m_UniformLocations;
+
+        // 从缓存读到的链接后程序，Link 之后释放
+        std::vector<uint8_t> m_ProgramBinary;
+        GLenum m_ProgramBinaryFormat = 0;
+
         std::unordered_map<GLenum, std::vector<uint32_t>> m_VulkanSPIRV;
         std::unordered_map<GLenum, std::vector<uint32_t>> m_OpenGLSPIRV;
 
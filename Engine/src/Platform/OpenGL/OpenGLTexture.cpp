@@ -1,10 +1,23 @@
 #include "Hepch.h"
 #include "Himii/Core/Log.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
+#include "Himii/Asset/VirtualFileSystem.h"
+#include "Himii/Renderer/CookedTexture.h"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include <array>
 
+// glad 按核心配置生成时不包含 S3TC 扩展的枚举
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+    #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+    #define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
 namespace Himii
 {
     namespace Utils
@@ -17,6 +30,9 @@ namespace Himii
                 case ImageFormat::RGB8:
                     return GL_RGB;
                 case ImageFormat::RGBA8:
+                case ImageFormat::BC1:
+                case ImageFormat::BC3:
+                case ImageFormat::BC7:
                     return GL_RGBA;
             }
 
@@ -32,6 +48,12 @@ namespace Himii
                     return GL_RGB8;
                 case ImageFormat::RGBA8:
                     return GL_RGBA8;
+                case ImageFormat::BC1:
+                    return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                case ImageFormat::BC3:
+                    return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                case ImageFormat::BC7:
+                    return GL_COMPRESSED_RGBA_BPTC_UNORM;
             }
 
             HIMII_CORE_ASSERT(false);
@@ -54,17 +76,35 @@ namespace Himii
 
         glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
         glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        m_Specification.Width = m_Width;
+        m_Specification.Height = m_Height;
+        m_Specification.Format = ImageFormat::RGBA8;
+        UpdateMemoryTracking();
     }
     OpenGLTexture::OpenGLTexture(const std::string &path) : m_Path(path)
     {
         HIMII_PROFILE_FUNCTION();
 
+        // 经 VirtualFileSystem 读取，打包后的纹理来自 .hpak
+        VirtualFile file;
+        bool fileRead = VirtualFileSystem::ReadFile(path, file);
+
+        // 烘焙过的纹理不需要解码，直接上传各级 mip
+        CookedTextureView cooked;
+        if (fileRead && CookedTexture::Parse(file.GetData(), file.GetSize(), cooked))
+        {
+            CreateFromCooked(cooked);
+            return;
+        }
+
         int width, height, channels;
         stbi_set_flip_vertically_on_load(1);
         stbi_uc *data = nullptr;
         {
             HIMII_PROFILE_SCOPE("stbi_load - OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
-            data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+            if (fileRead)
+                data = stbi_load_from_memory(file.GetData(), (int)file.GetSize(), &width, &height, &channels, 0);
         }
         HIMII_CORE_ASSERT(data, "Failed to load image!");
         m_Width = width;
@@ -99,17 +139,187 @@ namespace Himii
         glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
 
         stbi_image_free(data);
+        m_Specification.Width = m_Width;
+        m_Specification.Height = m_Height;
+        m_Specification.Format = channels == 4 ? ImageFormat::RGBA8 : ImageFormat::RGB8;
+        UpdateMemoryTracking();
+        m_IsLoaded = true;
+    }
+    OpenGLTexture::OpenGLTexture(const std::string &path, DeferredLoad) : OpenGLTexture(1, 1)
+    {
+        m_Path = path;
+
+        // 灰色占位，真实数据由 TextureStreamer 上传后替换
+        uint32_t placeholder = 0xff808080;
+        SetData(&placeholder, sizeof(uint32_t));
     }
     OpenGLTexture::~OpenGLTexture()
     {
         HIMII_PROFILE_FUNCTION();
 
         glDeleteTextures(1, &m_RendererID);
+        if (m_StreamingID)
+            glDeleteTextures(1, &m_StreamingID);
+        if (m_StagingBuffer)
+            glDeleteBuffers(1, &m_StagingBuffer);
+
+        if (m_MemoryTracked)
+            TrackMemory(-1, m_TrackedCompressed ? -1 : 0, -(int64_t)m_TrackedBytes,
+                        -(int64_t)m_TrackedUncompressedBytes);
+    }
+    void OpenGLTexture::UpdateMemoryTracking()
+    {
+        // 与上次记录的差值计入全局统计；压缩格式的“未压缩大小”按 RGBA8 计
+        ImageFormat format = m_Specification.Format;
+        ImageFormat uncompressedFormat = IsBlockCompressed(format) ? ImageFormat::RGBA8 : format;
+        uint64_t bytes = GetMipChainSize(format, m_Width, m_Height, m_MipCount);
+        uint64_t uncompressedBytes = GetMipChainSize(uncompressedFormat, m_Width, m_Height, m_MipCount);
+
+        int32_t compressedDelta = (IsBlockCompressed(format) ? 1 : 0) - (m_TrackedCompressed ? 1 : 0);
+        TrackMemory(m_MemoryTracked ? 0 : 1, compressedDelta,
+                    (int64_t)bytes - (int64_t)m_TrackedBytes,
+                    (int64_t)uncompressedBytes - (int64_t)m_TrackedUncompressedBytes);
+
+        m_TrackedBytes = bytes;
+        m_TrackedUncompressedBytes = uncompressedBytes;
+        m_TrackedCompressed = IsBlockCompressed(format);
+        m_MemoryTracked = true;
+    }
+    void OpenGLTexture::CreateFromCooked(const CookedTextureView &cooked)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        ImageFormat format = cooked.GetImageFormat();
+        m_Width = cooked.Width;
+        m_Height = cooked.Height;
+        m_MipCount = (uint32_t)cooked.Levels.size();
+        m_InternalFormat = Utils::HazelImageFormatToGLInternalFormat(format);
+        m_DataFormat = Utils::HazelImageFormatToGLDataFormat(format);
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+        glTextureStorage2D(m_RendererID, m_MipCount, m_InternalFormat, m_Width, m_Height);
+
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, m_MipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (uint32_t level = 0; level < m_MipCount; ++level)
+        {
+            const CookedTextureLevel &mip = cooked.Levels[level];
+            if (IsBlockCompressed(format))
+                glCompressedTextureSubImage2D(m_RendererID, level, 0, 0, mip.Width, mip.Height, m_InternalFormat,
+                                              (GLsizei)mip.Size, mip.Data);
+            else
+                glTextureSubImage2D(m_RendererID, level, 0, 0, mip.Width, mip.Height, m_DataFormat, GL_UNSIGNED_BYTE,
+                                    mip.Data);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+        m_Specification.Width = m_Width;
+        m_Specification.Height = m_Height;
+        m_Specification.Format = format;
+        m_Specification.GenerateMips = m_MipCount > 1;
+        UpdateMemoryTracking();
+        m_IsLoaded = true;
+    }
+    void OpenGLTexture::BeginStreaming(uint32_t width, uint32_t height, ImageFormat format, uint32_t mipCount)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        HIMII_CORE_ASSERT(m_StreamingID == 0, "Texture is already streaming!");
+        HIMII_CORE_ASSERT(format == ImageFormat::RGB8 || format == ImageFormat::RGBA8 || IsBlockCompressed(format),
+                          "Format not supported!");
+
+        m_StreamingWidth = width;
+        m_StreamingHeight = height;
+        m_StreamingMipCount = std::max(1u, mipCount);
+        m_StreamingFormat = format;
+        m_StreamingInternalFormat = Utils::HazelImageFormatToGLInternalFormat(format);
+        m_StreamingDataFormat = Utils::HazelImageFormatToGLDataFormat(format);
+
+        glCreateTextures(GL_TEXTURE_2D, 1, &m_StreamingID);
+        glTextureStorage2D(m_StreamingID, m_StreamingMipCount, m_StreamingInternalFormat, width, height);
+
+        glTextureParameteri(m_StreamingID, GL_TEXTURE_MIN_FILTER,
+                            m_StreamingMipCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTextureParameteri(m_StreamingID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        glTextureParameteri(m_StreamingID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTextureParameteri(m_StreamingID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+        glCreateBuffers(1, &m_StagingBuffer);
+    }
+    void OpenGLTexture::StreamRows(const void *data, uint32_t firstRow, uint32_t rowCount, uint32_t mipLevel)
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        uint32_t levelWidth = std::max(1u, m_StreamingWidth >> mipLevel);
+        GLsizeiptr size = (GLsizeiptr)(GetImageRowPitch(m_StreamingFormat, levelWidth) * rowCount);
+
+        // 每次重新指定存储（orphan），驱动不必等待上一块的传输完成
+        glNamedBufferData(m_StagingBuffer, size, nullptr, GL_STREAM_DRAW);
+        void *dst = glMapNamedBufferRange(m_StagingBuffer, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (!dst)
+        {
+            HIMII_CORE_ERROR("Failed to map texture staging buffer: {0}", m_Path);
+            return;
+        }
+        memcpy(dst, data, size);
+        glUnmapNamedBuffer(m_StagingBuffer);
+
+        // 绑定 PBO 后 glTextureSubImage2D 的数据指针是缓冲区内偏移，调用立即返回，由驱动异步传输
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_StagingBuffer);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if (IsBlockCompressed(m_StreamingFormat))
+        {
+            // 压缩格式按 4 像素高的块行上传，最后一块行可能不足 4 像素
+            uint32_t levelHeight = std::max(1u, m_StreamingHeight >> mipLevel);
+            uint32_t y = firstRow * 4;
+            uint32_t height = std::min(rowCount * 4, levelHeight - y);
+            glCompressedTextureSubImage2D(m_StreamingID, mipLevel, 0, y, levelWidth, height, m_StreamingInternalFormat,
+                                          (GLsizei)size, nullptr);
+        }
+        else
+        {
+            glTextureSubImage2D(m_StreamingID, mipLevel, 0, firstRow, levelWidth, rowCount, m_StreamingDataFormat,
+                                GL_UNSIGNED_BYTE, nullptr);
+        }
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    void OpenGLTexture::EndStreaming()
+    {
+        HIMII_PROFILE_FUNCTION();
+
+        glDeleteBuffers(1, &m_StagingBuffer);
+        m_StagingBuffer = 0;
+
+        // 同一个对象原地换成真实纹理，持有 Ref 的精灵不需要任何改动
+        glDeleteTextures(1, &m_RendererID);
+        m_RendererID = m_StreamingID;
+        m_StreamingID = 0;
+
+        m_Width = m_StreamingWidth;
+        m_Height = m_StreamingHeight;
+        m_MipCount = m_StreamingMipCount;
+        m_InternalFormat = m_StreamingInternalFormat;
+        m_DataFormat = m_StreamingDataFormat;
+        m_Specification.Width = m_Width;
+        m_Specification.Height = m_Height;
+        m_Specification.Format = m_StreamingFormat;
+        m_Specification.GenerateMips = m_MipCount > 1;
+        UpdateMemoryTracking();
+
+        m_IsLoaded = true;
     }
     void OpenGLTexture::SetData(void *data, uint32_t size)
     {
         HIMII_PROFILE_FUNCTION();
 
+        HIMII_CORE_ASSERT(!IsBlockCompressed(m_Specification.Format), "SetData does not support compressed textures!");
         uint32_t bpp= m_DataFormat == GL_RGBA ? 4:3;
         HIMII_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
         glTextureSubImage2D(m_RendererID, 0, 0, 0,m_Width,m_Height,m_DataFormat,GL_UNSIGNED_BYTE,data);
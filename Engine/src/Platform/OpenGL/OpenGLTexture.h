@@ -1,5 +1,6 @@
 #pragma once
 #include "Himii/Renderer/Texture.h"
+#include "Himii/Renderer/CookedTexture.h"
 
 #include "glad/glad.h"
 
@@ -9,6 +10,9 @@ namespace Himii
     public:
         OpenGLTexture(uint32_t width,uint32_t height);
         OpenGLTexture(const std::string &path);
+        // 只创建占位纹理，不读取文件
+        struct DeferredLoad {};
+        OpenGLTexture(const std::string &path, DeferredLoad);
         virtual ~OpenGLTexture();
 
         virtual const TextureSpecification &GetSpecification() const override
@@ -39,18 +43,44 @@ namespace Himii
         {
             return m_IsLoaded;
         }
+        virtual uint64_t GetMemorySize() const override
+        {
+            return GetMipChainSize(m_Specification.Format, m_Width, m_Height, m_MipCount);
+        }
+
         virtual bool operator==(const Texture &other) const override
         {
             return m_RendererID == other.GetRendererID();
         };
 
+        virtual void BeginStreaming(uint32_t width, uint32_t height, ImageFormat format, uint32_t mipCount = 1) override;
+        virtual void StreamRows(const void *data, uint32_t firstRow, uint32_t rowCount, uint32_t mipLevel = 0) override;
+        virtual void EndStreaming() override;
+
+    private:
+        void CreateFromCooked(const CookedTextureView &cooked);
+        // 存储分配或替换后调用，更新 Texture2D::GetMemoryStats
+        void UpdateMemoryTracking();
+
     private:
         TextureSpecification m_Specification;
 
         std::string m_Path;
         bool m_IsLoaded = false;
         uint32_t m_Width, m_Height;
+        uint32_t m_MipCount = 1;
         uint32_t m_RendererID;
         GLenum m_InternalFormat, m_DataFormat;
+
+        uint64_t m_TrackedBytes = 0, m_TrackedUncompressedBytes = 0;
+        bool m_TrackedCompressed = false;
+        bool m_MemoryTracked = false;
+
+        // 流式上传期间的目标纹理和 PBO
+        uint32_t m_StreamingID = 0;
+        uint32_t m_StagingBuffer = 0;
+        uint32_t m_StreamingWidth = 0, m_StreamingHeight = 0, m_StreamingMipCount = 1;
+        ImageFormat m_StreamingFormat = ImageFormat::None;
+        GLenum m_StreamingInternalFormat = 0, m_StreamingDataFormat = 0;
     };
 }
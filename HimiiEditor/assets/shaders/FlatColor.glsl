@@ -1,26 +1,34 @@
 #type vertex
-#version 410 core
+#version 450 core
 
 layout(location = 0) in vec3 a_Position;
 
-uniform mat4 u_ViewProjection; // ��ͼͶӰ����
-uniform mat4 u_Transform; // �任����
-
-out vec2 v_TexCoord;
+// 逐次绘制参数，由 Renderer::Submit 写入（std140）
+layout(std140, binding = 1) uniform Object
+{
+	mat4 u_ViewProjection;
+	mat4 u_Transform;
+	vec4 u_Color;
+};
 
 void main()
 {
-    gl_Position = u_ViewProjection*u_Transform* vec4(a_Position, 1.0);
+    gl_Position = u_ViewProjection * u_Transform * vec4(a_Position, 1.0);
 }
 
 #type fragment
-#version 410 core
+#version 450 core
 
-layout(location=0) out vec4 color;
+layout(location = 0) out vec4 color;
 
-uniform vec4 u_Color; // ��ɫ
+layout(std140, binding = 1) uniform Object
+{
+	mat4 u_ViewProjection;
+	mat4 u_Transform;
+	vec4 u_Color;
+};
 
 void main()
 {
     color = u_Color;
-}
\ No newline at end of file
+}
@@ -1,11 +1,21 @@
+// 变体关键字：运行时不写实体 ID、平铺系数在 CPU 上乘进 UV、只用 16 个纹理槽
+#pragma variant NO_ENTITY_ID NO_TILING TEXTURE_SLOTS_16
+
 #type vertex
 #version 450 core
 layout(location = 0) in vec3 a_Position;
 layout(location = 1) in vec4 a_Color;
 layout(location = 2) in vec2 a_TexCoord;
 layout(location = 3) in float a_TexIndex;
+#ifndef NO_TILING
 layout(location = 4) in float a_TilingFactor;
-layout(location = 5) in int a_EntityID;
+#define ENTITY_ID_LOCATION 5
+#else
+#define ENTITY_ID_LOCATION 4
+#endif
+#ifndef NO_ENTITY_ID
+layout(location = ENTITY_ID_LOCATION) in int a_EntityID;
+#endif
 
 layout(std140,binding=0) uniform Camera
 {
@@ -16,20 +26,26 @@ struct VertexOutput
 {
 	vec4 Color;
 	vec2 TexCoord;
-	float TilingFactor;
 };
 
 layout (location = 0) out VertexOutput Output;
 layout (location = 3) out flat float v_TexIndex;
+#ifndef NO_ENTITY_ID
 layout (location = 4) out flat int v_EntityID;
+#endif
 
 void main()
 {
     Output.Color = a_Color;
+#ifndef NO_TILING
+	Output.TexCoord = a_TexCoord * a_TilingFactor;
+#else
 	Output.TexCoord = a_TexCoord;
-	Output.TilingFactor = a_TilingFactor;
+#endif
 	v_TexIndex = a_TexIndex;
+#ifndef NO_ENTITY_ID
     v_EntityID = a_EntityID;
+#endif
     gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
 }
 
@@ -37,62 +53,72 @@ void main()
 #version 450 core
 
 layout(location=0) out vec4 color;
+#ifndef NO_ENTITY_ID
 layout(location=1) out int o_EntityID;
+#endif
 
 struct VertexOutput
 {
 	vec4 Color;
 	vec2 TexCoord;
-	float TilingFactor;
 };
 
 layout (location = 0) in VertexOutput Input;
 layout (location = 3) in flat float v_TexIndex;
+#ifndef NO_ENTITY_ID
 layout (location = 4) in flat int v_EntityID;
+#endif
 
+#ifdef TEXTURE_SLOTS_16
+layout (binding = 0) uniform sampler2D u_Textures[16];
+#else
 layout (binding = 0) uniform sampler2D u_Textures[32];
+#endif
 
 void main()
 {
 	vec4 texColor = Input.Color;
     switch(int(v_TexIndex))
     {
-        case  0: texColor *= texture(u_Textures[ 0], Input.TexCoord * Input.TilingFactor); break;
-		case  1: texColor *= texture(u_Textures[ 1], Input.TexCoord * Input.TilingFactor); break;
-		case  2: texColor *= texture(u_Textures[ 2], Input.TexCoord * Input.TilingFactor); break;
-		case  3: texColor *= texture(u_Textures[ 3], Input.TexCoord * Input.TilingFactor); break;
-		case  4: texColor *= texture(u_Textures[ 4], Input.TexCoord * Input.TilingFactor); break;
-		case  5: texColor *= texture(u_Textures[ 5], Input.TexCoord * Input.TilingFactor); break;
-		case  6: texColor *= texture(u_Textures[ 6], Input.TexCoord * Input.TilingFactor); break;
-		case  7: texColor *= texture(u_Textures[ 7], Input.TexCoord * Input.TilingFactor); break;
-		case  8: texColor *= texture(u_Textures[ 8], Input.TexCoord * Input.TilingFactor); break;
-		case  9: texColor *= texture(u_Textures[ 9], Input.TexCoord * Input.TilingFactor); break;
-		case 10: texColor *= texture(u_Textures[10], Input.TexCoord * Input.TilingFactor); break;
-		case 11: texColor *= texture(u_Textures[11], Input.TexCoord * Input.TilingFactor); break;
-		case 12: texColor *= texture(u_Textures[12], Input.TexCoord * Input.TilingFactor); break;
-		case 13: texColor *= texture(u_Textures[13], Input.TexCoord * Input.TilingFactor); break;
-		case 14: texColor *= texture(u_Textures[14], Input.TexCoord * Input.TilingFactor); break;
-		case 15: texColor *= texture(u_Textures[15], Input.TexCoord * Input.TilingFactor); break;
-		case 16: texColor *= texture(u_Textures[16], Input.TexCoord * Input.TilingFactor); break;
-		case 17: texColor *= texture(u_Textures[17], Input.TexCoord * Input.TilingFactor); break;
-		case 18: texColor *= texture(u_Textures[18], Input.TexCoord * Input.TilingFactor); break;
-		case 19: texColor *= texture(u_Textures[19], Input.TexCoord * Input.TilingFactor); break;
-		case 20: texColor *= texture(u_Textures[20], Input.TexCoord * Input.TilingFactor); break;
-		case 21: texColor *= texture(u_Textures[21], Input.TexCoord * Input.TilingFactor); break;
-		case 22: texColor *= texture(u_Textures[22], Input.TexCoord * Input.TilingFactor); break;
-		case 23: texColor *= texture(u_Textures[23], Input.TexCoord * Input.TilingFactor); break;
-		case 24: texColor *= texture(u_Textures[24], Input.TexCoord * Input.TilingFactor); break;
-		case 25: texColor *= texture(u_Textures[25], Input.TexCoord * Input.TilingFactor); break;
-		case 26: texColor *= texture(u_Textures[26], Input.TexCoord * Input.TilingFactor); break;
-		case 27: texColor *= texture(u_Textures[27], Input.TexCoord * Input.TilingFactor); break;
-		case 28: texColor *= texture(u_Textures[28], Input.TexCoord * Input.TilingFactor); break;
-		case 29: texColor *= texture(u_Textures[29], Input.TexCoord * Input.TilingFactor); break;
-		case 30: texColor *= texture(u_Textures[30], Input.TexCoord * Input.TilingFactor); break;
-		case 31: texColor *= texture(u_Textures[31], Input.TexCoord * Input.TilingFactor); break;
-
+        case  0: texColor *= texture(u_Textures[ 0], Input.TexCoord); break;
+		case  1: texColor *= texture(u_Textures[ 1], Input.TexCoord); break;
+		case  2: texColor *= texture(u_Textures[ 2], Input.TexCoord); break;
+		case  3: texColor *= texture(u_Textures[ 3], Input.TexCoord); break;
+		case  4: texColor *= texture(u_Textures[ 4], Input.TexCoord); break;
+		case  5: texColor *= texture(u_Textures[ 5], Input.TexCoord); break;
+		case  6: texColor *= texture(u_Textures[ 6], Input.TexCoord); break;
+		case  7: texColor *= texture(u_Textures[ 7], Input.TexCoord); break;
+		case  8: texColor *= texture(u_Textures[ 8], Input.TexCoord); break;
+		case  9: texColor *= texture(u_Textures[ 9], Input.TexCoord); break;
+		case 10: texColor *= texture(u_Textures[10], Input.TexCoord); break;
+		case 11: texColor *= texture(u_Textures[11], Input.TexCoord); break;
+		case 12: texColor *= texture(u_Textures[12], Input.TexCoord); break;
+		case 13: texColor *= texture(u_Textures[13], Input.TexCoord); break;
+		case 14: texColor *= texture(u_Textures[14], Input.TexCoord); break;
+		case 15: texColor *= texture(u_Textures[15], Input.TexCoord); break;
+#ifndef TEXTURE_SLOTS_16
+		case 16: texColor *= texture(u_Textures[16], Input.TexCoord); break;
+		case 17: texColor *= texture(u_Textures[17], Input.TexCoord); break;
+		case 18: texColor *= texture(u_Textures[18], Input.TexCoord); break;
+		case 19: texColor *= texture(u_Textures[19], Input.TexCoord); break;
+		case 20: texColor *= texture(u_Textures[20], Input.TexCoord); break;
+		case 21: texColor *= texture(u_Textures[21], Input.TexCoord); break;
+		case 22: texColor *= texture(u_Textures[22], Input.TexCoord); break;
+		case 23: texColor *= texture(u_Textures[23], Input.TexCoord); break;
+		case 24: texColor *= texture(u_Textures[24], Input.TexCoord); break;
+		case 25: texColor *= texture(u_Textures[25], Input.TexCoord); break;
+		case 26: texColor *= texture(u_Textures[26], Input.TexCoord); break;
+		case 27: texColor *= texture(u_Textures[27], Input.TexCoord); break;
+		case 28: texColor *= texture(u_Textures[28], Input.TexCoord); break;
+		case 29: texColor *= texture(u_Textures[29], Input.TexCoord); break;
+		case 30: texColor *= texture(u_Textures[30], Input.TexCoord); break;
+		case 31: texColor *= texture(u_Textures[31], Input.TexCoord); break;
+#endif
     }
 	if (texColor.a == 0.0)
 		discard;
     color = texColor;
+#ifndef NO_ENTITY_ID
 	o_EntityID = v_EntityID;
+#endif
 }
\ No newline at end of file
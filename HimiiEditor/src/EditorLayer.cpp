@@ -1,5 +1,6 @@
 ﻿#include "EditorLayer.h"
 #include "imgui.h"
+#include "misc/cpp/imgui_stdlib.h"
 #include "Himii/Scripting/ScriptEngine.h"
 #include "Himii/Project/Project.h"
 
@@ -35,6 +36,8 @@ namespace Himii
         // 创建离屏帧缓冲，尺寸先用窗口大小，后续由 EditorLayer 面板驱动调整
         FramebufferSpecification fbSpec{1280, 720};
         fbSpec.Attachments = {FramebufferFormat::RGBA8, FramebufferFormat::RED_INTEGER, FramebufferFormat::Depth};
+        // 拖动分隔条时尺寸每帧都在变，按 256 像素一档分配，避免每帧重建附件
+        fbSpec.ResizeGranularity = 256;
         m_Framebuffer = Framebuffer::Create(fbSpec);
 
         m_EditorCamera = EditorCamera(45.0f, 1.778f, 0.1f, 1000.0f);
@@ -68,6 +71,8 @@ namespace Himii
     void EditorLayer::OnDetach()
     {
         HIMII_PROFILE_FUNCTION();
+
+        SetOverlayScene(nullptr);
     }
 
     void EditorLayer::OnUpdate(Timestep ts)
@@ -86,6 +91,13 @@ namespace Himii
             m_ActiveScene->OnViewportResize(m_ViewportSize.x, m_ViewportSize.y);
         }
 
+        // 推进异步资源加载（纹理上传有每帧预算）
+        if (Project::GetActive())
+            Project::GetAssetManager()->Update();
+
+        // 增量更新脏实体的 YAML 片段，定时在后台写盘
+        m_SceneAutosaver.Update(ts);
+
         // 从 EditorLayer 获取 Scene 面板的期望尺寸并驱动 FBO 调整
         Renderer2D::ResetStats();
 
@@ -133,10 +145,16 @@ namespace Himii
         int mouseX = (int)mx;
         int mouseY = (int)my;
 
+        // 拾取结果异步读回，比鼠标晚 1~2 帧；读回的 ID 可能属于已删除的实体或切换前的场景，需要校验
         if (mouseX >= 0 && mouseY >= 0 && mouseX < (int)viewportSize.x && mouseY < (int)viewportSize.y)
+            m_Framebuffer->RequestPick(1, mouseX, mouseY);
+
+        FramebufferPickResult pick;
+        if (m_Framebuffer->PollPick(pick))
         {
-            int pixelData = m_Framebuffer->ReadPixel(1, mouseX, mouseY);
-            m_HoveredEntity = pixelData == -1 ? Entity() : Entity((entt::entity)pixelData, m_ActiveScene.get());
+            entt::entity handle = (entt::entity)pick.Value;
+            bool valid = pick.Value != -1 && m_ActiveScene->Registry().valid(handle);
+            m_HoveredEntity = valid ? Entity(handle, m_ActiveScene.get()) : Entity();
         }
 
         OnOverlayRender();
@@ -248,6 +266,31 @@ namespace Himii
                     }
                     ImGui::EndMenu();
                 }
+                if (ImGui::BeginMenu("Tools"))
+                {
+                    if (ImGui::MenuItem("Import All Assets", nullptr, false, (bool)Project::GetActive()))
+                    {
+                        uint32_t imported = Project::GetAssetManager()->ImportDirectory();
+                        HIMII_CORE_INFO("Import All Assets: {0} new assets registered", imported);
+                    }
+                    if (ImGui::MenuItem("Convert Scene Format", nullptr, false, !m_EditorScenePath.empty()))
+                    {
+                        ConvertEditorSceneFormat();
+                    }
+                    if (ImGui::MenuItem("Benchmark Physics Snapshot (10k bodies)"))
+                    {
+                        BenchmarkPhysics2DSnapshot();
+                    }
+                    if (ImGui::MenuItem("Benchmark Scene Serialization (10k entities)"))
+                    {
+                        BenchmarkSceneSerialization();
+                    }
+                    if (ImGui::MenuItem("Benchmark Asset Pack", nullptr, false, (bool)Project::GetActive()))
+                    {
+                        BenchmarkAssetPack();
+                    }
+                    ImGui::EndMenu();
+                }
                 if (ImGui::BeginMenu("Window"))
                 {
                     ImGui::MenuItem("Animation Editor", nullptr, &m_ShowAnimationPanel);
@@ -271,10 +314,184 @@ namespace Himii
             ImGui::Text("Quad Count: %d", stats.QuadCount);
             ImGui::Text("Vertex Count: %d", stats.GetTotalVertexCount());
             ImGui::Text("Index Count: %d", stats.GetTotalIndexCount());
+            ImGui::Text("Textures: %u (%u compressed)", stats.TextureCount, stats.CompressedTextureCount);
+            ImGui::Text("Texture VRAM: %.2f MB (saved %.2f MB)", stats.TextureMemoryBytes / (1024.0f * 1024.0f),
+                        stats.TextureMemorySavedBytes / (1024.0f * 1024.0f));
+
+            const auto &viewportSpec = m_Framebuffer->GetSpecification();
+            const auto &viewportStats = m_Framebuffer->GetStats();
+            ImGui::Text("Viewport: %ux%u (allocated %ux%u)", viewportSpec.Width, viewportSpec.Height,
+                        viewportStats.AllocatedWidth, viewportStats.AllocatedHeight);
+            ImGui::Text("Framebuffer Reallocations: %u", viewportStats.ReallocationCount);
+
+            if (m_SceneState != SceneState::Edit)
+            {
+                const auto &physicsStats = m_ActiveScene->GetPhysics2DStats();
+                ImGui::Separator();
+                ImGui::Text("Physics2D Stats:");
+                ImGui::Text("Bodies: %d", physicsStats.BodyCount);
+                ImGui::Text("Shapes: %d", physicsStats.ShapeCount);
+                ImGui::Text("Contact Pairs: %d", physicsStats.ContactPairCount);
+                ImGui::Text("Pairs (filtering on): %d", physicsStats.FilteredPairCount);
+                ImGui::Text("Pairs (filtering off): %d", physicsStats.UnfilteredPairCount);
+            }
+
+            if (Project::GetActive())
+            {
+                auto assetManager = Project::GetAssetManager();
+                const auto &memoryStats = assetManager->GetMemoryStats();
+                ImGui::Separator();
+                ImGui::Text("Asset Memory:");
+                ImGui::Text("Loaded: %u  Total: %.2f MB", memoryStats.LoadedCount,
+                            memoryStats.TotalBytes / (1024.0f * 1024.0f));
+                ImGui::Text("Textures: %.2f MB  Animations: %.1f KB",
+                            memoryStats.GetBytes(AssetType::Texture2D) / (1024.0f * 1024.0f),
+                            memoryStats.GetBytes(AssetType::SpriteAnimation) / 1024.0f);
+                if (assetManager->GetMemoryBudget() > 0)
+                    ImGui::Text("Budget: %.0f MB", assetManager->GetMemoryBudget() / (1024.0f * 1024.0f));
+                ImGui::Text("Evictions: %u (%.2f MB)", memoryStats.EvictionCount,
+                            memoryStats.EvictedBytes / (1024.0f * 1024.0f));
+
+                if (ImGui::TreeNode("Resident Assets"))
+                {
+                    auto residency = assetManager->GetResidency();
+                    ImGuiListClipper clipper;
+                    clipper.Begin((int)residency.size());
+                    while (clipper.Step())
+                    {
+                        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                        {
+                            const auto &info = residency[i];
+                            const auto &metadata = assetManager->GetMetadata(info.Handle);
+                            ImGui::Text("%s  %.1f KB  refs %ld", metadata.FilePath.generic_string().c_str(),
+                                        info.Size / 1024.0f, info.RefCount);
+                        }
+                    }
+                    ImGui::TreePop();
+                }
+
+                const auto &autosaveStats = m_SceneAutosaver.GetStats();
+                ImGui::Separator();
+                ImGui::Text("Scene Autosave:%s", m_SceneAutosaver.HasUnsavedChanges() ? " (unsaved changes)" : "");
+                ImGui::Text("Cached: %u  Pending: %u", autosaveStats.CachedEntities, autosaveStats.PendingEntities);
+                ImGui::Text("Last snapshot: %u entities in %.2f ms", autosaveStats.LastSnapshotEntities,
+                            autosaveStats.LastSnapshotMs);
+                ImGui::Text("Last write: %.1f KB in %.2f ms%s", autosaveStats.LastWriteBytes / 1024.0f,
+                            autosaveStats.LastWriteMs, autosaveStats.LastWriteSucceeded ? "" : " (failed)");
+
+                if (!m_LastPreloadReport.Assets.empty() && ImGui::TreeNode("Last Play Preload"))
+                {
+                    ImGui::Text("%zu assets in %.2f ms, %u already loaded", m_LastPreloadReport.Assets.size(),
+                                m_LastPreloadReport.TotalMilliseconds, m_LastPreloadReport.AlreadyLoaded);
+                    ImGuiListClipper clipper;
+                    clipper.Begin((int)m_LastPreloadReport.Assets.size());
+                    while (clipper.Step())
+                    {
+                        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                        {
+                            const auto &timing = m_LastPreloadReport.Assets[i];
+                            const auto &metadata = assetManager->GetMetadata(timing.Handle);
+                            ImGui::Text("%s  %.2f ms%s", metadata.FilePath.generic_string().c_str(),
+                                        timing.Milliseconds, timing.Succeeded ? "" : "  (failed)");
+                        }
+                    }
+                    ImGui::TreePop();
+                }
+
+                if (TextureStreamer *streamer = assetManager->GetTextureStreamer())
+                {
+                    const auto &streamStats = streamer->GetStats();
+                    ImGui::Separator();
+                    ImGui::Text("Texture Streaming:");
+                    ImGui::Text("Queued: %u  Decoding: %u  Uploading: %u", streamStats.Queued, streamStats.Decoding,
+                                streamStats.Uploading);
+                    ImGui::Text("Completed: %u  Failed: %u", streamStats.Completed, streamStats.Failed);
+                    ImGui::Text("Uploaded last frame: %.1f KB", streamStats.UploadedBytesLastFrame / 1024.0f);
+                    ImGui::Text("Total uploaded: %.1f MB", streamStats.TotalUploadedBytes / (1024.0f * 1024.0f));
+                    ImGui::Text("Avg decode: %.2f ms  Avg latency: %.2f ms", streamStats.AverageDecodeMs,
+                                streamStats.AverageLatencyMs);
+                }
+            }
             ImGui::End();
 
             ImGui::Begin("Settings");
             ImGui::Checkbox("Show physics colliders", &m_ShowPhysicsColliders);
+            if (ImGui::Checkbox("Physics collision filtering", &m_Physics2DFiltering))
+                m_ActiveScene->SetPhysics2DFilteringEnabled(m_Physics2DFiltering);
+            ImGui::SetNextItemWidth(100.0f);
+            if (ImGui::InputInt("Bodies created per frame (0 = all)", &m_Physics2DBodiesPerFrame))
+                m_Physics2DBodiesPerFrame = std::max(m_Physics2DBodiesPerFrame, 0);
+            DrawPhysics2DLayerSettings();
+
+            if (Project::GetActive())
+            {
+                auto assetManager = Project::GetAssetManager();
+                bool asyncTextures = assetManager->IsAsyncTextureLoading();
+                if (ImGui::Checkbox("Async texture loading", &asyncTextures))
+                    assetManager->SetAsyncTextureLoading(asyncTextures);
+                ImGui::Checkbox("Preload scene assets before play", &m_PreloadAssetsOnPlay);
+                ImGui::Checkbox("Pack assets on build (.hpak)", &m_PackAssetsOnBuild);
+                ImGui::BeginDisabled(!m_PackAssetsOnBuild);
+                ImGui::Checkbox("Compress asset pack (LZ4)", &m_CompressAssetPack);
+                ImGui::EndDisabled();
+                ImGui::Checkbox("Cook assets on build", &m_CookAssetsOnBuild);
+                ImGui::BeginDisabled(!m_CookAssetsOnBuild);
+                const char *compressionNames[] = {"None", "Auto (BC1/BC7)", "BC1", "BC3", "BC7"};
+                ImGui::SetNextItemWidth(150.0f);
+                if (ImGui::BeginCombo("Texture compression", compressionNames[(int)m_CookTextureCompression]))
+                {
+                    for (int i = 0; i < 5; i++)
+                    {
+                        bool isSelected = (int)m_CookTextureCompression == i;
+                        if (ImGui::Selectable(compressionNames[i], isSelected))
+                            m_CookTextureCompression = (TextureCompression)i;
+                        if (isSelected)
+                            ImGui::SetItemDefaultFocus();
+                    }
+                    ImGui::EndCombo();
+                }
+                ImGui::EndDisabled();
+
+                bool autosave = m_SceneAutosaver.IsEnabled();
+                if (ImGui::Checkbox("Autosave scene", &autosave))
+                    m_SceneAutosaver.SetEnabled(autosave);
+                float autosaveInterval = m_SceneAutosaver.GetInterval();
+                ImGui::SetNextItemWidth(100.0f);
+                if (ImGui::DragFloat("Autosave interval (s)", &autosaveInterval, 1.0f, 5.0f, 600.0f, "%.0f"))
+                    m_SceneAutosaver.SetInterval(autosaveInterval);
+                float autosaveBudget = m_SceneAutosaver.GetFrameBudget();
+                ImGui::SetNextItemWidth(100.0f);
+                if (ImGui::DragFloat("Autosave budget per frame (ms)", &autosaveBudget, 0.1f, 0.1f, 16.0f, "%.1f"))
+                    m_SceneAutosaver.SetFrameBudget(autosaveBudget);
+                int budgetMB = (int)Project::GetConfig().AssetMemoryBudgetMB;
+                ImGui::SetNextItemWidth(100.0f);
+                if (ImGui::InputInt("Asset memory budget (MB, 0 = unlimited)", &budgetMB))
+                {
+                    Project::GetConfig().AssetMemoryBudgetMB = (uint32_t)std::max(budgetMB, 0);
+                    assetManager->SetMemoryBudget((uint64_t)Project::GetConfig().AssetMemoryBudgetMB * 1024 * 1024);
+                }
+                if (ImGui::Button("Unload Unused Assets"))
+                    assetManager->UnloadUnusedAssets();
+
+                if (TextureStreamer *streamer = assetManager->GetTextureStreamer())
+                {
+                    int budgetKB = (int)(streamer->GetUploadBudget() / 1024);
+                    ImGui::SetNextItemWidth(100.0f);
+                    if (ImGui::InputInt("Texture upload budget (KB/frame)", &budgetKB))
+                        streamer->SetUploadBudget((uint64_t)std::max(budgetKB, 64) * 1024);
+                }
+            }
+
+            if (m_SceneState != SceneState::Edit)
+            {
+                if (ImGui::Button("Save Physics Snapshot"))
+                    m_ActiveScene->SavePhysics2DSnapshot(m_Physics2DSnapshot);
+                ImGui::SameLine();
+                if (ImGui::Button("Restore Physics Snapshot"))
+                    m_ActiveScene->RestorePhysics2DSnapshot(m_Physics2DSnapshot);
+                ImGui::Text("Snapshot: %d bodies, %.1f KB", (int)m_Physics2DSnapshot.Bodies.size(),
+                            m_Physics2DSnapshot.GetSize() / 1024.0f);
+            }
 
             //ImGui::Image((ImTextureID)s_Font->GetAtlasTexture()->GetRendererID(), {512, 512}, {0, 1}, {1, 0});
 
@@ -298,9 +515,12 @@ namespace Himii
                 m_ViewportSize = {viewportPanelSize.x, viewportPanelSize.y};
             }
 
+            // 附件可能大于可见区域，只显示左下角实际渲染的部分
+            const auto &fbSpec = m_Framebuffer->GetSpecification();
+            const auto &fbStats = m_Framebuffer->GetStats();
             uint64_t textureID = m_Framebuffer->GetColorAttachmentRendererID();
-            ImGui::Image(reinterpret_cast<void *>(textureID), ImVec2(m_ViewportSize.x, m_ViewportSize.y), ImVec2(0, 1),
-                         ImVec2(1, 0));
+            ImGui::Image(reinterpret_cast<void *>(textureID), ImVec2(m_ViewportSize.x, m_ViewportSize.y),
+                         ImVec2(0, fbStats.GetUVScaleY(fbSpec.Height)), ImVec2(fbStats.GetUVScaleX(fbSpec.Width), 0));
 
             if (ImGui::BeginDragDropTarget())
             {
@@ -361,6 +581,7 @@ namespace Himii
                     transformComponent.Position = translation;
                     transformComponent.Rotation += deltaRotation;
                     transformComponent.Scale = scale;
+                    selectEntity.PatchComponent<TransformComponent>();
                 }
             }
 
@@ -498,71 +719,132 @@ namespace Himii
             Renderer2D::BeginScene(m_EditorCamera);
         }
 
+        if (m_OverlayScene != m_ActiveScene)
+            SetOverlayScene(m_ActiveScene);
+
+        // 运行和模拟时物理、脚本直接修改 Transform，不会发出变更信号，只能每帧重建
+        bool rebuildEveryFrame = m_SceneState != SceneState::Edit;
+
         if (m_ShowGrid)
+            Renderer2D::DrawGrid();
+
+        if (m_ShowPhysicsColliders)
         {
-            // Grid Rendering
-            const float gridSize = 100.0f;
-            const float gridSpacing = 1.0f;
-            const glm::vec4 gridColor = glm::vec4(0.6f, 0.6f, 0.6f, 1.0f);
-            
-            // Draw Vertical lines
-            for (float x = -gridSize; x <= gridSize; x += gridSpacing)
-            {
-                Renderer2D::DrawLine(glm::vec3(x, -gridSize, 0.0f), glm::vec3(x, gridSize, 0.0f), gridColor);
-            }
-            
-            // Draw Horizontal lines
-            for (float y = -gridSize; y <= gridSize; y += gridSpacing)
-            {
-                Renderer2D::DrawLine(glm::vec3(-gridSize, y, 0.0f), glm::vec3(gridSize, y, 0.0f), gridColor);
-            }
+            if (m_ColliderOverlayDirty || rebuildEveryFrame)
+                RebuildColliderOverlay();
+            Renderer2D::DrawLineGeometry(m_ColliderOverlay);
         }
 
-        if (m_ShowPhysicsColliders)
+        // Draw selected entity outline
+        if (Entity selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity())
         {
-            // Box Colliders
-            {
-                auto view = m_ActiveScene->GetAllEntitiesWith<TransformComponent, BoxCollider2DComponent>();
-                view.each(
-                        [&](auto entity, auto &tc, auto &bc2d)
-                        {
-                            glm::vec3 translation = tc.Position + glm::vec3(bc2d.Offset, 0.001f);
-                            glm::vec3 scale = tc.Scale * glm::vec3(bc2d.Size, 1.0f);
+            if (m_SelectionOverlayDirty || rebuildEveryFrame || selectedEntity != m_SelectionOverlayEntity)
+                RebuildSelectionOverlay(selectedEntity);
+            Renderer2D::DrawLineGeometry(m_SelectionOverlay);
+        }
 
-                            glm::mat4 transform =
-                                    glm::translate(glm::mat4(1.0f), translation) 
-                                * glm::rotate(glm::mat4(1.0f),tc.Rotation.z,glm::vec3(0.0f,0.0f,1.0f))
-                                * glm::translate(glm::mat4(1.0f),glm::vec3(bc2d.Offset,0.001f))
-                                * glm::scale(glm::mat4(1.0f), scale);
+        Renderer2D::EndScene();
+    }
 
-                            Renderer2D::DrawRect(transform, glm::vec4(0, 1, 0, 1));
-                        });
-            }
+    void EditorLayer::RebuildColliderOverlay()
+    {
+        HIMII_PROFILE_FUNCTION();
 
-            // Circle Colliders
-            {
-                auto view = m_ActiveScene->GetAllEntitiesWith<TransformComponent, CircleCollider2DComponent>();
-                view.each(
-                        [&](auto entity, auto &tc, auto &cc2d)
-                        {
-                            glm::vec3 translation = tc.Position + glm::vec3(cc2d.Offset, 0.001f);
-                            glm::vec3 scale = tc.Scale * glm::vec3(cc2d.Radius * 2.0f);
+        m_ColliderOverlay.Clear();
+        const glm::vec4 colliderColor = glm::vec4(0, 1, 0, 1);
 
-                            glm::mat4 transform =
-                                    glm::translate(glm::mat4(1.0f), translation) * glm::scale(glm::mat4(1.0f), scale);
+        // Box Colliders：偏移随物体旋转，与 Box2D 中形状的位置一致
+        {
+            auto view = m_ActiveScene->GetAllEntitiesWith<TransformComponent, BoxCollider2DComponent>();
+            view.each(
+                    [&](auto entity, auto &tc, auto &bc2d)
+                    {
+                        glm::mat4 transform = glm::translate(glm::mat4(1.0f), tc.Position) *
+                                              glm::rotate(glm::mat4(1.0f), tc.Rotation.z, glm::vec3(0.0f, 0.0f, 1.0f)) *
+                                              glm::translate(glm::mat4(1.0f), glm::vec3(bc2d.Offset, 0.001f)) *
+                                              glm::scale(glm::mat4(1.0f), tc.Scale * glm::vec3(bc2d.Size, 1.0f));
 
-                            Renderer2D::DrawCircle(transform, glm::vec4(0, 1, 0, 1), 0.01f);
-                        });
-            }
+                        m_ColliderOverlay.AddRect(transform, colliderColor);
+                    });
         }
-        // Draw selected entity outline
-        if (Entity selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity())
+
+        // Circle Colliders
         {
-            const TransformComponent &transform = selectedEntity.GetComponent<TransformComponent>();
-            Renderer2D::DrawRect(transform.GetTransform(), glm::vec4(1.0f, 0.5f, 0.0f, 1.0f));
+            auto view = m_ActiveScene->GetAllEntitiesWith<TransformComponent, CircleCollider2DComponent>();
+            view.each(
+                    [&](auto entity, auto &tc, auto &cc2d)
+                    {
+                        glm::vec3 translation = tc.Position + glm::vec3(cc2d.Offset, 0.001f);
+                        glm::vec3 scale = tc.Scale * glm::vec3(cc2d.Radius * 2.0f);
+
+                        glm::mat4 transform =
+                                glm::translate(glm::mat4(1.0f), translation) * glm::scale(glm::mat4(1.0f), scale);
+
+                        m_ColliderOverlay.AddCircle(transform, colliderColor);
+                    });
         }
 
-        Renderer2D::EndScene();
+        m_ColliderOverlay.Upload();
+        m_ColliderOverlayDirty = false;
+    }
+
+    void EditorLayer::RebuildSelectionOverlay(Entity selectedEntity)
+    {
+        m_SelectionOverlay.Clear();
+        const TransformComponent &transform = selectedEntity.GetComponent<TransformComponent>();
+        m_SelectionOverlay.AddRect(transform.GetTransform(), glm::vec4(1.0f, 0.5f, 0.0f, 1.0f));
+        m_SelectionOverlay.Upload();
+
+        m_SelectionOverlayEntity = selectedEntity;
+        m_SelectionOverlayDirty = false;
+    }
+
+    template<typename T>
+    void EditorLayer::ConnectOverlayTracking(entt::registry &registry, bool connect)
+    {
+        if (connect)
+        {
+            registry.on_construct<T>().template connect<&EditorLayer::OnOverlayComponentChanged>(*this);
+            registry.on_update<T>().template connect<&EditorLayer::OnOverlayComponentChanged>(*this);
+            registry.on_destroy<T>().template connect<&EditorLayer::OnOverlayComponentChanged>(*this);
+        }
+        else
+        {
+            registry.on_construct<T>().template disconnect<&EditorLayer::OnOverlayComponentChanged>(*this);
+            registry.on_update<T>().template disconnect<&EditorLayer::OnOverlayComponentChanged>(*this);
+            registry.on_destroy<T>().template disconnect<&EditorLayer::OnOverlayComponentChanged>(*this);
+        }
+    }
+
+    void EditorLayer::SetOverlayScene(const Ref<Scene> &scene)
+    {
+        // 编辑器对组件的修改都经过 Entity::PatchComponent，会触发 on_update
+        if (m_OverlayScene)
+        {
+            entt::registry &registry = m_OverlayScene->Registry();
+            ConnectOverlayTracking<TransformComponent>(registry, false);
+            ConnectOverlayTracking<BoxCollider2DComponent>(registry, false);
+            ConnectOverlayTracking<CircleCollider2DComponent>(registry, false);
+        }
+
+        m_OverlayScene = scene;
+        if (m_OverlayScene)
+        {
+            entt::registry &registry = m_OverlayScene->Registry();
+            ConnectOverlayTracking<TransformComponent>(registry, true);
+            ConnectOverlayTracking<BoxCollider2DComponent>(registry, true);
+            ConnectOverlayTracking<CircleCollider2DComponent>(registry, true);
+        }
+
+        m_ColliderOverlayDirty = true;
+        m_SelectionOverlayDirty = true;
+    }
+
+    void EditorLayer::OnOverlayComponentChanged(entt::registry &registry, entt::entity entity)
+    {
+        m_ColliderOverlayDirty = true;
+        if (entity == (entt::entity)m_SelectionOverlayEntity)
+            m_SelectionOverlayDirty = true;
     }
 
     void EditorLayer::NewProject()
@@ -743,8 +1025,30 @@ namespace Himii
         std::filesystem::path gameDllSource = Project::GetProjectDirectory() / Project::GetConfig().ScriptModulePath;
         filesToCopy.push_back({gameDllSource, buildDir / "GameAssembly.dll"}); // 强制改名或保持原名
 
-        //复制 Assets 文件夹 (递归)
-        filesToCopy.push_back({Project::GetAssetDirectory(), buildDir / "assets", true});
+        // 烘焙：纹理生成 mip、场景和动画转二进制、裁剪未引用的资源；输出缓存在 Intermediate/Cook，下次只处理变化的文件
+        std::filesystem::path assetSourceDir = Project::GetAssetDirectory();
+        if (m_CookAssetsOnBuild)
+        {
+            AssetCookOptions cookOptions;
+            cookOptions.SourceDirectory = Project::GetAssetDirectory();
+            cookOptions.CacheDirectory = Project::GetProjectDirectory() / "Intermediate" / "Cook";
+            cookOptions.RegistryOutputPath = buildDir / "AssetRegistry.yaml";
+            cookOptions.Registry = &Project::GetAssetManager()->GetAssetRegistry();
+            cookOptions.Settings.Compression = m_CookTextureCompression;
+
+            AssetCookReport cookReport = AssetCooker::Cook(cookOptions);
+            if (cookReport.Succeeded)
+                assetSourceDir = cookReport.CookedDirectory;
+            else
+                HIMII_CORE_ERROR("Build: {0} assets failed to cook, shipping source assets instead (see {1})",
+                                 cookReport.FailedCount, (cookOptions.CacheDirectory / "CookReport.csv").string());
+        }
+        if (assetSourceDir == Project::GetAssetDirectory())
+            filesToCopy.push_back({Project::GetAssetRegistryPath(), buildDir / "AssetRegistry.yaml"});
+
+        //复制 Assets 文件夹 (递归)；打包时改为写入 assets.hpak，运行时挂载到 assets 目录
+        if (!m_PackAssetsOnBuild)
+            filesToCopy.push_back({assetSourceDir, buildDir / "assets", true});
 
         //复制并重命名项目配置文件 (.hproj)
         std::filesystem::path projectSource = Project::GetProjectDirectory() / (Project::GetConfig().Name + ".hproj");
@@ -783,6 +1087,16 @@ namespace Himii
             }
         }
 
+        if (m_PackAssetsOnBuild)
+        {
+            AssetPackWriteOptions options;
+            options.Compress = m_CompressAssetPack;
+            if (AssetPack::Write(assetSourceDir, buildDir / "assets.hpak", options))
+                successCount++;
+            else
+                HIMII_CORE_ERROR("Build Failed: could not pack project assets");
+        }
+
         if (successCount > 0)
             HIMII_CORE_INFO("Build Completed Successfully! Output: {0}", buildDir.string());
         else
@@ -853,11 +1167,14 @@ namespace Himii
         m_SceneHierarchyPanel.SetSelectedEntity({});
         m_HoveredEntity = {};
 
-        m_ActiveScene = CreateRef<Scene>();
-        m_ActiveScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+        m_EditorScene = CreateRef<Scene>();
+        m_EditorScene->OnViewportResize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
+        m_ActiveScene = m_EditorScene;
         m_SceneHierarchyPanel.SetContext(m_ActiveScene);
 
         m_EditorScenePath = std::filesystem::path();
+        // 没有路径时只维护片段缓存，Save As 之后开始写盘
+        m_SceneAutosaver.Attach(m_EditorScene, m_EditorScenePath);
     }
 
     void EditorLayer::LoadRecentProjects()
@@ -980,7 +1297,7 @@ namespace Himii
 
     void EditorLayer::OpenScene()
     {
-        std::string filePath = FileDialog::OpenFile("Himii Scene(*.himii)\0*.himii\0");
+        std::string filePath = FileDialog::OpenFile("Himii Scene(*.himii;*.hscn)\0*.himii;*.hscn\0");
 
         if (!filePath.empty())
         {
@@ -999,8 +1316,18 @@ namespace Himii
         m_HoveredEntity = {};
 
         Ref<Scene> newScene = CreateRef<Scene>();
-        SceneSerializer serializer(newScene);
-        if (serializer.Deserialize(path.string()))
+        bool loaded = false;
+        if (SceneBinarySerializer::IsBinaryScenePath(path))
+        {
+            SceneBinarySerializer serializer(newScene);
+            loaded = serializer.Deserialize(path);
+        }
+        else
+        {
+            SceneSerializer serializer(newScene);
+            loaded = serializer.Deserialize(path.string());
+        }
+        if (loaded)
         {
             m_EditorScene = newScene;
             m_SceneHierarchyPanel.SetContext(m_EditorScene);
@@ -1008,6 +1335,12 @@ namespace Himii
 
             m_ActiveScene = m_EditorScene;
             m_EditorScenePath = path;
+
+            // 增量保存只支持 YAML，二进制场景写入本身就很快
+            if (SceneBinarySerializer::IsBinaryScenePath(path))
+                m_SceneAutosaver.Detach();
+            else
+                m_SceneAutosaver.Attach(m_EditorScene, path);
         }
     }
 
@@ -1015,7 +1348,11 @@ namespace Himii
     {
         if (!m_EditorScenePath.empty())
         {
-            SerializeScene(m_ActiveScene, m_EditorScenePath);
+            // 只重新生成脏实体，写盘在后台；编辑器的修改都经过 PatchComponent，脏集合是完整的
+            if (m_SceneState == SceneState::Edit && m_SceneAutosaver.IsAttachedTo(m_EditorScene))
+                m_SceneAutosaver.SaveNow();
+            else
+                SerializeScene(m_ActiveScene, m_EditorScenePath);
         }
         else
         {
@@ -1048,17 +1385,33 @@ namespace Himii
     
     void EditorLayer::SaveSceneAs()
     {
-        std::string filePath = FileDialog::SaveFile("Himii Scene(*.himii)\0*.himii\0");
+        std::string filePath = FileDialog::SaveFile("Himii Scene(*.himii)\0*.himii\0Himii Binary Scene(*.hscn)\0*.hscn\0");
         if (!filePath.empty())
         {
-            SerializeScene(m_ActiveScene, filePath);
-
             m_EditorScenePath = filePath;
+            if (SceneBinarySerializer::IsBinaryScenePath(m_EditorScenePath))
+            {
+                m_SceneAutosaver.Detach();
+                SerializeScene(m_ActiveScene, m_EditorScenePath);
+                return;
+            }
+
+            m_SceneAutosaver.Attach(m_EditorScene, m_EditorScenePath);
+            if (m_SceneState == SceneState::Edit)
+                m_SceneAutosaver.SaveNow();
+            else
+                SerializeScene(m_ActiveScene, m_EditorScenePath);
         }
     }
 
     void EditorLayer::SerializeScene(Ref<Scene> scene, const std::filesystem::path &path)
     {
+        if (SceneBinarySerializer::IsBinaryScenePath(path))
+        {
+            SceneBinarySerializer serializer(scene);
+            serializer.Serialize(path);
+            return;
+        }
         SceneSerializer serializer(scene);
         serializer.Serialize(path.string());
     }
@@ -1071,11 +1424,286 @@ namespace Himii
         m_SceneState = SceneState::Play;
 
         m_ActiveScene = Scene::Copy(m_EditorScene);
+        m_ActiveScene->SetPhysics2DFilteringEnabled(m_Physics2DFiltering);
+        m_ActiveScene->SetPhysics2DBodiesPerFrame((uint32_t)m_Physics2DBodiesPerFrame);
+        if (m_PreloadAssetsOnPlay)
+            PreloadSceneAssets(m_ActiveScene);
         m_ActiveScene->OnRuntimeStart();
 
         m_SceneHierarchyPanel.SetContext(m_ActiveScene);
     }
 
+    void EditorLayer::PreloadSceneAssets(const Ref<Scene> &scene)
+    {
+        if (!Project::GetActive())
+            return;
+
+        // 运行开始前把场景引用的纹理和动画全部加载好，避免前几帧在 GetAsset 中卡顿
+        uint32_t lastDecile = 0;
+        m_LastPreloadReport = Project::GetAssetManager()->PreloadAssets(
+                scene->CollectAssetDependencies(),
+                [&lastDecile](uint32_t completed, uint32_t total)
+                {
+                    uint32_t decile = completed * 10 / total;
+                    if (decile != lastDecile)
+                    {
+                        lastDecile = decile;
+                        HIMII_CORE_INFO("Preloading scene assets: {0}/{1}", completed, total);
+                    }
+                });
+
+        auto &assets = m_LastPreloadReport.Assets;
+        std::sort(assets.begin(), assets.end(),
+                  [](const AssetLoadTiming &a, const AssetLoadTiming &b) { return a.Milliseconds > b.Milliseconds; });
+        HIMII_CORE_INFO("Preloaded {0} scene assets ({1} already loaded) in {2:.2f} ms", assets.size(),
+                        m_LastPreloadReport.AlreadyLoaded, m_LastPreloadReport.TotalMilliseconds);
+        for (const auto &timing: assets)
+        {
+            if (!timing.Succeeded)
+                HIMII_CORE_WARNING("Failed to preload asset {0}", (uint64_t)timing.Handle);
+        }
+    }
+
+    void EditorLayer::DrawPhysics2DLayerSettings()
+    {
+        if (!Project::GetActive())
+            return;
+
+        if (!ImGui::CollapsingHeader("Physics 2D Layers"))
+            return;
+
+        // 层名修改和矩阵随项目保存（File -> Save Project）
+        auto &layers = Project::GetConfig().Physics2DLayers;
+        std::vector<uint32_t> named;
+        for (uint32_t i = 0; i < Physics2DLayerMatrix::MaxLayers; ++i)
+        {
+            ImGui::PushID((int)i);
+            ImGui::SetNextItemWidth(160.0f);
+            ImGui::InputText(("Layer " + std::to_string(i)).c_str(), &layers.Names[i]);
+            ImGui::PopID();
+            if (!layers.Names[i].empty())
+                named.push_back(i);
+        }
+
+        if (named.empty())
+            return;
+
+        ImGui::Text("Collision Matrix");
+        if (ImGui::BeginTable("##LayerMatrix", (int)named.size() + 1,
+                              ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("");
+            for (uint32_t layer: named)
+                ImGui::TableSetupColumn(layers.Names[layer].c_str());
+            ImGui::TableHeadersRow();
+
+            for (size_t row = 0; row < named.size(); ++row)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(layers.Names[named[row]].c_str());
+                for (size_t col = 0; col < named.size(); ++col)
+                {
+                    ImGui::TableNextColumn();
+                    // 矩阵对称，只显示上三角
+                    if (col < row)
+                        continue;
+
+                    bool collide = layers.CanCollide(named[row], named[col]);
+                    ImGui::PushID((int)(row * Physics2DLayerMatrix::MaxLayers + col));
+                    if (ImGui::Checkbox("##Collide", &collide))
+                        layers.SetCollision(named[row], named[col], collide);
+                    ImGui::PopID();
+                }
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    void EditorLayer::BenchmarkPhysics2DSnapshot()
+    {
+        const int gridSize = 100; // 100 x 100 = 10k 刚体
+        const int iterations = 20;
+
+        Ref<Scene> scene = CreateRef<Scene>();
+        for (int y = 0; y < gridSize; ++y)
+        {
+            for (int x = 0; x < gridSize; ++x)
+            {
+                Entity entity = scene->CreateEntity("Body");
+                entity.GetComponent<TransformComponent>().Position = {x * 1.5f, y * 1.5f, 0.0f};
+                entity.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Dynamic;
+                entity.AddComponent<BoxCollider2DComponent>();
+            }
+        }
+
+        scene->OnSimulationStart();
+        // 先跑几步，让刚体处于运动中
+        for (int i = 0; i < 10; ++i)
+            scene->StepPhysics2D(1.0f / 60.0f);
+
+        Physics2DSnapshot snapshot;
+        float saveTotal = 0.0f, restoreTotal = 0.0f;
+        for (int i = 0; i < iterations; ++i)
+        {
+            Timer saveTimer;
+            scene->SavePhysics2DSnapshot(snapshot);
+            saveTotal += saveTimer.ElapsedMillis();
+
+            scene->StepPhysics2D(1.0f / 60.0f);
+
+            Timer restoreTimer;
+            scene->RestorePhysics2DSnapshot(snapshot);
+            restoreTotal += restoreTimer.ElapsedMillis();
+        }
+        scene->OnSimulationStop();
+
+        HIMII_CORE_INFO("Physics2D snapshot benchmark: {0} bodies, {1} KB, save {2:.3f} ms, restore {3:.3f} ms",
+                        snapshot.Bodies.size(), snapshot.GetSize() / 1024, saveTotal / iterations,
+                        restoreTotal / iterations);
+    }
+
+    void EditorLayer::BenchmarkSceneSerialization()
+    {
+        const int entityCount = 10000;
+        const int iterations = 5;
+
+        Ref<Scene> scene = CreateRef<Scene>();
+        for (int i = 0; i < entityCount; ++i)
+        {
+            Entity entity = scene->CreateEntity("Entity " + std::to_string(i));
+            entity.GetComponent<TransformComponent>().Position = {(i % 100) * 1.5f, (i / 100) * 1.5f, 0.0f};
+            entity.AddComponent<SpriteRendererComponent>(glm::vec4{(i % 7) / 7.0f, (i % 11) / 11.0f, 0.5f, 1.0f});
+            if (i % 4 == 0)
+            {
+                entity.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Dynamic;
+                entity.AddComponent<BoxCollider2DComponent>();
+            }
+            if (i % 10 == 0)
+                entity.AddComponent<CircleRendererComponent>();
+        }
+
+        std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+        std::filesystem::path yamlPath = tempDirectory / "HimiiSceneBenchmark.himii";
+        std::filesystem::path binaryPath = tempDirectory / "HimiiSceneBenchmark.hscn";
+
+        float yamlSave = 0.0f, yamlLoad = 0.0f, binarySave = 0.0f, binaryLoad = 0.0f;
+        Ref<Scene> binaryScene;
+        for (int i = 0; i < iterations; ++i)
+        {
+            Timer yamlSaveTimer;
+            SceneSerializer(scene).Serialize(yamlPath.string());
+            yamlSave += yamlSaveTimer.ElapsedMillis();
+
+            Timer yamlLoadTimer;
+            SceneSerializer(CreateRef<Scene>()).Deserialize(yamlPath.string());
+            yamlLoad += yamlLoadTimer.ElapsedMillis();
+
+            Timer binarySaveTimer;
+            SceneBinarySerializer(scene).Serialize(binaryPath);
+            binarySave += binarySaveTimer.ElapsedMillis();
+
+            binaryScene = CreateRef<Scene>();
+            Timer binaryLoadTimer;
+            SceneBinarySerializer(binaryScene).Deserialize(binaryPath);
+            binaryLoad += binaryLoadTimer.ElapsedMillis();
+        }
+
+        // 逐实体比较 YAML 输出，确认二进制往返无损（实体顺序不同，按 UUID 对齐）
+        auto collectEntityYaml = [](Ref<Scene> source)
+        {
+            std::unordered_map<uint64_t, std::string> result;
+            source->Registry().view<IDComponent>().each(
+                    [&](auto handle, IDComponent &id)
+                    {
+                        YAML::Emitter out;
+                        SceneSerializer::SerializeEntity(out, Entity{handle, source.get()});
+                        result[(uint64_t)id.ID] = out.c_str();
+                    });
+            return result;
+        };
+        bool lossless = collectEntityYaml(scene) == collectEntityYaml(binaryScene);
+
+        std::error_code error;
+        uint64_t yamlSize = std::filesystem::file_size(yamlPath, error);
+        uint64_t binarySize = std::filesystem::file_size(binaryPath, error);
+        std::filesystem::remove(yamlPath, error);
+        std::filesystem::remove(binaryPath, error);
+
+        HIMII_CORE_INFO("Scene serialization benchmark: {0} entities, YAML {1} KB save {2:.2f} ms load {3:.2f} ms, "
+                        "binary {4} KB save {5:.2f} ms load {6:.2f} ms, round trip {7}",
+                        entityCount, yamlSize / 1024, yamlSave / iterations, yamlLoad / iterations, binarySize / 1024,
+                        binarySave / iterations, binaryLoad / iterations, lossless ? "lossless" : "MISMATCH");
+    }
+
+    void EditorLayer::BenchmarkAssetPack()
+    {
+        std::filesystem::path assetDirectory = Project::GetAssetDirectory();
+        std::filesystem::path packPath = std::filesystem::temp_directory_path() / "HimiiAssetBenchmark.hpak";
+
+        AssetPackWriteOptions options;
+        options.Compress = m_CompressAssetPack;
+        AssetPackWriteReport report;
+        if (!AssetPack::Write(assetDirectory, packPath, options, &report))
+            return;
+
+        // 散文件：与打包前的运行时一样逐个打开、读取、关闭
+        Timer looseTimer;
+        uint64_t looseBytes = 0;
+        std::vector<char> buffer;
+        for (auto &entry: std::filesystem::recursive_directory_iterator(assetDirectory))
+        {
+            if (!entry.is_regular_file())
+                continue;
+            std::ifstream stream(entry.path(), std::ios::binary);
+            stream.seekg(0, std::ios::end);
+            buffer.resize((size_t)stream.tellg());
+            stream.seekg(0, std::ios::beg);
+            stream.read(buffer.data(), (std::streamsize)buffer.size());
+            looseBytes += buffer.size();
+        }
+        float looseMs = looseTimer.ElapsedMillis();
+
+        // 资源包：一次映射，按路径查 TOC 后读取（压缩条目需要解压）
+        AssetPack pack;
+        Timer packTimer;
+        uint64_t packBytes = 0;
+        std::vector<uint8_t> data;
+        if (pack.Open(packPath))
+        {
+            float openMs = packTimer.ElapsedMillis();
+            for (const auto &entry: pack.GetEntries())
+            {
+                const AssetPackEntry *found = pack.Find(std::filesystem::u8path(pack.GetEntryPath(entry)));
+                if (found && pack.Read(*found, data))
+                    packBytes += data.size();
+            }
+            HIMII_CORE_INFO("Asset pack benchmark: {0} files, loose {1} KB read in {2:.2f} ms, "
+                            "pack {3} KB on disk ({4} compressed) open {5:.2f} ms, read {6} KB in {7:.2f} ms",
+                            report.FileCount, looseBytes / 1024, looseMs, report.PackBytes / 1024,
+                            report.CompressedCount, openMs, packBytes / 1024, packTimer.ElapsedMillis());
+        }
+        pack.Close();
+
+        std::error_code error;
+        std::filesystem::remove(packPath, error);
+    }
+
+    void EditorLayer::ConvertEditorSceneFormat()
+    {
+        // .himii 转为同名 .hscn，反之亦然；转换的是磁盘上的文件，未保存的修改需要先保存
+        std::filesystem::path sourcePath = m_EditorScenePath;
+        bool toBinary = !SceneBinarySerializer::IsBinaryScenePath(sourcePath);
+        std::filesystem::path targetPath = std::filesystem::path(sourcePath).replace_extension(toBinary ? ".hscn" : ".himii");
+
+        bool converted = toBinary ? SceneBinarySerializer::ConvertYamlToBinary(sourcePath, targetPath)
+                                  : SceneBinarySerializer::ConvertBinaryToYaml(sourcePath, targetPath);
+        if (converted)
+            HIMII_CORE_INFO("Converted scene '{0}' to '{1}'", sourcePath.string(), targetPath.string());
+        else
+            HIMII_CORE_ERROR("Failed to convert scene '{0}'", sourcePath.string());
+    }
+
     void EditorLayer::OnSceneSimulate()
     {
         if (m_SceneState == SceneState::Play)
@@ -1084,6 +1712,8 @@ namespace Himii
         m_SceneState = SceneState::Simulate;
 
         m_ActiveScene = Scene::Copy(m_EditorScene);
+        m_ActiveScene->SetPhysics2DFilteringEnabled(m_Physics2DFiltering);
+        m_ActiveScene->SetPhysics2DBodiesPerFrame((uint32_t)m_Physics2DBodiesPerFrame);
         m_ActiveScene->OnSimulationStart();
 
         m_SceneHierarchyPanel.SetContext(m_ActiveScene);
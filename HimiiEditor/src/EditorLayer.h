@@ -5,6 +5,7 @@
 #include "panel/AnimationPanel.h"
 
 #include "Himii/Renderer/EditorCamera.h"
+#include "Himii/Renderer/LineGeometry.h"
 
 namespace Himii
 {
@@ -25,6 +26,12 @@ namespace Himii
         bool OnMouseButtonPressed(MouseButtonPressedEvent &e);
 
         void OnOverlayRender();
+        void RebuildColliderOverlay();
+        void RebuildSelectionOverlay(Entity selectedEntity);
+        void SetOverlayScene(const Ref<Scene> &scene);
+        template<typename T>
+        void ConnectOverlayTracking(entt::registry &registry, bool connect);
+        void OnOverlayComponentChanged(entt::registry &registry, entt::entity entity);
 
         void NewProject();
         void OpenProject(const std::filesystem::path &path);
@@ -42,6 +49,12 @@ namespace Himii
         void SerializeScene(Ref<Scene> scene, const std::filesystem::path &path);
 
         void OnScenePlay();
+        void PreloadSceneAssets(const Ref<Scene> &scene);
+        void DrawPhysics2DLayerSettings();
+        void BenchmarkPhysics2DSnapshot();
+        void BenchmarkSceneSerialization();
+        void BenchmarkAssetPack();
+        void ConvertEditorSceneFormat();
         void OnSceneSimulate();
         void OnSceneStop();
 
@@ -80,8 +93,26 @@ namespace Himii
         int m_GizmoType = -1;
 
         bool m_ShowPhysicsColliders = false;
+        bool m_Physics2DFiltering = true;
+        int m_Physics2DBodiesPerFrame = 0;
+        Physics2DSnapshot m_Physics2DSnapshot;
+        bool m_PreloadAssetsOnPlay = true;
+        bool m_PackAssetsOnBuild = true;
+        bool m_CompressAssetPack = true;
+        bool m_CookAssetsOnBuild = true;
+        TextureCompression m_CookTextureCompression = TextureCompression::Auto;
+        SceneAutosaver m_SceneAutosaver;
+        AssetPreloadReport m_LastPreloadReport;
         bool m_ShowGrid = true;
 
+        // 碰撞体和选中框的线框缓存，编辑模式下只在 Transform / 碰撞体组件变化或选择变化时重建
+        LineGeometry m_ColliderOverlay;
+        LineGeometry m_SelectionOverlay;
+        Entity m_SelectionOverlayEntity;
+        bool m_ColliderOverlayDirty = true;
+        bool m_SelectionOverlayDirty = true;
+        Ref<Scene> m_OverlayScene; // 当前连接了组件变更信号的场景
+
         enum class SceneState {
             Edit = 0,
             Play = 1,
@@ -35,6 +35,7 @@ namespace Himii
 
         ImGui::NextColumn();
 
+        RenderSpriteSheetSettings();
         RenderTimeline();
 
         ImGui::Columns(1);
@@ -86,10 +87,23 @@ namespace Himii
         // 预览逻辑更新
         if (m_CurrentAnimation && m_CurrentAnimation->GetFrameCount() > 0)
         {
+            // 帧可能刚被删除或切换了动画，先钳制再读取当前帧
+            if (m_PreviewFrameIndex >= m_CurrentAnimation->GetFrameCount())
+                m_PreviewFrameIndex = 0;
+
             if (m_IsPlaying)
             {
+                // 精灵表帧可以有自己的时长，否则使用预览 FPS
+                float frameDuration = 1.0f / m_FrameRate;
+                if (m_CurrentAnimation->IsSpriteSheet())
+                {
+                    float duration = m_CurrentAnimation->GetSheetFrames()[m_PreviewFrameIndex].Duration;
+                    if (duration > 0.0f)
+                        frameDuration = duration;
+                }
+
                 m_Timer += ImGui::GetIO().DeltaTime;
-                if (m_Timer >= (1.0f / m_FrameRate))
+                if (m_Timer >= frameDuration)
                 {
                     m_Timer = 0.0f;
                     m_PreviewFrameIndex = (m_PreviewFrameIndex + 1) % m_CurrentAnimation->GetFrameCount();
@@ -102,18 +116,34 @@ namespace Himii
                     m_PreviewFrameIndex = m_SelectedFrameIndex;
             }
 
-            // 获取当前帧的纹理
-            AssetHandle handle = m_CurrentAnimation->GetFrame(m_PreviewFrameIndex);
+            // 获取当前帧的纹理和 UV
+            AssetHandle handle = 0;
+            glm::vec2 uvMin{0.0f, 0.0f};
+            glm::vec2 uvMax{1.0f, 1.0f};
+            if (m_CurrentAnimation->IsSpriteSheet())
+            {
+                const SpriteSheetFrame &frame = m_CurrentAnimation->GetSheetFrames()[m_PreviewFrameIndex];
+                handle = m_CurrentAnimation->GetSpriteSheet();
+                uvMin = frame.UVMin;
+                uvMax = frame.UVMax;
+            }
+            else
+            {
+                handle = m_CurrentAnimation->GetFrame(m_PreviewFrameIndex);
+            }
             Ref<Texture2D> texture = GetTextureFromHandle(handle);
 
             if (texture)
             {
                 // 计算保持比例的大小
+                glm::vec2 uvSize = uvMax - uvMin;
                 float regionWidth = ImGui::GetContentRegionAvail().x;
-                float aspect = (float)texture->GetWidth() / (float)texture->GetHeight();
+                float aspect = ((float)texture->GetWidth() * uvSize.x) / ((float)texture->GetHeight() * uvSize.y);
                 float displayHeight = regionWidth / aspect;
 
-                ImGui::Image((void *)(uint64_t)texture->GetRendererID(), {regionWidth, displayHeight}, {0, 1}, {1, 0});
+                // 纹理加载时做了垂直翻转，ImGui 需要上下颠倒的 UV
+                ImGui::Image((void *)(uint64_t)texture->GetRendererID(), {regionWidth, displayHeight},
+                             {uvMin.x, uvMax.y}, {uvMax.x, uvMin.y});
             }
             else
             {
@@ -147,13 +177,26 @@ namespace Himii
 
         if (m_CurrentAnimation)
         {
-            const auto &frames = m_CurrentAnimation->GetFrames();
+            const bool isSheet = m_CurrentAnimation->IsSpriteSheet();
+            Ref<Texture2D> sheet = isSheet ? GetTextureFromHandle(m_CurrentAnimation->GetSpriteSheet()) : nullptr;
 
             // 1. 渲染现有的帧
-            for (int i = 0; i < frames.size(); i++)
+            for (int i = 0; i < (int)m_CurrentAnimation->GetFrameCount(); i++)
             {
-                AssetHandle handle = frames[i];
-                Ref<Texture2D> texture = GetTextureFromHandle(handle);
+                Ref<Texture2D> texture;
+                ImVec2 uv0 = {0, 1};
+                ImVec2 uv1 = {1, 0};
+                if (isSheet)
+                {
+                    const SpriteSheetFrame &frame = m_CurrentAnimation->GetSheetFrames()[i];
+                    texture = sheet;
+                    uv0 = {frame.UVMin.x, frame.UVMax.y};
+                    uv1 = {frame.UVMax.x, frame.UVMin.y};
+                }
+                else
+                {
+                    texture = GetTextureFromHandle(m_CurrentAnimation->GetFrame(i));
+                }
 
                 ImGui::PushID(i);
 
@@ -170,7 +213,7 @@ namespace Himii
                 if (texture)
                 {
                     // 显示图片按钮
-                    if (ImGui::ImageButton("button",(uint64_t)texture->GetRendererID(), size, {0, 1}, {1, 0}))
+                    if (ImGui::ImageButton("button",(uint64_t)texture->GetRendererID(), size, uv0, uv1))
                         clicked = true;
                 }
                 else
@@ -200,6 +243,15 @@ namespace Himii
         // 2. 换行，防止最后的 Dummy 跟在最后一个图片后面
         ImGui::NewLine();
 
+        // 精灵表帧的时长单独编辑
+        if (m_CurrentAnimation && m_CurrentAnimation->IsSpriteSheet() && m_SelectedFrameIndex >= 0 &&
+            m_SelectedFrameIndex < (int)m_CurrentAnimation->GetFrameCount())
+        {
+            SpriteSheetFrame &frame = m_CurrentAnimation->GetSheetFrames()[m_SelectedFrameIndex];
+            ImGui::Text("Frame %d", m_SelectedFrameIndex);
+            ImGui::DragFloat("Duration (s)", &frame.Duration, 0.005f, 0.0f, 10.0f);
+        }
+
         // 3. 关键修复：创建一个填充剩余空间的 Dummy 控件
         // 这样即使列表是空的，或者图片很少，下方大片空白区域也能响应拖拽
         ImVec2 contentSize = ImGui::GetContentRegionAvail();
@@ -220,7 +272,11 @@ namespace Himii
 
                 std::string ext = assetPath.extension().string();
                 std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
-                if (ext == ".png" || ext == ".jpg" || ext == ".jpeg")
+                if (m_CurrentAnimation->IsSpriteSheet())
+                {
+                    HIMII_CORE_WARNING("Animation uses a sprite sheet, drop textures on the Sprite Sheet slot instead");
+                }
+                else if (ext == ".png" || ext == ".jpg" || ext == ".jpeg")
                 {
                     auto assetManager = Project::GetAssetManager();
                     if (assetManager)
@@ -245,6 +301,93 @@ namespace Himii
         ImGui::EndChild();
     }
 
+    void AnimationPanel::RenderSpriteSheetSettings()
+    {
+        if (!m_CurrentAnimation)
+            return;
+
+        if (!ImGui::CollapsingHeader("Sprite Sheet"))
+            return;
+
+        AssetHandle sheetHandle = m_CurrentAnimation->GetSpriteSheet();
+        Ref<Texture2D> sheet = GetTextureFromHandle(sheetHandle);
+
+        ImGui::Button(sheet ? "Sheet Texture" : "Drop Sheet Texture", ImVec2(140.0f, 0.0f));
+        if (ImGui::BeginDragDropTarget())
+        {
+            if (const ImGuiPayload *payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
+            {
+                std::filesystem::path assetPath = (const wchar_t *)payload->Data;
+                std::string ext = assetPath.extension().string();
+                std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+                auto assetManager = Project::GetAssetManager();
+                if (assetManager && (ext == ".png" || ext == ".jpg" || ext == ".jpeg"))
+                {
+                    AssetHandle handle = assetManager->ImportAsset(assetPath);
+                    if (handle != 0)
+                        m_CurrentAnimation->SetSpriteSheet(handle);
+                }
+            }
+            ImGui::EndDragDropTarget();
+        }
+
+        if (sheetHandle != 0)
+        {
+            ImGui::SameLine();
+            if (ImGui::Button("Remove"))
+            {
+                m_CurrentAnimation->SetSpriteSheet(0);
+                m_CurrentAnimation->ClearSheetFrames();
+                m_SelectedFrameIndex = -1;
+                m_PreviewFrameIndex = 0;
+            }
+        }
+
+        if (sheet)
+            ImGui::Text("%u x %u", sheet->GetWidth(), sheet->GetHeight());
+
+        ImGui::DragInt("Columns", &m_SliceColumns, 0.1f, 1, 256);
+        ImGui::DragInt("Rows", &m_SliceRows, 0.1f, 1, 256);
+        ImGui::DragInt("Frame Count", &m_SliceFrameCount, 0.1f, 0, m_SliceColumns * m_SliceRows);
+        ImGui::DragFloat("Frame Duration", &m_SliceFrameDuration, 0.005f, 0.0f, 10.0f);
+
+        if (!sheet)
+            ImGui::BeginDisabled();
+        if (ImGui::Button("Slice Grid"))
+            SliceSpriteSheet();
+        if (!sheet)
+            ImGui::EndDisabled();
+
+        ImGui::Separator();
+    }
+
+    void AnimationPanel::SliceSpriteSheet()
+    {
+        int columns = std::max(m_SliceColumns, 1);
+        int rows = std::max(m_SliceRows, 1);
+        int count = m_SliceFrameCount > 0 ? std::min(m_SliceFrameCount, columns * rows) : columns * rows;
+
+        m_CurrentAnimation->ClearSheetFrames();
+
+        // 纹理加载时做了垂直翻转，第 0 行（图片顶部）对应 v 最大的一端
+        glm::vec2 cellSize = {1.0f / (float)columns, 1.0f / (float)rows};
+        for (int i = 0; i < count; i++)
+        {
+            int column = i % columns;
+            int row = i / columns;
+
+            SpriteSheetFrame frame;
+            frame.UVMin = {column * cellSize.x, 1.0f - (row + 1) * cellSize.y};
+            frame.UVMax = {(column + 1) * cellSize.x, 1.0f - row * cellSize.y};
+            frame.Duration = m_SliceFrameDuration;
+            m_CurrentAnimation->AddSheetFrame(frame);
+        }
+
+        m_SelectedFrameIndex = -1;
+        m_PreviewFrameIndex = 0;
+        m_Timer = 0.0f;
+    }
+
     void AnimationPanel::CreateNewAnimation()
     {
         m_CurrentAnimation = std::make_shared<SpriteAnimation>();
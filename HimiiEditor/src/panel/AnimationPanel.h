@@ -22,6 +22,10 @@ namespace Himii
         void RenderMenuBar();
         void RenderPreview();
         void RenderTimeline();
+        void RenderSpriteSheetSettings();
+
+        // 把精灵表按网格切分为帧，从左上角开始逐行排列
+        void SliceSpriteSheet();
 
         void CreateNewAnimation();
         void SaveAnimationAs();
@@ -42,6 +46,12 @@ namespace Himii
 
         // UI 状态
         int m_SelectedFrameIndex = -1;
+
+        // 精灵表网格切分参数
+        int m_SliceColumns = 4;
+        int m_SliceRows = 1;
+        int m_SliceFrameCount = 0; // 0 表示取满整个网格
+        float m_SliceFrameDuration = 0.0f; // 0 表示使用组件的 FrameRate
     };
 
 } // namespace Himii
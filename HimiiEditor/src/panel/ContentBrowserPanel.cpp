@@ -118,7 +118,7 @@ namespace Himii
                     icon = m_DirectoryIcon;
                 else if (path.extension() == ".cs")
                     icon = m_ScriptIcon;
-                else if (path.extension() == ".himii")
+                else if (path.extension() == ".himii" || path.extension() == ".hscn")
                     icon = m_SceneIcon;
 
                 ImGui::PushID(fileNameString.c_str());
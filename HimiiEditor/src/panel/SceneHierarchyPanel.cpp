@@ -120,9 +120,11 @@ namespace Himii
         }
     }
 
-    static void DrawVec3Control(const std::string &label, glm::vec3 &values, float resetValue = 0.0f,
+    // 各控件返回值是否被修改（包括重置按钮），DrawComponent 据此触发 on_update
+    static bool DrawVec3Control(const std::string &label, glm::vec3 &values, float resetValue = 0.0f,
                                 float columnWidth = 100.0f)
     {
+        bool changed = false;
         ImGuiIO &io = ImGui::GetIO();
         auto boldFont = io.Fonts->Fonts[0];
 
@@ -152,13 +154,16 @@ namespace Himii
              ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.8f, 0.1f, 0.15f, 1.0f});
              ImGui::PushFont(boldFont);
              if (ImGui::Button("X", buttonSize))
+             {
                  values.x = resetValue;
+                 changed = true;
+             }
              ImGui::PopFont();
              ImGui::PopStyleColor(3);
 
              ImGui::SameLine();
              ImGui::SetNextItemWidth(widthEach);
-             ImGui::DragFloat("##X", &values.x, 0.1f, 0.0f, 0.0f, "%.2f");
+             changed |= ImGui::DragFloat("##X", &values.x, 0.1f, 0.0f, 0.0f, "%.2f");
              ImGui::SameLine();
 
              // Y
@@ -167,13 +172,16 @@ namespace Himii
              ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.2f, 0.7f, 0.2f, 1.0f});
              ImGui::PushFont(boldFont);
              if (ImGui::Button("Y", buttonSize))
+             {
                  values.y = resetValue;
+                 changed = true;
+             }
              ImGui::PopFont();
              ImGui::PopStyleColor(3);
 
              ImGui::SameLine();
              ImGui::SetNextItemWidth(widthEach);
-             ImGui::DragFloat("##Y", &values.y, 0.1f, 0.0f, 0.0f, "%.2f");
+             changed |= ImGui::DragFloat("##Y", &values.y, 0.1f, 0.0f, 0.0f, "%.2f");
              ImGui::SameLine();
 
              // Z
@@ -182,13 +190,16 @@ namespace Himii
              ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.1f, 0.25f, 0.8f, 1.0f});
              ImGui::PushFont(boldFont);
              if (ImGui::Button("Z", buttonSize))
+             {
                  values.z = resetValue;
+                 changed = true;
+             }
              ImGui::PopFont();
              ImGui::PopStyleColor(3);
 
              ImGui::SameLine();
              ImGui::SetNextItemWidth(widthEach);
-             ImGui::DragFloat("##Z", &values.z, 0.1f, 0.0f, 0.0f, "%.2f");
+             changed |= ImGui::DragFloat("##Z", &values.z, 0.1f, 0.0f, 0.0f, "%.2f");
 
              ImGui::PopStyleVar();
 
@@ -196,10 +207,12 @@ namespace Himii
         }
 
         ImGui::PopID();
+        return changed;
     }
 
-    static void DrawFloatControl(const std::string& label, float& value, float speed = 0.1f, float min = 0.0f, float max = 0.0f, float columnWidth = 100.0f)
+    static bool DrawFloatControl(const std::string& label, float& value, float speed = 0.1f, float min = 0.0f, float max = 0.0f, float columnWidth = 100.0f)
     {
+        bool changed = false;
         ImGui::PushID(label.c_str());
         if(ImGui::BeginTable("##FloatControl", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
         {
@@ -209,15 +222,17 @@ namespace Himii
             ImGui::Text("%s", label.c_str());
             ImGui::TableNextColumn();
             ImGui::PushItemWidth(-1);
-            ImGui::DragFloat("##Value", &value, speed, min, max);
+            changed = ImGui::DragFloat("##Value", &value, speed, min, max);
             ImGui::PopItemWidth();
             ImGui::EndTable();
         }
         ImGui::PopID();
+        return changed;
     }
 
-    static void DrawCheckboxControl(const std::string& label, bool& value, float columnWidth = 100.0f)
+    static bool DrawCheckboxControl(const std::string& label, bool& value, float columnWidth = 100.0f)
     {
+        bool changed = false;
         ImGui::PushID(label.c_str());
         if(ImGui::BeginTable("##CheckboxControl", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
         {
@@ -226,14 +241,75 @@ namespace Himii
             ImGui::TableNextColumn();
             ImGui::Text("%s", label.c_str());
             ImGui::TableNextColumn();
-            ImGui::Checkbox("##Value", &value);
+            changed = ImGui::Checkbox("##Value", &value);
             ImGui::EndTable();
         }
         ImGui::PopID();
+        return changed;
     }
 
-    static void DrawColorControl(const std::string& label, glm::vec4& value, float columnWidth = 100.0f)
+    static std::string GetLayerName(uint32_t index)
     {
+        if (Project::GetActive() && !Project::GetConfig().Physics2DLayers.Names[index].empty())
+            return Project::GetConfig().Physics2DLayers.Names[index];
+        return "Layer " + std::to_string(index);
+    }
+
+    // 碰撞层位掩码，列出已命名的层和已选中的层
+    static bool DrawLayerMaskControl(const std::string &label, uint32_t &bits)
+    {
+        bool changed = false;
+        ImGui::PushID(label.c_str());
+        if (ImGui::BeginTable("##LayerMaskControl", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
+        {
+            ImGui::TableSetupColumn("Label", ImGuiTableColumnFlags_WidthFixed, 140.0f);
+            ImGui::TableSetupColumn("Value");
+            ImGui::TableNextColumn();
+            ImGui::Text("%s", label.c_str());
+            ImGui::TableNextColumn();
+            ImGui::PushItemWidth(-1);
+
+            std::string preview;
+            if (bits == 0)
+                preview = "Nothing";
+            else if (bits == 0xFFFFFFFFu)
+                preview = "Everything";
+            else
+            {
+                for (uint32_t i = 0; i < Physics2DLayerMatrix::MaxLayers; ++i)
+                {
+                    if (bits & (1u << i))
+                        preview += (preview.empty() ? "" : ", ") + GetLayerName(i);
+                }
+            }
+
+            if (ImGui::BeginCombo("##Value", preview.c_str()))
+            {
+                for (uint32_t i = 0; i < Physics2DLayerMatrix::MaxLayers; ++i)
+                {
+                    bool named = Project::GetActive() && !Project::GetConfig().Physics2DLayers.Names[i].empty();
+                    bool set = (bits & (1u << i)) != 0;
+                    if (!named && !set)
+                        continue;
+
+                    if (ImGui::Checkbox(GetLayerName(i).c_str(), &set))
+                    {
+                        bits = set ? (bits | (1u << i)) : (bits & ~(1u << i));
+                        changed = true;
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            ImGui::PopItemWidth();
+            ImGui::EndTable();
+        }
+        ImGui::PopID();
+        return changed;
+    }
+
+    static bool DrawColorControl(const std::string& label, glm::vec4& value, float columnWidth = 100.0f)
+    {
+        bool changed = false;
         ImGui::PushID(label.c_str());
         if(ImGui::BeginTable("##ColorControl", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
         {
@@ -243,11 +319,12 @@ namespace Himii
             ImGui::Text("%s", label.c_str());
             ImGui::TableNextColumn();
             ImGui::PushItemWidth(-1);
-            ImGui::ColorEdit4("##Value", glm::value_ptr(value));
+            changed = ImGui::ColorEdit4("##Value", glm::value_ptr(value));
             ImGui::PopItemWidth();
             ImGui::EndTable();
         }
         ImGui::PopID();
+        return changed;
     }
 
     template<typename T, typename UIFunction>
@@ -346,7 +423,9 @@ namespace Himii
 
             if (open)
             {
-                uiFunction(component);
+                // uiFunction 返回属性是否被修改（含重置按钮和拖放赋值），修改后触发 on_update，供增量保存追踪脏实体
+                if (uiFunction(component))
+                    entity.PatchComponent<T>();
             }
 
             if (removeComponent)
@@ -367,6 +446,7 @@ namespace Himii
             if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
             {
                 tag = std::string(buffer);
+                entity.PatchComponent<TagComponent>();
             }
         }
         ImGui::SameLine();
@@ -391,25 +471,31 @@ namespace Himii
         DrawComponent<TransformComponent>("Transform", entity, m_ComponentIcons["Transform"],
                                           [](auto &component)
                                           {
-                                              DrawVec3Control("Position", component.Position);
+                                              bool changed = DrawVec3Control("Position", component.Position);
                                               glm::vec3 rotation = glm::degrees(component.Rotation);
-                                              DrawVec3Control("Rotation", rotation);
-                                              component.Rotation = glm::radians(rotation);
-                                              DrawVec3Control("Scale", component.Scale, 1.0f);
+                                              if (DrawVec3Control("Rotation", rotation))
+                                              {
+                                                  component.Rotation = glm::radians(rotation);
+                                                  changed = true;
+                                              }
+                                              changed |= DrawVec3Control("Scale", component.Scale, 1.0f);
+                                              return changed;
                                           });
 
         DrawComponent<CameraComponent>("Camera", entity, m_ComponentIcons["Camera"],
                                        [](auto &component)
                                        {
+                                           bool changed = false;
                                            auto &camera = component.Camera;
                                            
                                            glm::vec4 backgroundColor = camera.GetBackgroundColor();
                                            if (ImGui::ColorEdit4("Background Color", glm::value_ptr(backgroundColor)))
                                            {
                                                camera.SetBackgroundColor(backgroundColor);
+                                               changed = true;
                                            }
 
-                                           DrawCheckboxControl("Primary", component.Primary);
+                                           changed |= DrawCheckboxControl("Primary", component.Primary);
 
                                            const char *projectionTypeStrings[] = {"Perspective", "Orthographic"};
                                            const char *currentProjectionTypeString =
@@ -434,6 +520,7 @@ namespace Himii
                                                         {
                                                             currentProjectionTypeString = projectionTypeStrings[i];
                                                             camera.SetProjectionType((SceneCamera::ProjectionType)i);
+                                                            changed = true;
                                                         }
                                                         if (isSelected)
                                                             ImGui::SetItemDefaultFocus();
@@ -448,34 +535,52 @@ namespace Himii
                                            if (camera.GetProjectionType() == SceneCamera::ProjectionType::Perspective)
                                            {
                                                float perspectiveFOV = glm::degrees(camera.GetPerspectiveVerticalFOV());
-                                               DrawFloatControl("Vertical FOV", perspectiveFOV);
-                                               if (perspectiveFOV != glm::degrees(camera.GetPerspectiveVerticalFOV()))
+                                               if (DrawFloatControl("Vertical FOV", perspectiveFOV))
+                                               {
                                                    camera.SetPerspectiveVerticalFOV(glm::radians(perspectiveFOV));
+                                                   changed = true;
+                                               }
 
                                                float perspectiveNear = camera.GetPerspectiveNearClip();
-                                               DrawFloatControl("Near", perspectiveNear);
-                                               camera.SetPerspectiveNearClip(perspectiveNear);
+                                               if (DrawFloatControl("Near", perspectiveNear))
+                                               {
+                                                   camera.SetPerspectiveNearClip(perspectiveNear);
+                                                   changed = true;
+                                               }
 
                                                float perspectiveFar = camera.GetPerspectiveFarClip();
-                                               DrawFloatControl("Far", perspectiveFar);
-                                               camera.SetPerspectiveFarClip(perspectiveFar);
+                                               if (DrawFloatControl("Far", perspectiveFar))
+                                               {
+                                                   camera.SetPerspectiveFarClip(perspectiveFar);
+                                                   changed = true;
+                                               }
                                            }
                                            if (camera.GetProjectionType() == SceneCamera::ProjectionType::Orthographic)
                                            {
                                                float orthographicSize = camera.GetOrthographicSize();
-                                               DrawFloatControl("Size", orthographicSize);
-                                               camera.SetOrthographicSize(orthographicSize);
+                                               if (DrawFloatControl("Size", orthographicSize))
+                                               {
+                                                   camera.SetOrthographicSize(orthographicSize);
+                                                   changed = true;
+                                               }
 
                                                float orthographicNear = camera.GetOrthographicNearClip();
-                                               DrawFloatControl("Near", orthographicNear);
-                                               camera.SetOrthographicNearClip(orthographicNear);
+                                               if (DrawFloatControl("Near", orthographicNear))
+                                               {
+                                                   camera.SetOrthographicNearClip(orthographicNear);
+                                                   changed = true;
+                                               }
 
                                                float orthographicFar = camera.GetOrthographicFarClip();
-                                               DrawFloatControl("Far", orthographicFar);
-                                               camera.SetOrthographicFarClip(orthographicFar);
+                                               if (DrawFloatControl("Far", orthographicFar))
+                                               {
+                                                   camera.SetOrthographicFarClip(orthographicFar);
+                                                   changed = true;
+                                               }
 
-                                               DrawCheckboxControl("Fixed Aspect Ratio", component.FixedAspectRatio);
+                                               changed |= DrawCheckboxControl("Fixed Aspect Ratio", component.FixedAspectRatio);
                                            }
+                                           return changed;
                                        });
 
         #include <cstdlib> // for system()
@@ -486,15 +591,14 @@ namespace Himii
                 "Script", entity, m_ComponentIcons["Script"],
                 [entity, scene = m_Context](auto &component) mutable
                 {
+                    bool changed = false;
                     bool scriptClassExists = ScriptEngine::EntityClassExists(component.ClassName);
 
                     ImGui::Text("Class Name");
                     ImGui::SameLine();
 
                     if (ImGui::InputText("##ClassName", &component.ClassName))
-                    {
-                        // 输入修改逻辑
-                    }
+                        changed = true;
 
                     if (!scriptClassExists)
                     {
@@ -527,13 +631,14 @@ namespace Himii
                             }
                         }
                     }
+                    return changed;
                 });
 
         DrawComponent<SpriteRendererComponent>(
                 "Sprite Renderer", entity, m_ComponentIcons["Sprite Renderer"],
                 [](auto &component)
                 {
-                    DrawColorControl("Color", component.Color);
+                    bool changed = DrawColorControl("Color", component.Color);
                     // Texture
                     ImGui::PushID("Texture");
                     if(ImGui::BeginTable("##Texture", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit))
@@ -553,10 +658,25 @@ namespace Himii
                                 const wchar_t *path = (const wchar_t *)payload->Data;
                                 std::filesystem::path texturePath = Project::GetAssetDirectory() / path;
 
-                                if (std::filesystem::exists(texturePath))
-                                    component.Texture = Texture2D::Create(texturePath.string());
-                                else
+                                // 经过 AssetManager 导入，已加载的纹理直接共享
+                                auto assetManager = Project::GetAssetManager();
+                                if (!std::filesystem::exists(texturePath))
                                     HIMII_CORE_WARNING("Texture not found: {0}", texturePath.string());
+                                else if (assetManager)
+                                {
+                                    AssetHandle handle = assetManager->ImportAsset(path);
+                                    Ref<Texture2D> texture;
+                                    if (assetManager->GetMetadata(handle).Type == AssetType::Texture2D)
+                                        texture = assetManager->GetAsset<Texture2D>(handle);
+                                    if (texture)
+                                    {
+                                        component.Texture = texture;
+                                        component.TextureHandle = handle;
+                                        changed = true;
+                                    }
+                                    else
+                                        HIMII_CORE_WARNING("Failed to import texture: {0}", texturePath.string());
+                                }
                             }
 
                             ImGui::EndDragDropTarget();
@@ -565,20 +685,23 @@ namespace Himii
                     }
                     ImGui::PopID();
 
-                    DrawFloatControl("Tiling Factor", component.TilingFactor, 0.1f, 0.0f, 100.0f);
+                    changed |= DrawFloatControl("Tiling Factor", component.TilingFactor, 0.1f, 0.0f, 100.0f);
+                    return changed;
                 });
 
         DrawComponent<CircleRendererComponent>("Circle Renderer", entity, m_ComponentIcons["Circle Renderer"],
                                                [](auto &component)
                                                {
-                                                   DrawColorControl("Color", component.Color);
-                                                   DrawFloatControl("Thickness", component.Thickness, 0.025f, 0.0f, 1.0f);
-                                                   DrawFloatControl("Fade", component.Fade, 0.0003f, 0.0f, 1.0f);
+                                                   bool changed = DrawColorControl("Color", component.Color);
+                                                   changed |= DrawFloatControl("Thickness", component.Thickness, 0.025f, 0.0f, 1.0f);
+                                                   changed |= DrawFloatControl("Fade", component.Fade, 0.0003f, 0.0f, 1.0f);
+                                                   return changed;
                                                });
 
         DrawComponent<Rigidbody2DComponent>("Rigidbody2D", entity, m_ComponentIcons["Rigidbody2D"],
                                             [](auto &component)
                                             {
+                                                bool changed = false;
                                                 ImGui::PushID("Body Type");
                                                 if(ImGui::BeginTable("##BodyType", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingFixedFit))
                                                 {
@@ -600,6 +723,7 @@ namespace Himii
                                                             {
                                                                 currentBodyTypeString = bodyTypeStrings[i];
                                                                 component.Type = (Rigidbody2DComponent::BodyType)i;
+                                                                changed = true;
                                                             }
                                                             if (isSelected) ImGui::SetItemDefaultFocus();
                                                         }
@@ -610,13 +734,15 @@ namespace Himii
                                                 }
                                                 ImGui::PopID();
 
-                                                DrawCheckboxControl("Fixed Rotation", component.FixedRotation);
+                                                changed |= DrawCheckboxControl("Fixed Rotation", component.FixedRotation);
+                                                return changed;
                                             });
 
         DrawComponent<BoxCollider2DComponent>(
                 "Box Collider2D", entity, m_ComponentIcons["Box Collider2D"],
                 [](auto &component)
                 {
+                    bool changed = false;
                     // For vec2, we can just use DrawFloatControl twice or keep usage? 
                     // Let's implement vec2 logic or simpler:
                     ImGui::PushID("Offset");
@@ -628,7 +754,7 @@ namespace Himii
                         ImGui::Text("Offset");
                         ImGui::TableNextColumn();
                         ImGui::PushItemWidth(-1);
-                        ImGui::DragFloat2("##Offset", glm::value_ptr(component.Offset), 0.1f);
+                        changed |= ImGui::DragFloat2("##Offset", glm::value_ptr(component.Offset), 0.1f);
                         ImGui::PopItemWidth();
                         ImGui::EndTable();
                     }
@@ -643,21 +769,26 @@ namespace Himii
                         ImGui::Text("Size");
                         ImGui::TableNextColumn();
                         ImGui::PushItemWidth(-1);
-                        ImGui::DragFloat2("##Size", glm::value_ptr(component.Size), 0.1f);
+                        changed |= ImGui::DragFloat2("##Size", glm::value_ptr(component.Size), 0.1f);
                         ImGui::PopItemWidth();
                         ImGui::EndTable();
                     }
                     ImGui::PopID();
                     
-                    DrawFloatControl("Density", component.Density, 0.1f);
-                    DrawFloatControl("Friction", component.Friction, 0.01f, 0.0f, 1.0f);
-                    DrawFloatControl("Restitution", component.Restitution, 0.01f, 0.0f, 1.0f);
-                    DrawFloatControl("Restitution Threshold", component.RestitutionThreshold, 0.1f);
+                    changed |= DrawFloatControl("Density", component.Density, 0.1f);
+                    changed |= DrawFloatControl("Friction", component.Friction, 0.01f, 0.0f, 1.0f);
+                    changed |= DrawFloatControl("Restitution", component.Restitution, 0.01f, 0.0f, 1.0f);
+                    changed |= DrawFloatControl("Restitution Threshold", component.RestitutionThreshold, 0.1f);
+                    changed |= DrawCheckboxControl("Is Sensor", component.IsSensor);
+                    changed |= DrawLayerMaskControl("Category", component.CategoryBits);
+                    changed |= DrawLayerMaskControl("Collides With", component.MaskBits);
+                    return changed;
                 });
         DrawComponent<CircleCollider2DComponent>(
                 "Circle Collider2D", entity, m_ComponentIcons["Circle Collider2D"],
                 [](auto &component)
                 {
+                    bool changed = false;
                     ImGui::PushID("Offset");
                     if(ImGui::BeginTable("##Offset", 2, ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp))
                     {
@@ -667,22 +798,27 @@ namespace Himii
                         ImGui::Text("Offset");
                         ImGui::TableNextColumn();
                         ImGui::PushItemWidth(-1);
-                        ImGui::DragFloat2("##Offset", glm::value_ptr(component.Offset), 0.1f);
+                        changed |= ImGui::DragFloat2("##Offset", glm::value_ptr(component.Offset), 0.1f);
                         ImGui::PopItemWidth();
                         ImGui::EndTable();
                     }
                     ImGui::PopID();
                     
-                    DrawFloatControl("Radius", component.Radius, 0.1f);
-                    DrawFloatControl("Density", component.Density, 0.1f);
-                    DrawFloatControl("Friction", component.Friction, 0.01f, 0.0f, 1.0f);
-                    DrawFloatControl("Restitution", component.Restitution, 0.01f, 0.0f, 1.0f);
-                    DrawFloatControl("Restitution Threshold", component.RestitutionThreshold, 0.1f);
+                    changed |= DrawFloatControl("Radius", component.Radius, 0.1f);
+                    changed |= DrawFloatControl("Density", component.Density, 0.1f);
+                    changed |= DrawFloatControl("Friction", component.Friction, 0.01f, 0.0f, 1.0f);
+                    changed |= DrawFloatControl("Restitution", component.Restitution, 0.01f, 0.0f, 1.0f);
+                    changed |= DrawFloatControl("Restitution Threshold", component.RestitutionThreshold, 0.1f);
+                    changed |= DrawCheckboxControl("Is Sensor", component.IsSensor);
+                    changed |= DrawLayerMaskControl("Category", component.CategoryBits);
+                    changed |= DrawLayerMaskControl("Collides With", component.MaskBits);
+                    return changed;
                 });
         DrawComponent<SpriteAnimationComponent>(
                 "Sprite Animation", entity, m_ComponentIcons["Sprite Animation"],
                 [](auto &component)
                 {
+                    bool changed = false;
                     ImGui::Text("Asset Handle: %llu", (uint64_t)component.AnimationHandle);
 
                     ImGui::Button("Animation Asset", ImVec2(100.0f, 0.0f));
@@ -701,17 +837,21 @@ namespace Himii
                                 {
                                     AssetHandle handle = assetManager->ImportAsset(assetPath);
                                     if (handle != 0)
+                                    {
                                         component.AnimationHandle = handle;
+                                        changed = true;
+                                    }
                                 }
                             }
                         }
                         ImGui::EndDragDropTarget();
                     }
 
-                    ImGui::DragFloat("Frame Rate", &component.FrameRate, 0.1f, 0.0f, 60.0f);
-                    ImGui::Checkbox("Playing", &component.Playing);
+                    changed |= ImGui::DragFloat("Frame Rate", &component.FrameRate, 0.1f, 0.0f, 60.0f);
+                    changed |= ImGui::Checkbox("Playing", &component.Playing);
                     ImGui::Text("Current Frame: %d", component.CurrentFrame);
                     ImGui::Text("Timer: %.2f", component.Timer);
+                    return changed;
                 });
     }
 
@@ -1,3 +1,5 @@
+#pragma variant NO_ENTITY_ID
+
 #type vertex
 #version 450 core
 layout(location = 0) in vec3 a_WorldPosition;
@@ -5,7 +7,9 @@ layout(location = 1) in vec3 a_LocalPosition;
 layout(location = 2) in vec4 a_Color;
 layout(location = 3) in float a_Thickness;
 layout(location = 4) in float a_Fade;
+#ifndef NO_ENTITY_ID
 layout(location = 5) in int a_EntityID;
+#endif
 
 layout(std140,binding=0) uniform Camera
 {
@@ -21,7 +25,9 @@ struct VertexOutput
 };
 
 layout (location = 0) out VertexOutput Output;
+#ifndef NO_ENTITY_ID
 layout (location = 4) out flat int v_EntityID;
+#endif
 
 void main()
 {
@@ -30,7 +36,9 @@ void main()
 	Output.Thickness = a_Thickness;
 	Output.Fade = a_Fade;
 
+#ifndef NO_ENTITY_ID
     v_EntityID = a_EntityID;
+#endif
     gl_Position = u_ViewProjection * vec4(a_WorldPosition, 1.0);
 }
 
@@ -38,7 +46,9 @@ void main()
 #version 450 core
 
 layout(location=0) out vec4 o_Color;
+#ifndef NO_ENTITY_ID
 layout(location=1) out int o_EntityID;
+#endif
 
 struct VertexOutput
 {
@@ -49,7 +59,9 @@ struct VertexOutput
 };
 
 layout (location = 0) in VertexOutput Input;
+#ifndef NO_ENTITY_ID
 layout (location = 4) in flat int v_EntityID;
+#endif
 
 void main()
 {
@@ -63,5 +75,7 @@ void main()
     o_Color = Input.Color;
 	o_Color.a *= circle;
 
+#ifndef NO_ENTITY_ID
 	o_EntityID = v_EntityID;
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,93 @@
+#pragma variant NO_ENTITY_ID
+
+// 无限网格：全屏三角形，逐片元把屏幕坐标反投影成视线，与 z = 0 平面求交后计算网格线覆盖率
+
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec2 a_Position;
+
+layout (location = 0) out vec2 v_ScreenPosition;
+
+void main()
+{
+	v_ScreenPosition = a_Position;
+	gl_Position = vec4(a_Position, 0.0, 1.0);
+}
+
+#type fragment
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+#ifndef NO_ENTITY_ID
+layout(location = 1) out int o_EntityID;
+#endif
+
+layout (location = 0) in vec2 v_ScreenPosition;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+};
+
+layout(std140, binding = 2) uniform Grid
+{
+	mat4 u_InverseViewProjection;
+	vec4 u_Color;
+	vec4 u_MajorColor;
+	float u_Spacing;
+	float u_MajorInterval;
+};
+
+vec3 Unproject(vec2 position, float depth)
+{
+	vec4 world = u_InverseViewProjection * vec4(position, depth, 1.0);
+	return world.xyz / world.w;
+}
+
+// 到最近网格线的距离除以每像素的坐标变化量，得到以像素计的距离，线宽约 1 像素
+float LineCoverage(vec2 coord, vec2 derivative)
+{
+	vec2 lineDistance = abs(fract(coord - 0.5) - 0.5) / derivative;
+	return 1.0 - min(min(lineDistance.x, lineDistance.y), 1.0);
+}
+
+void main()
+{
+	vec3 nearPoint = Unproject(v_ScreenPosition, -1.0);
+	vec3 farPoint = Unproject(v_ScreenPosition, 1.0);
+
+	// 视线与平面平行，或交点不在近远平面之间时覆盖率为 0；不能提前 discard，
+	// 否则后面的 fwidth 处在非一致的控制流里，结果未定义
+	float dz = farPoint.z - nearPoint.z;
+	bool parallel = abs(dz) < 1e-6;
+	float t = -nearPoint.z / (parallel ? 1e-6 : dz);
+	float valid = (parallel || t < 0.0 || t > 1.0) ? 0.0 : 1.0;
+
+	vec3 worldPosition = mix(nearPoint, farPoint, t);
+	vec2 coord = worldPosition.xy / u_Spacing;
+	vec2 derivative = max(fwidth(coord), vec2(1e-6));
+
+	// 间距小于几个像素时淡出，避免摩尔纹
+	float minorFade = 1.0 - smoothstep(0.15, 0.4, max(derivative.x, derivative.y));
+	float majorFade = 1.0 - smoothstep(0.15, 0.4, max(derivative.x, derivative.y) / u_MajorInterval);
+
+	float minor = LineCoverage(coord, derivative) * minorFade;
+	float major = LineCoverage(coord / u_MajorInterval, derivative / u_MajorInterval) * majorFade;
+
+	vec4 color = vec4(u_Color.rgb, u_Color.a * minor);
+	color = mix(color, u_MajorColor, major);
+	color.a *= valid;
+	// 导数都已求完，这里丢弃不影响相邻片元
+	if (color.a < 0.01)
+		discard;
+
+	// 写入交点的真实深度，场景中的物体照常遮挡网格
+	vec4 clip = u_ViewProjection * vec4(worldPosition, 1.0);
+	gl_FragDepth = clip.z / clip.w * 0.5 + 0.5;
+
+	o_Color = color;
+#ifndef NO_ENTITY_ID
+	o_EntityID = -1;
+#endif
+}
@@ -1,47 +1,103 @@
+#pragma variant NO_ENTITY_ID
+
+// 缓存折线（LineGeometry）的屏幕空间展开：每段线是 4 个顶点的四边形，顶点带着本端点、同一段的另一端点
+// 和相邻线段在本端点另一侧的点，投影到屏幕后沿法线（连接处为斜接方向）偏移半个线宽，线宽以像素计
+
 #type vertex
 #version 450 core
 
 layout(location = 0) in vec3 a_Position;
-layout(location = 1) in vec4 a_Color;
-layout(location = 2) in int a_EntityID;
+layout(location = 1) in vec3 a_OtherPosition;
+layout(location = 2) in vec3 a_NeighborPosition; // 没有相邻线段时等于 a_Position
+layout(location = 3) in vec4 a_Color;
+layout(location = 4) in vec2 a_Corner;           // x：0 = 段起点，1 = 段终点；y：±1 表示在法线哪一侧
+layout(location = 5) in float a_Width;           // <= 0 时使用 u_LineWidth
 
 layout(std140, binding = 0) uniform Camera
 {
 	mat4 u_ViewProjection;
+	vec2 u_ViewportSize;
+	float u_LineWidth;
 };
 
-struct VertexOutput
+layout (location = 0) out vec4 v_Color;
+
+vec2 ToPixel(vec4 clip)
 {
-	vec4 Color;
-};
+	return clip.xy / clip.w * 0.5 * u_ViewportSize;
+}
 
-layout (location = 0) out VertexOutput Output;
-layout (location = 1) out flat int v_EntityID;
+vec2 Perpendicular(vec2 direction)
+{
+	return vec2(-direction.y, direction.x);
+}
 
 void main()
 {
-	Output.Color = a_Color;
-	v_EntityID = a_EntityID;
+	v_Color = a_Color;
+
+	vec4 clip = u_ViewProjection * vec4(a_Position, 1.0);
+	vec4 otherClip = u_ViewProjection * vec4(a_OtherPosition, 1.0);
 
-	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+	// 有端点在相机后面时整段放到裁剪空间之外
+	if (clip.w <= 0.0 || otherClip.w <= 0.0)
+	{
+		gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+		return;
+	}
+
+	// 起点和终点都按折线前进的方向取法线，两侧才一致
+	bool isStart = a_Corner.x < 0.5;
+	vec2 pixel = ToPixel(clip);
+	vec2 direction = isStart ? ToPixel(otherClip) - pixel : pixel - ToPixel(otherClip);
+	if (dot(direction, direction) < 1e-8)
+	{
+		// 退化（长度为 0）的段不展开
+		gl_Position = clip;
+		return;
+	}
+	vec2 normal = normalize(Perpendicular(direction));
+
+	float halfWidth = 0.5 * (a_Width > 0.0 ? a_Width : u_LineWidth);
+	vec2 offset = normal * halfWidth;
+
+	// 连接处取两段法线的角平分方向（斜接），相邻两段在同一点算出的偏移相同；尖角时截断到一个线宽
+	vec4 neighborClip = u_ViewProjection * vec4(a_NeighborPosition, 1.0);
+	if (a_NeighborPosition != a_Position && neighborClip.w > 0.0)
+	{
+		vec2 neighborPixel = ToPixel(neighborClip);
+		vec2 neighborDirection = isStart ? pixel - neighborPixel : neighborPixel - pixel;
+		if (dot(neighborDirection, neighborDirection) >= 1e-8)
+		{
+			vec2 sum = normal + normalize(Perpendicular(neighborDirection));
+			float sumLength = length(sum);
+			if (sumLength >= 1e-3) // 原路折返时保持法线偏移
+			{
+				vec2 miter = sum / sumLength;
+				float miterLength = halfWidth / max(dot(miter, normal), 1e-3);
+				offset = miter * min(miterLength, 2.0 * halfWidth);
+			}
+		}
+	}
+
+	clip.xy += offset * a_Corner.y * 2.0 / u_ViewportSize * clip.w;
+	gl_Position = clip;
 }
 
 #type fragment
 #version 450 core
 
 layout(location = 0) out vec4 o_Color;
+#ifndef NO_ENTITY_ID
 layout(location = 1) out int o_EntityID;
+#endif
 
-struct VertexOutput
-{
-	vec4 Color;
-};
-
-layout (location = 0) in VertexOutput Input;
-layout (location = 1) in flat int v_EntityID;
+layout (location = 0) in vec4 v_Color;
 
 void main()
 {
-	o_Color = Input.Color;
-	o_EntityID = v_EntityID;
-}
\ No newline at end of file
+	o_Color = v_Color;
+#ifndef NO_ENTITY_ID
+	o_EntityID = -1;
+#endif
+}
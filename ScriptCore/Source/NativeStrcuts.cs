@@ -33,4 +33,26 @@ namespace Himii
         public IntPtr Rigidbody2D_GetLinearVelocity;
         public IntPtr Rigidbody2D_SetLinearVelocity;
     }
+
+    // 与 C++ 端 Himii::ContactEvent2D 内存布局一致
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NativeContactEvent2D
+    {
+        public ulong EntityA;
+        public ulong EntityB;
+        public uint IsSensor;
+        public uint Padding;
+    }
+
+    // 与 C++ 端 Himii::ContactHitEvent2D 内存布局一致
+    [StructLayout(LayoutKind.Sequential)]
+    public struct NativeContactHitEvent2D
+    {
+        public ulong EntityA;
+        public ulong EntityB;
+        public Vector2 Point;
+        public Vector2 Normal;
+        public float ApproachSpeed;
+        public float Padding;
+    }
 }
\ No newline at end of file
@@ -85,5 +85,10 @@ namespace Himii
 
         public virtual void OnCreate() { }
         public virtual void OnUpdate(float ts) { }
+
+        // 物理事件，每帧物理步之后批量派发
+        public virtual void OnCollisionBegin(Collision2D collision) { }
+        public virtual void OnCollisionEnd(Collision2D collision) { }
+        public virtual void OnCollisionHit(CollisionHit2D hit) { }
     }
 }
\ No newline at end of file
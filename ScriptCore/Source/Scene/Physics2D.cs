@@ -0,0 +1,91 @@
+using System;
+using System.Collections.Generic;
+
+namespace Himii
+{
+    public readonly struct Collision2D
+    {
+        // 碰撞的另一方
+        public Entity Other { get; }
+        // 任意一方是传感器时为 true，此时不会有碰撞响应
+        public bool IsSensor { get; }
+
+        internal Collision2D(Entity other, bool isSensor)
+        {
+            Other = other;
+            IsSensor = isSensor;
+        }
+    }
+
+    public readonly struct CollisionHit2D
+    {
+        public Entity Other { get; }
+        public Vector2 Point { get; }
+        public Vector2 Normal { get; }
+        public float ApproachSpeed { get; }
+
+        internal CollisionHit2D(Entity other, Vector2 point, Vector2 normal, float approachSpeed)
+        {
+            Other = other;
+            Point = point;
+            Normal = normal;
+            ApproachSpeed = approachSpeed;
+        }
+    }
+
+    public delegate void CollisionHandler(Collision2D collision);
+    public delegate void CollisionHitHandler(CollisionHit2D hit);
+
+    // 按实体订阅碰撞事件，被订阅的实体不需要挂载脚本
+    public static class Physics2D
+    {
+        internal class Subscription
+        {
+            public CollisionHandler? Begin;
+            public CollisionHandler? End;
+            public CollisionHitHandler? Hit;
+        }
+
+        private static readonly Dictionary<ulong, Subscription> _subscriptions = new Dictionary<ulong, Subscription>();
+
+        public static void OnCollisionBegin(Entity entity, CollisionHandler handler)
+        {
+            GetOrCreate(entity.ID).Begin += handler;
+        }
+
+        public static void OnCollisionEnd(Entity entity, CollisionHandler handler)
+        {
+            GetOrCreate(entity.ID).End += handler;
+        }
+
+        public static void OnCollisionHit(Entity entity, CollisionHitHandler handler)
+        {
+            GetOrCreate(entity.ID).Hit += handler;
+        }
+
+        public static void Unsubscribe(Entity entity)
+        {
+            _subscriptions.Remove(entity.ID);
+        }
+
+        internal static Subscription? GetSubscription(ulong entityID)
+        {
+            return _subscriptions.TryGetValue(entityID, out var subscription) ? subscription : null;
+        }
+
+        internal static void Clear()
+        {
+            _subscriptions.Clear();
+        }
+
+        private static Subscription GetOrCreate(ulong entityID)
+        {
+            if (!_subscriptions.TryGetValue(entityID, out var subscription))
+            {
+                subscription = new Subscription();
+                _subscriptions[entityID] = subscription;
+            }
+            return subscription;
+        }
+    }
+}
@@ -83,6 +83,7 @@ namespace Himii
         {
             _entityClasses.Clear();
             _instances.Clear();
+            Physics2D.Clear();
 
             foreach (var type in assembly.GetTypes())
             {
@@ -128,6 +129,14 @@ namespace Himii
             }
         }
 
+        // 运行结束：丢弃本次运行的脚本实例和碰撞订阅，避免下一次运行时对旧场景的实体触发回调
+        [UnmanagedCallersOnly]
+        public static void OnRuntimeStop()
+        {
+            _instances.Clear();
+            Physics2D.Clear();
+        }
+
         [UnmanagedCallersOnly]
         public static void OnUpdateEntity(ulong entityID, float ts)
         {
@@ -136,5 +145,77 @@ namespace Himii
                 entity.OnUpdate(ts);
             }
         }
+
+        [UnmanagedCallersOnly]
+        public static unsafe void OnPhysics2DEvents(NativeContactEvent2D* beginEvents, int beginCount,
+                                                    NativeContactEvent2D* endEvents, int endCount,
+                                                    NativeContactHitEvent2D* hitEvents, int hitCount)
+        {
+            // 异常不能穿过 UnmanagedCallersOnly 边界
+            try
+            {
+                for (int i = 0; i < beginCount; i++)
+                {
+                    NotifyContact(beginEvents[i].EntityA, beginEvents[i].EntityB, beginEvents[i].IsSensor != 0, true);
+                    NotifyContact(beginEvents[i].EntityB, beginEvents[i].EntityA, beginEvents[i].IsSensor != 0, true);
+                }
+
+                for (int i = 0; i < endCount; i++)
+                {
+                    NotifyContact(endEvents[i].EntityA, endEvents[i].EntityB, endEvents[i].IsSensor != 0, false);
+                    NotifyContact(endEvents[i].EntityB, endEvents[i].EntityA, endEvents[i].IsSensor != 0, false);
+                }
+
+                for (int i = 0; i < hitCount; i++)
+                {
+                    NativeContactHitEvent2D e = hitEvents[i];
+                    NotifyHit(e.EntityA, e.EntityB, e.Point, e.Normal, e.ApproachSpeed);
+                    // 对 B 而言法线方向相反
+                    NotifyHit(e.EntityB, e.EntityA, e.Point, e.Normal * -1.0f, e.ApproachSpeed);
+                }
+            }
+            catch (Exception e)
+            {
+                Console.WriteLine($"[C#] Error dispatching physics events: {e.Message}");
+                Console.WriteLine(e.StackTrace);
+            }
+        }
+
+        private static Entity GetEntity(ulong entityID)
+        {
+            return _instances.TryGetValue(entityID, out var entity) ? entity : new Entity(entityID);
+        }
+
+        private static void NotifyContact(ulong selfID, ulong otherID, bool isSensor, bool begin)
+        {
+            _instances.TryGetValue(selfID, out var self);
+            var subscription = Physics2D.GetSubscription(selfID);
+            if (self == null && subscription == null)
+                return;
+
+            var collision = new Collision2D(GetEntity(otherID), isSensor);
+            if (begin)
+            {
+                self?.OnCollisionBegin(collision);
+                subscription?.Begin?.Invoke(collision);
+            }
+            else
+            {
+                self?.OnCollisionEnd(collision);
+                subscription?.End?.Invoke(collision);
+            }
+        }
+
+        private static void NotifyHit(ulong selfID, ulong otherID, Vector2 point, Vector2 normal, float approachSpeed)
+        {
+            _instances.TryGetValue(selfID, out var self);
+            var subscription = Physics2D.GetSubscription(selfID);
+            if (self == null && subscription == null)
+                return;
+
+            var hit = new CollisionHit2D(GetEntity(otherID), point, normal, approachSpeed);
+            self?.OnCollisionHit(hit);
+            subscription?.Hit?.Invoke(hit);
+        }
     }
 }
\ No newline at end of file